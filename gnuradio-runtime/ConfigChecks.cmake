@@ -121,6 +121,14 @@ CHECK_CXX_SOURCE_COMPILES("
 GR_ADD_COND_DEF(HAVE_SHM_OPEN)
 SET(CMAKE_REQUIRED_LIBRARIES)
 
+########################################################################
+CHECK_CXX_SOURCE_COMPILES("
+    #include <sys/mman.h>
+    int main(){memfd_create(0, MFD_CLOEXEC); return 0;}
+    " HAVE_MEMFD_CREATE
+)
+GR_ADD_COND_DEF(HAVE_MEMFD_CREATE)
+
 ########################################################################
 CHECK_CXX_SOURCE_COMPILES("
     #define _GNU_SOURCE
@@ -15,6 +15,7 @@
 #include <gnuradio/io_signature.h>
 #include <gnuradio/logger.h>
 #include <gnuradio/msg_accepter.h>
+#include <gnuradio/msg_port_queue.h>
 #include <gnuradio/runtime_types.h>
 #include <gnuradio/sptr_magic.h>
 #include <gnuradio/thread/thread.h>
@@ -22,7 +23,10 @@
 #include <deque>
 #include <functional>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <gnuradio/rpcregisterhelpers.h>
 
@@ -43,24 +47,36 @@ class GR_RUNTIME_API basic_block : public msg_accepter,
                                    public std::enable_shared_from_this<basic_block>
 {
     typedef std::function<void(pmt::pmt_t)> msg_handler_t;
+    typedef std::function<void(std::vector<pmt::pmt_t>&)> msg_batch_handler_t;
 
 private:
     typedef std::map<pmt::pmt_t, msg_handler_t, pmt::comparator> d_msg_handlers_t;
     d_msg_handlers_t d_msg_handlers;
 
+    typedef std::map<pmt::pmt_t, msg_batch_handler_t, pmt::comparator>
+        d_msg_batch_handlers_t;
+    d_msg_batch_handlers_t d_msg_batch_handlers;
+
     typedef std::deque<pmt::pmt_t> msg_queue_t;
-    typedef std::map<pmt::pmt_t, msg_queue_t, pmt::comparator> msg_queue_map_t;
-    typedef std::map<pmt::pmt_t, msg_queue_t, pmt::comparator>::iterator
-        msg_queue_map_itr;
-    std::map<pmt::pmt_t, std::shared_ptr<boost::condition_variable>, pmt::comparator>
-        msg_queue_ready;
 
-    gr::thread::mutex mutex; //< protects all vars
+    // Ports are only added while the block is being built, so the map
+    // itself needs no lock; the queues look after themselves.
+    typedef std::map<pmt::pmt_t, std::unique_ptr<msg_port_queue>, pmt::comparator>
+        msg_queue_map_t;
+
+    // Ports whose queue was set up with set_msg_queue_policy(), which
+    // setting a handler then leaves alone.
+    std::set<pmt::pmt_t, pmt::comparator> d_msg_queue_policy_set;
+
+    msg_port_queue* insert_queue(const pmt::pmt_t& which_port);
+    void msg_port_handled(const pmt::pmt_t& which_port);
+    void push_msg(msg_port_queue* q, const pmt::pmt_t& which_port, const pmt::pmt_t& msg);
 
 protected:
     friend class flowgraph;
     friend class flat_flowgraph; // TODO: will be redundant
     friend class tpb_thread_body;
+    friend class block_executor;
 
     enum vcolor { WHITE, GREY, BLACK };
 
@@ -109,7 +125,17 @@ protected:
      */
     virtual bool has_msg_handler(pmt::pmt_t which_port)
     {
-        return (d_msg_handlers.find(which_port) != d_msg_handlers.end());
+        return (d_msg_handlers.find(which_port) != d_msg_handlers.end() ||
+                has_msg_batch_handler(which_port));
+    }
+
+    /*!
+     * \brief Tests if the handler attached to port \p which_port
+     * takes messages in batches
+     */
+    bool has_msg_batch_handler(pmt::pmt_t which_port)
+    {
+        return (d_msg_batch_handlers.find(which_port) != d_msg_batch_handlers.end());
     }
 
     /*
@@ -122,13 +148,57 @@ protected:
     {
         // AA Update this
         if (has_msg_handler(which_port)) {   // Is there a handler?
-            d_msg_handlers[which_port](msg); // Yes, invoke it.
+            d_msg_handlers_t::iterator i = d_msg_handlers.find(which_port);
+            if (i != d_msg_handlers.end()) {
+                i->second(msg); // Yes, invoke it.
+            } else {
+                std::vector<pmt::pmt_t> msgs(1, msg);
+                d_msg_batch_handlers[which_port](msgs);
+            }
         }
     }
 
+    /*
+     * Like dispatch_msg, for ports whose handler takes batches.
+     */
+    void dispatch_msg_batch(pmt::pmt_t which_port, std::vector<pmt::pmt_t>& msgs)
+    {
+        d_msg_batch_handlers_t::iterator i = d_msg_batch_handlers.find(which_port);
+        if (i != d_msg_batch_handlers.end())
+            i->second(msgs);
+    }
+
     // Message passing interface
     pmt::pmt_t d_message_subscribers;
 
+    // The same subscribers, resolved when they subscribe so that
+    // message_port_pub() needn't look them up in the block registry.
+    //
+    // Subscribing and unsubscribing can happen while the flowgraph
+    // runs, so each port's list is never changed once published:
+    // message_port_sub() and message_port_unsub() build a new one and
+    // swap it in with std::atomic_store(), under
+    // d_msg_subscriber_mutex, and message_port_pub() takes whichever
+    // list is current with std::atomic_load().
+    struct msg_subscriber {
+        std::weak_ptr<basic_block> block;
+        pmt::pmt_t block_name;
+        pmt::pmt_t port;
+    };
+    typedef std::shared_ptr<const std::vector<msg_subscriber>> msg_subscriber_list_t;
+    typedef std::map<pmt::pmt_t, msg_subscriber_list_t, pmt::comparator>
+        msg_subscriber_map_t;
+    msg_subscriber_map_t d_msg_subscriber_blocks;
+    gr::thread::mutex d_msg_subscriber_mutex;
+
+    /*!
+     * \brief Wake up whatever runs this block, after a message was
+     * queued for it.
+     *
+     * Without a scheduler to ask, this goes through the block registry.
+     */
+    virtual void notify_msg();
+
 public:
     pmt::pmt_t message_subscribers(pmt::pmt_t port);
     ~basic_block() override;
@@ -179,6 +249,8 @@ public:
     void message_port_register_in(pmt::pmt_t port_id);
     void message_port_register_out(pmt::pmt_t port_id);
     void message_port_pub(pmt::pmt_t port_id, pmt::pmt_t msg);
+    //! Publish \p msgs in order, waking each subscriber once.
+    void message_port_pub(pmt::pmt_t port_id, const std::vector<pmt::pmt_t>& msgs);
     void message_port_sub(pmt::pmt_t port_id, pmt::pmt_t target);
     void message_port_unsub(pmt::pmt_t port_id, pmt::pmt_t target);
 
@@ -218,19 +290,15 @@ public:
      * Accept msg, place in queue, arrange for thread to be awakened if it's not already.
      */
     void _post(pmt::pmt_t which_port, pmt::pmt_t msg);
+    void _post(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs);
 
     //! is the queue empty?
-    bool empty_p(pmt::pmt_t which_port)
-    {
-        if (msg_queue.find(which_port) == msg_queue.end())
-            throw std::runtime_error("port does not exist!");
-        return msg_queue[which_port].empty();
-    }
+    bool empty_p(pmt::pmt_t which_port) { return port_queue(which_port)->empty(); }
     bool empty_p()
     {
         bool rv = true;
         for (const auto& i : msg_queue) {
-            rv &= msg_queue[i.first].empty();
+            rv &= i.second->empty();
         }
         return rv;
     }
@@ -250,28 +318,63 @@ public:
     }
 
     //! How many messages in the queue?
-    size_t nmsgs(pmt::pmt_t which_port)
-    {
-        if (msg_queue.find(which_port) == msg_queue.end())
-            throw std::runtime_error("port does not exist!");
-        return msg_queue[which_port].size();
-    }
+    size_t nmsgs(pmt::pmt_t which_port) { return port_queue(which_port)->size(); }
 
-    //| Acquires and release the mutex
+    //! Queue \p msg, or deal with it as the port's overflow policy says if full.
     void insert_tail(pmt::pmt_t which_port, pmt::pmt_t msg);
+    //! Queue each of \p msgs, then wake the thread once.
+    void insert_tail(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs);
     /*!
      * \returns returns pmt at head of queue or pmt::pmt_t() if empty.
      */
     pmt::pmt_t delete_head_nowait(pmt::pmt_t which_port);
 
+    /*!
+     * \brief Bound the queue of input message port \p which_port.
+     *
+     * Port queues hold [DEFAULT] max_messages messages. Without a
+     * handler a port drops its oldest message to make room for a new
+     * one; setting a handler switches it to [DEFAULT] msg_overflow,
+     * unless this was called for the port. Messages already queued
+     * are kept, so this may also be called while the flowgraph runs.
+     *
+     * \param which_port an input message port of this block
+     * \param capacity how many messages to hold; rounded up to a power of 2
+     * \param policy what to do with messages that don't fit
+     */
+    void set_msg_queue_policy(pmt::pmt_t which_port,
+                              size_t capacity,
+                              msg_port_queue::overflow_policy policy);
+
+    //! The queue behind input message port \p which_port.
+    msg_port_queue* port_queue(pmt::pmt_t which_port)
+    {
+        msg_queue_map_t::const_iterator i = msg_queue.find(which_port);
+        if (i == msg_queue.end())
+            throw std::runtime_error("port does not exist!");
+        return i->second.get();
+    }
+
+    /*!
+     * \brief DEPRECATED. Will be removed in 3.11. Use
+     * delete_head_nowait() or set_msg_batch_handler() instead.
+     *
+     * Returns an iterator to the oldest message on \p which_port. Only
+     * call it from the thread that handles the block's messages.
+     */
     msg_queue_t::iterator get_iterator(pmt::pmt_t which_port)
     {
-        return msg_queue[which_port].begin();
+        return port_queue(which_port)->hold_all().begin();
     }
 
+    /*!
+     * \brief DEPRECATED. Will be removed in 3.11.
+     *
+     * Removes the message \p it, from get_iterator(), from the queue.
+     */
     void erase_msg(pmt::pmt_t which_port, msg_queue_t::iterator it)
     {
-        msg_queue[which_port].erase(it);
+        port_queue(which_port)->erase_held(it);
     }
 
     virtual bool has_msg_port(pmt::pmt_t which_port)
@@ -285,7 +388,19 @@ public:
         return false;
     }
 
-    const msg_queue_map_t& get_msg_map(void) const { return msg_queue; }
+    /*!
+     * \brief DEPRECATED. Will be removed in 3.11.
+     *
+     * Returns a copy of the messages queued on each input port. Only
+     * call it from the thread that handles the block's messages.
+     */
+    std::map<pmt::pmt_t, msg_queue_t, pmt::comparator> get_msg_map(void) const
+    {
+        std::map<pmt::pmt_t, msg_queue_t, pmt::comparator> msgs;
+        for (const auto& i : msg_queue)
+            msgs[i.first] = i.second->hold_all();
+        return msgs;
+    }
 
 #ifdef GR_CTRLPORT
     /*!
@@ -380,7 +495,40 @@ public:
             throw std::runtime_error(
                 "attempt to set_msg_handler() on bad input message port!");
         }
+        d_msg_batch_handlers.erase(which_port);
         d_msg_handlers[which_port] = msg_handler_t(msg_handler);
+        msg_port_handled(which_port);
+    }
+
+    /*!
+     * \brief Set a callback that is handed all the messages waiting
+     * on \p which_port at once.
+     *
+     * \p msg_handler has the signature:
+     * <pre>
+     *    void msg_handler(std::vector<pmt::pmt_t>& msgs);
+     * </pre>
+     *
+     * The messages are in the order they arrived; the handler may move
+     * them out or reorder them, the vector is cleared afterwards. One
+     * call covers every message the port's queue held at the time, so
+     * blocks that see bursts of PDUs can do the per-message work of
+     * dispatch once per burst, and publish results with the
+     * message_port_pub() overload that takes a vector.
+     *
+     * The same thread-safety guarantees as for set_msg_handler apply.
+     * A port has either kind of handler; setting one replaces the other.
+     */
+    template <typename T>
+    void set_msg_batch_handler(pmt::pmt_t which_port, T msg_handler)
+    {
+        if (msg_queue.find(which_port) == msg_queue.end()) {
+            throw std::runtime_error(
+                "attempt to set_msg_batch_handler() on bad input message port!");
+        }
+        d_msg_handlers.erase(which_port);
+        d_msg_batch_handlers[which_port] = msg_batch_handler_t(msg_handler);
+        msg_port_handled(which_port);
     }
 
     virtual void set_processor_affinity(const std::vector<int>& mask) = 0;
@@ -134,6 +134,13 @@ public:
      */
     bool fixed_rate() const { return d_fixed_rate; }
 
+    /*!
+     * \brief Return true if this block can write its output over its input.
+     *
+     * See set_inplace().
+     */
+    bool inplace() const { return d_inplace; }
+
     // ----------------------------------------------------------------
     //		override these to define your behavior
     // ----------------------------------------------------------------
@@ -264,6 +271,30 @@ public:
      */
     void produce(int which_output, int how_many_items);
 
+    /*!
+     * \brief Keep \p nitems items of input stream \p which_input,
+     * from input_items[which_input] + \p start, from being overwritten
+     * for as long as the returned pointer is alive.
+     *
+     * Lets work() hand the items on in a message, e.g. as a
+     * pmt::make_u8vector_view(), without copying them; they may be
+     * consumed as usual. Call it before consume() for the input,
+     * which moves where \p start counts from. Returns an empty
+     * pointer if the buffer can't spare them; copy them instead.
+     * See buffer_reader::hold().
+     */
+    std::shared_ptr<uint8_t> hold_input_items(int which_input, int start, int nitems);
+
+    /*!
+     * \brief As hold_input_items(), for items this call writes to
+     * output_items[which_output] + \p start.
+     *
+     * Call it before produce() for the output. The items must be
+     * among those produced in this call, or the writer will be held
+     * up by items that were never written.
+     */
+    std::shared_ptr<uint8_t> hold_output_items(int which_output, int start, int nitems);
+
     /*!
      * \brief Set the approximate output rate / input rate
      *
@@ -431,9 +462,21 @@ public:
 
     /*!
      * \brief Returns max buffer size on output port \p i.
+     *
+     * Once the flowgraph has started, this is the size of the buffer
+     * that was actually allocated.
      */
     long max_output_buffer(size_t i);
 
+    /*!
+     * \brief Returns the max buffer size asked for on output port \p i
+     * with set_max_output_buffer(), or -1 if there was none.
+     *
+     * Unlike max_output_buffer(), this isn't replaced by the size of
+     * the buffer allocated.
+     */
+    long requested_max_output_buffer(size_t i);
+
     /*!
      * \brief Request limit on max buffer size on all output ports.
      *
@@ -631,6 +674,24 @@ public:
      */
     float pc_throughput_avg();
 
+    /*!
+     * \brief Gets the number of messages each input message port has
+     * received, in the order of message_ports_in().
+     */
+    std::vector<float> pc_msgs_received();
+
+    /*!
+     * \brief Gets the number of messages each input message port has
+     * dropped because its queue was full.
+     */
+    std::vector<float> pc_msgs_dropped();
+
+    /*!
+     * \brief Gets the number of times senders to each input message
+     * port had to wait for room in its queue.
+     */
+    std::vector<float> pc_msgs_blocked();
+
     /*!
      * \brief Resets the performance counters
      */
@@ -739,6 +800,7 @@ private:
     unsigned d_history;
     unsigned d_attr_delay; // the block's sample delay
     bool d_fixed_rate;
+    bool d_inplace;
     bool d_max_noutput_items_set; // if d_max_noutput_items is valid
     int d_max_noutput_items;      // value of max_noutput_items for this block
     int d_min_noutput_items;
@@ -758,6 +820,20 @@ protected:
 
     void set_fixed_rate(bool fixed_rate) { d_fixed_rate = fixed_rate; }
 
+    /*!
+     * \brief Declare that this block can write its output over its input.
+     *
+     * Only used for 1:1 sync blocks with one input and one output of
+     * the same item size and a history of 1. When such a block is the
+     * only reader of the buffer upstream of it, and the [Scheduler]
+     * inplace_buffers preference is on (it is off by default), the
+     * runtime makes its output buffer share that buffer's memory, and
+     * work() gets output_items[0] == input_items[0]. Only declare this
+     * if work() gives the right answer then; element-wise loops and
+     * most VOLK kernels do.
+     */
+    void set_inplace(bool inplace) { d_inplace = inplace; }
+
     /*!
      * \brief  Adds a new tag onto the given output buffer.
      *
@@ -909,7 +985,14 @@ protected:
 
     void enable_update_rate(bool en);
 
+    /*!
+     * \brief Wake up our scheduler thread or task directly, after a
+     * message was queued for us.
+     */
+    void notify_msg() override;
+
     std::vector<long> d_max_output_buffer;
+    std::vector<long> d_requested_max_output_buffer;
     std::vector<long> d_min_output_buffer;
 
     /*! Used by block's setters and work functions to make
@@ -934,6 +1017,12 @@ public:
     block_detail_sptr detail() const { return d_detail; }
     void set_detail(block_detail_sptr detail) { d_detail = detail; }
 
+    /*! \brief Record that the buffer on output \p port holds \p nitems,
+     * for max_output_buffer() to report. Leaves what the user asked for
+     * with set_max_output_buffer() alone.
+     */
+    void set_allocated_output_buffer(int port, long nitems);
+
     /*! \brief Tell msg neighbors we are finished
      */
     void notify_msg_neighbors();
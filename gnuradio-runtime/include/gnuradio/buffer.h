@@ -17,7 +17,10 @@
 #include <gnuradio/tags.h>
 #include <gnuradio/thread/thread.h>
 #include <boost/weak_ptr.hpp>
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <list>
 #include <memory>
 
 namespace gr {
@@ -39,6 +42,33 @@ GR_RUNTIME_API buffer_sptr make_buffer(int nitems,
                                        size_t sizeof_item,
                                        block_sptr link = block_sptr());
 
+/*!
+ * \brief Make a buffer that shares the memory of \p upstream.
+ *
+ * For a block that writes its output over its input (see
+ * gr::block::set_inplace): the new buffer's write index starts where
+ * \p upstream's is, so each item \p link reads from \p upstream is
+ * written back to the same place. \p link must be the only reader of
+ * \p upstream. The writer of \p upstream then also waits for the
+ * readers of the new buffer before reusing space.
+ *
+ * \param upstream is the buffer \p link reads from.
+ * \param link is the block that writes to the new buffer.
+ */
+GR_RUNTIME_API buffer_sptr make_buffer_inplace(buffer_sptr upstream, block_sptr link);
+
+/*!
+ * \brief Keep items the writer of \p buf just wrote from being
+ * overwritten for as long as the returned pointer is alive.
+ *
+ * The items are the \p nitems from \p start items past the write
+ * pointer, i.e. past where output_items pointed during this call to
+ * work, and must be among those the call produces. See
+ * buffer_reader::hold().
+ */
+GR_RUNTIME_API std::shared_ptr<uint8_t>
+buffer_hold_output(buffer_sptr buf, int start, int nitems);
+
 /*!
  * \brief Single writer, multiple reader fifo.
  * \ingroup internal
@@ -80,7 +110,7 @@ public:
     void update_write_pointer(int nitems);
 
     void set_done(bool done);
-    bool done() const { return d_done; }
+    bool done() const { return d_done.load(std::memory_order_acquire); }
 
     /*!
      * \brief Return the block that writes to this buffer.
@@ -92,12 +122,21 @@ public:
 
     gr::thread::mutex* mutex() { return &d_mutex; }
 
-    uint64_t nitems_written() { return d_abs_write_offset; }
+    uint64_t nitems_written()
+    {
+        return d_abs_write_offset.load(std::memory_order_acquire);
+    }
 
-    void reset_nitem_counter() { d_abs_write_offset = 0; }
+    void reset_nitem_counter() { d_abs_write_offset.store(0, std::memory_order_release); }
 
     size_t get_sizeof_item() { return d_sizeof_item; }
 
+    /*!
+     * \brief Return the buffer whose memory this one shares, if it was
+     * made by make_buffer_inplace().
+     */
+    buffer_sptr inplace_of() const { return d_inplace_of; }
+
     /*!
      * \brief  Adds a new tag to the buffer.
      *
@@ -126,18 +165,25 @@ public:
      */
     void prune_tags(uint64_t max_time);
 
-    std::multimap<uint64_t, tag_t>::iterator get_tags_begin()
-    {
-        return d_item_tags.begin();
-    }
-    std::multimap<uint64_t, tag_t>::iterator get_tags_end() { return d_item_tags.end(); }
-    std::multimap<uint64_t, tag_t>::iterator get_tags_lower_bound(uint64_t x)
+    /*!
+     * Tags are kept in a deque sorted by offset; tags with the same
+     * offset stay in the order they were added.
+     */
+    typedef std::deque<tag_t> tag_store_t;
+
+    tag_store_t::iterator get_tags_begin() { return d_item_tags.begin(); }
+    tag_store_t::iterator get_tags_end() { return d_item_tags.end(); }
+    tag_store_t::iterator get_tags_lower_bound(uint64_t x)
     {
-        return d_item_tags.lower_bound(x);
+        return std::partition_point(d_item_tags.begin(),
+                                    d_item_tags.end(),
+                                    [x](const tag_t& t) { return t.offset < x; });
     }
-    std::multimap<uint64_t, tag_t>::iterator get_tags_upper_bound(uint64_t x)
+    tag_store_t::iterator get_tags_upper_bound(uint64_t x)
     {
-        return d_item_tags.upper_bound(x);
+        return std::partition_point(d_item_tags.begin(),
+                                    d_item_tags.end(),
+                                    [x](const tag_t& t) { return t.offset <= x; });
     }
 
     // -------------------------------------------------------------------------
@@ -147,10 +193,14 @@ private:
     friend GR_RUNTIME_API buffer_sptr make_buffer(int nitems,
                                                   size_t sizeof_item,
                                                   block_sptr link);
+    friend GR_RUNTIME_API buffer_sptr make_buffer_inplace(buffer_sptr upstream,
+                                                          block_sptr link);
     friend GR_RUNTIME_API buffer_reader_sptr buffer_add_reader(buffer_sptr buf,
                                                                int nzero_preload,
                                                                block_sptr link,
                                                                int delay);
+    friend GR_RUNTIME_API std::shared_ptr<uint8_t>
+    buffer_hold_output(buffer_sptr buf, int start, int nitems);
 
 protected:
     char* d_base;           // base address of buffer inside d_vmcircbuf.
@@ -165,17 +215,39 @@ private:
     std::vector<buffer_reader*> d_readers;
     std::weak_ptr<block> d_link; // block that writes to this buffer
 
+    // An in-place buffer keeps the one it shares memory with alive;
+    // that one points back at it, like buffer_reader and d_readers.
+    buffer_sptr d_inplace_of;
+    buffer* d_inplace;
+
     //
-    // The mutex protects d_write_index, d_abs_write_offset, d_done, d_item_tags
-    // and the d_read_index's and d_abs_read_offset's in the buffer readers.
+    // d_write_index and d_abs_write_offset are only written by the block
+    // that writes to this buffer, and the d_read_index's and
+    // d_abs_read_offset's only by the block owning that reader. They are
+    // published with release stores and read with acquire loads, so
+    // everything written before an index moved (items and tags) is
+    // visible to whoever sees the new index, without taking the mutex.
+    //
+    // The mutex protects d_item_tags. d_last_min_items_read is only
+    // touched from space_available(), which only the writer calls, so
+    // like d_write_index it needs no lock.
     //
     gr::thread::mutex d_mutex;
-    unsigned int d_write_index;  // in items [0,d_bufsize)
-    uint64_t d_abs_write_offset; // num items written since the start
-    bool d_done;
-    std::multimap<uint64_t, tag_t> d_item_tags;
+    std::atomic<unsigned int> d_write_index; // in items [0,d_bufsize)
+    std::atomic<uint64_t> d_abs_write_offset; // num items written since the start
+    std::atomic<bool> d_done;
+    tag_store_t d_item_tags;
     uint64_t d_last_min_items_read;
 
+    // Items pmts point at (see hold()): the index of the first item of
+    // each hold. d_nholds lets space_available() skip the lock when
+    // there are none. A lock of their own, since holds may be released
+    // by tags being pruned.
+    typedef std::list<unsigned> hold_list_t;
+    gr::thread::mutex d_hold_mutex;
+    hold_list_t d_holds;
+    std::atomic<int> d_nholds;
+
     unsigned index_add(unsigned a, unsigned b)
     {
         unsigned s = a + b;
@@ -200,6 +272,13 @@ private:
 
     virtual bool allocate_buffer(int nitems, size_t sizeof_item);
 
+    //! Items from the oldest hold up to \p write_index, or 0.
+    int held_items(unsigned write_index);
+
+    static std::shared_ptr<uint8_t>
+    hold(const buffer_sptr& buf, unsigned index, int nitems);
+    void release(hold_list_t::iterator h);
+
     /*!
      * \brief constructor is private.  Use gr_make_buffer to create instances.
      *
@@ -215,6 +294,11 @@ private:
      */
     buffer(int nitems, size_t sizeof_item, block_sptr link);
 
+    /*!
+     * \brief constructor is private. Use make_buffer_inplace to create instances.
+     */
+    buffer(buffer_sptr upstream, block_sptr link);
+
     /*!
      * \brief disassociate \p reader from this buffer
      */
@@ -292,14 +376,30 @@ public:
      */
     void update_read_pointer(int nitems);
 
+    /*!
+     * \brief Keep the \p nitems items \p start items past the read
+     * pointer from being overwritten for as long as the returned
+     * pointer, or any copy of it, is alive.
+     *
+     * The pointer points at the first of the items, so they can be
+     * handed on, e.g. as a pmt::make_u8vector_view, without copying
+     * them. Consuming them is fine; the writer just can't reuse the
+     * space until the last reference is dropped, so whoever ends up
+     * with it should let go promptly.
+     *
+     * Returns an empty pointer, and holds nothing, if the items held
+     * would then span more than half the buffer. Copy them instead.
+     */
+    std::shared_ptr<uint8_t> hold(int start, int nitems);
+
     void set_done(bool done) { d_buffer->set_done(done); }
     bool done() const { return d_buffer->done(); }
 
     gr::thread::mutex* mutex() { return d_buffer->mutex(); }
 
-    uint64_t nitems_read() { return d_abs_read_offset; }
+    uint64_t nitems_read() { return d_abs_read_offset.load(std::memory_order_acquire); }
 
-    void reset_nitem_counter() { d_abs_read_offset = 0; }
+    void reset_nitem_counter() { d_abs_read_offset.store(0, std::memory_order_release); }
 
     size_t get_sizeof_item() { return d_buffer->get_sizeof_item(); }
 
@@ -328,6 +428,45 @@ public:
                            uint64_t abs_end,
                            long id);
 
+    /*!
+     * \brief Visit the tags in [start,end) without copying them.
+     *
+     * Picks the same tags as get_tags_in_range(), but calls
+     * \p f(tag, offset) for each one in place. \p offset is where this
+     * reader sees the tag, i.e. tag.offset plus the sample delay, and
+     * tag.marked_deleted is whatever the buffer has recorded.
+     *
+     * The buffer's mutex is held while \p f runs, so it must not call
+     * back into this buffer's tags. Adding tags to other buffers is
+     * fine.
+     */
+    template <typename F>
+    void visit_tags_in_range(uint64_t abs_start, uint64_t abs_end, long id, F f)
+    {
+        gr::thread::scoped_lock guard(*mutex());
+
+        uint64_t lower_bound = abs_start - d_attr_delay;
+        // check for underflow and if so saturate at 0
+        if (lower_bound > abs_start)
+            lower_bound = 0;
+
+        buffer::tag_store_t::iterator itr = d_buffer->get_tags_lower_bound(lower_bound);
+        buffer::tag_store_t::iterator itr_end = d_buffer->get_tags_end();
+
+        for (; itr != itr_end; ++itr) {
+            uint64_t item_time = itr->offset + d_attr_delay;
+            if (item_time >= abs_end)
+                break;
+            if (item_time < abs_start)
+                continue;
+            // skip tags this block has removed
+            if (std::find(itr->marked_deleted.begin(), itr->marked_deleted.end(), id) !=
+                itr->marked_deleted.end())
+                continue;
+            f(static_cast<const tag_t&>(*itr), item_time);
+        }
+    }
+
     // -------------------------------------------------------------------------
 
 private:
@@ -338,8 +477,8 @@ private:
                                                                int delay);
 
     buffer_sptr d_buffer;
-    unsigned int d_read_index;   // in items [0,d->buffer.d_bufsize)
-    uint64_t d_abs_read_offset;  // num items seen since the start
+    std::atomic<unsigned int> d_read_index; // in items [0,d->buffer.d_bufsize)
+    std::atomic<uint64_t> d_abs_read_offset; // num items seen since the start
     std::weak_ptr<block> d_link; // block that reads via this buffer reader
     unsigned d_attr_delay;       // sample delay attribute for tag propagation
 
@@ -14,6 +14,7 @@
 #include <gnuradio/api.h>
 #include <gnuradio/messages/msg_accepter.h>
 #include <pmt/pmt.h>
+#include <vector>
 
 namespace gr {
 
@@ -28,6 +29,9 @@ public:
     ~msg_accepter() override;
 
     void post(pmt::pmt_t which_port, pmt::pmt_t msg) override;
+
+    //! Post each of \p msgs, in order, notifying the block once.
+    void post(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs);
 };
 
 } /* namespace gr */
@@ -0,0 +1,163 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_GR_RUNTIME_MSG_PORT_QUEUE_H
+#define INCLUDED_GR_RUNTIME_MSG_PORT_QUEUE_H
+
+#include <gnuradio/api.h>
+#include <gnuradio/thread/thread.h>
+#include <pmt/pmt.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gr {
+
+/*!
+ * \brief Queue of the messages waiting on one input message port.
+ * \ingroup internal
+ *
+ * Messages go through a ring of the capacity given at construction,
+ * which any number of threads may push to and pop from at once
+ * without taking a lock; each slot carries a sequence number telling
+ * producers and consumers whose turn it is. Messages that don't fit
+ * in the ring wait in a list behind it, under a lock, in order.
+ *
+ * The capacity also bounds how many messages the queue holds. What
+ * happens to a message pushed onto a full queue depends on the
+ * overflow policy:
+ *
+ * - BLOCK: the producer waits until there's room. Meant for
+ *   producers with their own thread, like socket_pdu; a block that
+ *   publishes from work() holds up its scheduler thread meanwhile.
+ * - DROP_OLDEST: the message at the head is dropped to make room.
+ * - DROP_NEWEST: the new message is dropped.
+ * - GROW: the queue holds it anyway; it has no bound.
+ *
+ * The bound is checked before pushing, so producers pushing at the
+ * same moment may take the queue a message or so over it.
+ *
+ * Counters of what happened are kept for the performance counters.
+ */
+class GR_RUNTIME_API msg_port_queue
+{
+public:
+    enum overflow_policy { BLOCK, DROP_OLDEST, DROP_NEWEST, GROW };
+
+    /*!
+     * \param capacity is rounded up to a power of 2.
+     * \param policy says what to do with messages that don't fit.
+     */
+    msg_port_queue(size_t capacity, overflow_policy policy);
+    ~msg_port_queue();
+
+    /*!
+     * \brief Append \p msg. Returns false if a message was dropped.
+     */
+    bool push(const pmt::pmt_t& msg);
+
+    /*!
+     * \brief Remove and return the head, or pmt::pmt_t() if empty.
+     */
+    pmt::pmt_t pop();
+
+    /*!
+     * \brief Move up to \p max messages from the head onto the end of
+     * \p msgs, claiming them all at once. Returns how many were moved.
+     */
+    size_t pop(std::vector<pmt::pmt_t>& msgs, size_t max);
+
+    //! How many messages are queued; only a snapshot if others are busy.
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return d_capacity.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Change the bound on the number of messages held, rounded
+     * up to a power of 2. Messages already queued stay queued.
+     */
+    void set_capacity(size_t capacity);
+
+    overflow_policy policy() const { return d_policy.load(std::memory_order_relaxed); }
+    void set_policy(overflow_policy policy);
+
+    //! Number of messages pushed, including any dropped on the way in.
+    uint64_t npushed() const { return d_npushed.load(std::memory_order_relaxed); }
+    //! Number of messages dropped, by either DROP_ policy.
+    uint64_t ndropped() const { return d_ndropped.load(std::memory_order_relaxed); }
+    //! Number of times a producer had to wait for room.
+    uint64_t nblocked() const { return d_nblocked.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Parse "block", "drop_oldest", "drop_newest" or "grow".
+     */
+    static overflow_policy policy_from_string(const std::string& name);
+
+    /*!
+     * \brief DEPRECATED. Will be removed in 3.11.
+     *
+     * Moves every queued message into a deque, which pops then take
+     * from before anything pushed since, and returns it. Only there
+     * for basic_block's iterator interface of old; only the thread
+     * that pops may use the deque, and only erase_held() may shorten
+     * it.
+     */
+    std::deque<pmt::pmt_t>& hold_all();
+
+    //! DEPRECATED. Will be removed in 3.11. See hold_all().
+    void erase_held(std::deque<pmt::pmt_t>::iterator it);
+
+private:
+    struct cell {
+        std::atomic<size_t> seq;
+        pmt::pmt_t msg;
+    };
+
+    const size_t d_mask;
+    std::unique_ptr<cell[]> d_cells;
+    alignas(64) std::atomic<size_t> d_tail; // next push
+    alignas(64) std::atomic<size_t> d_head; // next pop
+    alignas(64) std::atomic<overflow_policy> d_policy;
+    std::atomic<size_t> d_capacity;
+    std::atomic<uint64_t> d_npushed;
+    std::atomic<uint64_t> d_ndropped;
+    std::atomic<uint64_t> d_nblocked;
+
+    // Messages behind the ring. While there are any, new ones go
+    // after them rather than into the ring, so that each producer's
+    // messages stay in order.
+    gr::thread::mutex d_overflow_mutex;
+    std::deque<pmt::pmt_t> d_overflow;
+    std::atomic<size_t> d_noverflow;
+
+    // Messages in front of the ring, put there by hold_all(); also
+    // under d_overflow_mutex.
+    std::deque<pmt::pmt_t> d_held;
+    std::atomic<size_t> d_nheld;
+
+    // Only for producers waiting under BLOCK.
+    std::atomic<int> d_nwaiting;
+    gr::thread::mutex d_mutex;
+    gr::thread::condition_variable d_not_full;
+
+    bool full() const { return size() >= capacity(); }
+    bool try_push(const pmt::pmt_t& msg);
+    void push_any(const pmt::pmt_t& msg);
+    pmt::pmt_t pop_held();
+    pmt::pmt_t pop_ring();
+    size_t pop_ring(std::vector<pmt::pmt_t>& msgs, size_t max);
+    void wake_producers();
+};
+
+} /* namespace gr */
+
+#endif /* INCLUDED_GR_RUNTIME_MSG_PORT_QUEUE_H */
@@ -71,6 +71,11 @@ struct GR_RUNTIME_API tag_t {
         return (*this);
     }
 
+    // Moving keeps marked_deleted, so tags can be shuffled around
+    // inside a buffer without forgetting who deleted them.
+    tag_t(tag_t&& rhs) = default;
+    tag_t& operator=(tag_t&& rhs) = default;
+
     ~tag_t() {}
 };
 
@@ -14,7 +14,9 @@
 #include <gnuradio/api.h>
 #include <gnuradio/thread/thread.h>
 #include <pmt/pmt.h>
+#include <atomic>
 #include <deque>
+#include <functional>
 
 namespace gr {
 
@@ -22,16 +24,32 @@ class block_detail;
 
 /*!
  * \brief used by thread-per-block scheduler
+ *
+ * A block that is about to wait on one of the condition variables
+ * sets the matching *_waiting flag, with the mutex held, and then
+ * checks *_changed once more. Notifiers set *_changed first and only
+ * take the mutex and signal when they see the waiting flag. Both
+ * sides use sequentially consistent atomics, so one of them always
+ * sees the other's store and no wakeup is lost.
  */
 struct GR_RUNTIME_API tpb_detail {
-    gr::thread::mutex mutex; //< protects all vars
-    bool input_changed;
+    gr::thread::mutex mutex; //< protects the condition variables and msg_notify
+    std::atomic<bool> input_changed;
+    std::atomic<bool> input_waiting;
     gr::thread::condition_variable input_cond;
-    bool output_changed;
+    std::atomic<bool> output_changed;
+    std::atomic<bool> output_waiting;
     gr::thread::condition_variable output_cond;
 
 public:
-    tpb_detail() : input_changed(false), output_changed(false) {}
+    tpb_detail()
+        : input_changed(false),
+          input_waiting(false),
+          output_changed(false),
+          output_waiting(false),
+          output_relay(nullptr)
+    {
+    }
 
     //! Called by us to tell all our upstream blocks that their output
     //! may have changed.
@@ -52,31 +70,64 @@ public:
         input_cond.notify_one();
         output_changed = true;
         output_cond.notify_one();
+        if (msg_notify)
+            msg_notify();
     }
 
+    //! Called by schedulers that don't wait on our condition
+    //! variables to be told about new messages. Pass an empty
+    //! function to remove it again.
+    void set_msg_notify(std::function<void()> f)
+    {
+        gr::thread::scoped_lock guard(mutex);
+        msg_notify = f;
+    }
+
+    //! Called by schedulers that run us in the thread of the block
+    //! owning \p t: whenever our output may have changed, tell \p t
+    //! that its input may have changed instead. Pass 0 to remove it
+    //! again.
+    void set_output_relay(tpb_detail* t) { output_relay = t; }
+
     //! Called by us
     void clear_changed()
     {
-        gr::thread::scoped_lock guard(mutex);
         input_changed = false;
         output_changed = false;
     }
 
 private:
+    std::function<void()> msg_notify;
+    std::atomic<tpb_detail*> output_relay;
+
     //! Used by notify_downstream
     void set_input_changed()
     {
-        gr::thread::scoped_lock guard(mutex);
-        input_changed = true;
-        input_cond.notify_one();
+        // If it was already set, whoever set it took care of waking
+        // the block, so notifying the same neighbor twice is free.
+        if (input_changed.exchange(true))
+            return;
+        if (input_waiting) {
+            gr::thread::scoped_lock guard(mutex);
+            input_cond.notify_one();
+        }
     }
 
     //! Used by notify_upstream
     void set_output_changed()
     {
-        gr::thread::scoped_lock guard(mutex);
-        output_changed = true;
-        output_cond.notify_one();
+        tpb_detail* relay = output_relay;
+        if (relay) {
+            relay->set_input_changed();
+            return;
+        }
+
+        if (output_changed.exchange(true))
+            return;
+        if (output_waiting) {
+            gr::thread::scoped_lock guard(mutex);
+            output_cond.notify_one();
+        }
     }
 };
 
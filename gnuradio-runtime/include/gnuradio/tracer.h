@@ -0,0 +1,105 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_GR_RUNTIME_TRACER_H
+#define INCLUDED_GR_RUNTIME_TRACER_H
+
+#include <gnuradio/api.h>
+#include <gnuradio/high_res_timer.h>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gr {
+
+/*!
+ * \brief Record what every block's executor does, for later inspection.
+ * \ingroup misc
+ *
+ * While tracing is enabled, each iteration of a block's executor
+ * records one event: when work() started and ended, how many items
+ * it was asked for and how many it produced, how full its buffers
+ * were afterwards, and whether it was blocked instead. Events go
+ * into a fixed size ring per thread, so recording takes no locks and
+ * the oldest events are overwritten once a ring is full.
+ *
+ * Tracing starts out enabled if [PerfCounters] trace is set, and
+ * each ring holds [PerfCounters] trace_events events. It's only
+ * available if GNU Radio was built with performance counters.
+ *
+ * write_chrome_trace() writes the events as JSON that the Chrome
+ * trace viewer (chrome://tracing) and Perfetto can load.
+ */
+class GR_RUNTIME_API tracer
+{
+public:
+    //! What an executor iteration came to; see block_executor::state
+    enum state { READY, READY_NO_OUTPUT, BLKD_IN, BLKD_OUT, DONE };
+
+    struct event {
+        long block_id;              //!< the block's unique_id()
+        high_res_timer_type start;  //!< when work() was called
+        high_res_timer_type end;    //!< when it returned; start if it wasn't
+        int noutput_items;          //!< items work() was asked for
+        int nproduced;              //!< what work() returned
+        float input_full;           //!< fullest input buffer, 0 to 1
+        float output_full;          //!< fullest output buffer, 0 to 1
+        state result;               //!< the outcome of the iteration
+    };
+
+    /*!
+     * \brief Start or stop recording events.
+     */
+    static void enable(bool on = true);
+
+    /*!
+     * \brief Return true if events are being recorded.
+     */
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Record \p e in the calling thread's ring.
+     */
+    static void record(const event& e);
+
+    /*!
+     * \brief Give the events of block \p block_id a name in the output.
+     */
+    static void name_block(long block_id, const std::string& name);
+
+    /*!
+     * \brief Drop all recorded events.
+     */
+    static void clear();
+
+    /*!
+     * \brief Return the events still in the rings, oldest first for
+     * each thread.
+     */
+    static std::vector<event> events();
+
+    /*!
+     * \brief Write the recorded events in Chrome trace format.
+     */
+    static void write_chrome_trace(std::ostream& os);
+
+    /*!
+     * \brief Write the recorded events in Chrome trace format to \p filename.
+     */
+    static void write_chrome_trace(const std::string& filename);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+} /* namespace gr */
+
+#endif /* INCLUDED_GR_RUNTIME_TRACER_H */
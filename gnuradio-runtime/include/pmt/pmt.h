@@ -165,6 +165,26 @@ PMT_API pmt_t string_to_symbol(const std::string& s);
 //! Alias for pmt_string_to_symbol
 PMT_API pmt_t intern(const std::string& s);
 
+/*!
+ * \brief The symbol named by the string literal \p s, interned once per
+ * call site.
+ *
+ * Expands to a const pmt_t&. The first time a call site runs, \p s is
+ * interned; after that the cached symbol is returned without a hash or
+ * a table lookup. Use it for fixed keys on hot paths:
+ *
+ * \code
+ *   add_item_tag(0, offset, PMT_SYMBOL("rx_time"), time);
+ * \endcode
+ *
+ * \p s must not refer to local variables.
+ */
+#define PMT_SYMBOL(s)                                                          \
+    ([]() -> const ::pmt::pmt_t& {                                             \
+        static const ::pmt::pmt_t s_pmt_symbol = ::pmt::string_to_symbol(s);   \
+        return s_pmt_symbol;                                                   \
+    }())
+
 
 /*!
  * If \p is a symbol, return the name of the symbol as a string.
@@ -534,6 +554,32 @@ PMT_API pmt_t init_c32vector(size_t k, const std::vector<std::complex<float>>& d
 PMT_API pmt_t init_c64vector(size_t k, const std::complex<double>* data);
 PMT_API pmt_t init_c64vector(size_t k, const std::vector<std::complex<double>>& data);
 
+/*!
+ * \brief Make a u8vector of the \p k bytes at \p data without copying them.
+ *
+ * The vector holds a reference to \p data, e.g. a buffer from a
+ * pmt::slab_pool, for as long as it or any slice of it is alive.
+ * Writes through u8vector_writable_elements are seen by everyone
+ * sharing the buffer.
+ */
+PMT_API pmt_t make_u8vector_view(size_t k, const std::shared_ptr<uint8_t>& data);
+
+//! As make_u8vector_view(), for \p k floats.
+PMT_API pmt_t make_f32vector_view(size_t k, const std::shared_ptr<float>& data);
+
+//! As make_u8vector_view(), for \p k complex floats.
+PMT_API pmt_t make_c32vector_view(size_t k,
+                                  const std::shared_ptr<std::complex<float>>& data);
+
+/*!
+ * \brief Return elements [\p start, \p start + \p k) of uniform vector \p v
+ * as a uniform vector of the same type, without copying them.
+ *
+ * The slice shares storage with \p v, so writes to either are seen by
+ * both. Throws out_of_range if the slice doesn't fit in \p v.
+ */
+PMT_API pmt_t uniform_vector_slice(pmt_t v, size_t start, size_t k);
+
 PMT_API uint8_t u8vector_ref(pmt_t v, size_t k);
 PMT_API int8_t s8vector_ref(pmt_t v, size_t k);
 PMT_API uint16_t u16vector_ref(pmt_t v, size_t k);
@@ -967,6 +1013,40 @@ PMT_API bool serialize(pmt_t obj, std::streambuf& sink);
  */
 PMT_API pmt_t deserialize(std::streambuf& source);
 
+/*!
+ * \brief Append the portable byte-serial representation of \p obj to \p buf
+ *
+ * Writes the same bytes as serialize, straight into memory.
+ */
+PMT_API void serialize_append(pmt_t obj, std::string& buf);
+
+/*!
+ * \brief Append \p obj to \p buf as a length-prefixed, versioned frame
+ *
+ * A frame is the PST_FRAME tag, a format version byte and the big-endian
+ * 32 bit length of the body, followed by the body as written by
+ * serialize. Readers can skip or hand off a frame without parsing it.
+ * All the deserialize functions read frames.
+ */
+PMT_API void serialize_frame(pmt_t obj, std::string& buf);
+
+/*!
+ * \brief Create obj from the portable byte-serial representation at the
+ * start of the \p len bytes at \p data
+ *
+ * Sets \p used to the number of bytes read. Returns PMT_EOF if \p len
+ * is 0. Throws on malformed or truncated input.
+ */
+PMT_API pmt_t deserialize_buffer(const void* data, size_t len, size_t& used);
+
+/*!
+ * \brief As deserialize_buffer, but u8vectors in the result refer to
+ * \p data rather than holding a copy of their part of it
+ */
+PMT_API pmt_t deserialize_buffer(const std::shared_ptr<uint8_t>& data,
+                                 size_t len,
+                                 size_t& used);
+
 
 PMT_API void dump_sizeof(); // debugging
 
@@ -11,8 +11,11 @@
 #define INCLUDED_PMT_POOL_H
 
 #include <pmt/api.h>
+#include <pmt/pmt.h>
 #include <boost/thread.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace pmt {
@@ -60,6 +63,51 @@ public:
     void free(void* p);
 };
 
+/*!
+ * \brief pool of fixed-size byte buffers to back u8vectors without copies
+ *
+ * Receive into a buffer from get(), then wrap the bytes received with
+ * pmt::make_u8vector_view. The buffer goes back to the pool when the
+ * last reference to it goes away, which may be after the pool itself.
+ * The pool keeps up to max_idle returned buffers for reuse and frees
+ * the rest, so a burst doesn't hold on to its memory for good.
+ */
+class PMT_API slab_pool
+{
+    struct state;
+    std::shared_ptr<state> d_state;
+    size_t d_slab_size;
+
+public:
+    /*!
+     * \param slab_size size in bytes of each buffer.
+     * \param max_slabs is the maximum number of buffers handed out at
+     * once. If this number is exceeded, get blocks. 0 implies no limit.
+     * \param max_idle is the maximum number of returned buffers kept
+     * for reuse.
+     */
+    slab_pool(size_t slab_size, size_t max_slabs = 0, size_t max_idle = 16);
+
+    size_t slab_size() const { return d_slab_size; }
+
+    //! Return a buffer of slab_size() bytes.
+    std::shared_ptr<uint8_t> get();
+
+    /*!
+     * \brief Make a u8vector of the first \p n bytes of \p buf, a
+     * buffer from get().
+     *
+     * If they fill at least half of it, the u8vector wraps \p buf as
+     * it is, and \p buf is given a new buffer to receive into. Fewer
+     * are copied, so that a short PDU doesn't hold on to a whole
+     * buffer, and \p buf is left to be received into again.
+     */
+    pmt_t make_u8vector(size_t n, std::shared_ptr<uint8_t>& buf);
+
+    //! Number of returned buffers kept for reuse.
+    size_t nidle() const;
+};
+
 } /* namespace pmt */
 
 #endif /* INCLUDED_PMT_POOL_H */
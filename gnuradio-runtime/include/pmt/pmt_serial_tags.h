@@ -25,6 +25,7 @@ enum pst_tags {
     PST_UINT64 = 0x0b,
     PST_TUPLE = 0x0c,
     PST_INT64 = 0x0d,
+    PST_FRAME = 0x0e,
     UVI_ENDIAN_MASK = 0x80,
     UVI_SUBTYPE_MASK = 0x7f,
     UVI_LITTLE_ENDIAN = 0x00,
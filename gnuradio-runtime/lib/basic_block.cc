@@ -15,6 +15,8 @@
 #include <gnuradio/basic_block.h>
 #include <gnuradio/block_registry.h>
 #include <gnuradio/logger.h>
+#include <gnuradio/prefs.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -74,15 +76,40 @@ void basic_block::message_port_register_in(pmt::pmt_t port_id)
     if (!pmt::is_symbol(port_id)) {
         throw std::runtime_error("message_port_register_in: bad port id");
     }
-    msg_queue[port_id] = msg_queue_t();
-    msg_queue_ready[port_id] =
-        std::shared_ptr<boost::condition_variable>(new boost::condition_variable());
+
+    // Nobody reads a port without a handler, so keep only the latest
+    // max_messages messages on it.
+    long capacity = prefs::singleton()->get_long("DEFAULT", "max_messages", 100);
+    msg_queue[port_id] = std::unique_ptr<msg_port_queue>(
+        new msg_port_queue(std::max(capacity, 1L), msg_port_queue::DROP_OLDEST));
+}
+
+void basic_block::msg_port_handled(const pmt::pmt_t& which_port)
+{
+    if (d_msg_queue_policy_set.count(which_port))
+        return;
+    msg_queue[which_port]->set_policy(msg_port_queue::policy_from_string(
+        prefs::singleton()->get_string("DEFAULT", "msg_overflow", "grow")));
+}
+
+void basic_block::set_msg_queue_policy(pmt::pmt_t which_port,
+                                       size_t capacity,
+                                       msg_port_queue::overflow_policy policy)
+{
+    msg_queue_map_t::iterator i = msg_queue.find(which_port);
+    if (i == msg_queue.end())
+        throw std::invalid_argument("set_msg_queue_policy: bad input message port");
+
+    // The queue itself stays, as schedulers and senders hold on to it.
+    i->second->set_capacity(capacity);
+    i->second->set_policy(policy);
+    d_msg_queue_policy_set.insert(which_port);
 }
 
 pmt::pmt_t basic_block::message_ports_in()
 {
     pmt::pmt_t port_names = pmt::make_vector(msg_queue.size(), pmt::PMT_NIL);
-    msg_queue_map_itr itr = msg_queue.begin();
+    msg_queue_map_t::iterator itr = msg_queue.begin();
     for (size_t i = 0; i < msg_queue.size(); i++) {
         pmt::vector_set(port_names, i, (*itr).first);
         itr++;
@@ -100,6 +127,7 @@ void basic_block::message_port_register_out(pmt::pmt_t port_id)
         throw std::runtime_error("message_port_register_out: port already in use");
     }
     d_message_subscribers = pmt::dict_add(d_message_subscribers, port_id, pmt::PMT_NIL);
+    d_msg_subscriber_blocks[port_id] = std::make_shared<std::vector<msg_subscriber>>();
 }
 
 pmt::pmt_t basic_block::message_ports_out()
@@ -116,22 +144,37 @@ pmt::pmt_t basic_block::message_ports_out()
 //  - publish a message on a message port
 void basic_block::message_port_pub(pmt::pmt_t port_id, pmt::pmt_t msg)
 {
-    if (!pmt::dict_has_key(d_message_subscribers, port_id)) {
+    msg_subscriber_map_t::const_iterator port = d_msg_subscriber_blocks.find(port_id);
+    if (port == d_msg_subscriber_blocks.end()) {
         throw std::runtime_error("port does not exist");
     }
 
-    pmt::pmt_t currlist = pmt::dict_ref(d_message_subscribers, port_id, pmt::PMT_NIL);
     // iterate through subscribers on port
-    while (pmt::is_pair(currlist)) {
-        pmt::pmt_t target = pmt::car(currlist);
-
-        pmt::pmt_t block = pmt::car(target);
-        pmt::pmt_t port = pmt::cdr(target);
+    msg_subscriber_list_t subscribers = std::atomic_load(&port->second);
+    for (const msg_subscriber& s : *subscribers) {
+        basic_block_sptr blk = s.block.lock();
+        if (!blk) // it wasn't registered when it subscribed
+            blk = global_block_registry.block_lookup(s.block_name);
+        blk->post(s.port, msg);
+    }
+}
 
-        currlist = pmt::cdr(currlist);
-        basic_block_sptr blk = global_block_registry.block_lookup(block);
-        // blk->post(msg);
-        blk->post(port, msg);
+void basic_block::message_port_pub(pmt::pmt_t port_id,
+                                   const std::vector<pmt::pmt_t>& msgs)
+{
+    msg_subscriber_map_t::const_iterator port = d_msg_subscriber_blocks.find(port_id);
+    if (port == d_msg_subscriber_blocks.end()) {
+        throw std::runtime_error("port does not exist");
+    }
+    if (msgs.empty())
+        return;
+
+    msg_subscriber_list_t subscribers = std::atomic_load(&port->second);
+    for (const msg_subscriber& s : *subscribers) {
+        basic_block_sptr blk = s.block.lock();
+        if (!blk)
+            blk = global_block_registry.block_lookup(s.block_name);
+        blk->post(s.port, msgs);
     }
 }
 
@@ -144,12 +187,29 @@ void basic_block::message_port_sub(pmt::pmt_t port_id, pmt::pmt_t target)
            << "\" on block: " << pmt::write_string(target) << std::endl;
         throw std::runtime_error(ss.str());
     }
+
+    gr::thread::scoped_lock lock(d_msg_subscriber_mutex);
     pmt::pmt_t currlist = pmt::dict_ref(d_message_subscribers, port_id, pmt::PMT_NIL);
 
     // ignore re-adds of the same target
-    if (!pmt::list_has(currlist, target))
+    if (!pmt::list_has(currlist, target)) {
         d_message_subscribers = pmt::dict_add(
             d_message_subscribers, port_id, pmt::list_add(currlist, target));
+
+        msg_subscriber s;
+        s.block_name = pmt::car(target);
+        s.port = pmt::cdr(target);
+        try {
+            s.block = global_block_registry.block_lookup(s.block_name);
+        } catch (std::runtime_error&) {
+            // look it up when publishing, as if it were gone
+        }
+
+        msg_subscriber_list_t& port = d_msg_subscriber_blocks[port_id];
+        auto subscribers = std::make_shared<std::vector<msg_subscriber>>(*port);
+        subscribers->push_back(s);
+        std::atomic_store(&port, msg_subscriber_list_t(std::move(subscribers)));
+    }
 }
 
 void basic_block::message_port_unsub(pmt::pmt_t port_id, pmt::pmt_t target)
@@ -162,9 +222,21 @@ void basic_block::message_port_unsub(pmt::pmt_t port_id, pmt::pmt_t target)
     }
 
     // ignore unsubs of unknown targets
+    gr::thread::scoped_lock lock(d_msg_subscriber_mutex);
     pmt::pmt_t currlist = pmt::dict_ref(d_message_subscribers, port_id, pmt::PMT_NIL);
     d_message_subscribers =
         pmt::dict_add(d_message_subscribers, port_id, pmt::list_rm(currlist, target));
+
+    msg_subscriber_list_t& port = d_msg_subscriber_blocks[port_id];
+    auto subscribers = std::make_shared<std::vector<msg_subscriber>>(*port);
+    for (size_t i = 0; i < subscribers->size(); i++) {
+        if (pmt::equal((*subscribers)[i].block_name, pmt::car(target)) &&
+            pmt::equal((*subscribers)[i].port, pmt::cdr(target))) {
+            subscribers->erase(subscribers->begin() + i);
+            std::atomic_store(&port, msg_subscriber_list_t(std::move(subscribers)));
+            break;
+        }
+    }
 }
 
 void basic_block::_post(pmt::pmt_t which_port, pmt::pmt_t msg)
@@ -172,37 +244,61 @@ void basic_block::_post(pmt::pmt_t which_port, pmt::pmt_t msg)
     insert_tail(which_port, msg);
 }
 
-void basic_block::insert_tail(pmt::pmt_t which_port, pmt::pmt_t msg)
+void basic_block::_post(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs)
 {
-    gr::thread::scoped_lock guard(mutex);
+    insert_tail(which_port, msgs);
+}
 
-    if ((msg_queue.find(which_port) == msg_queue.end()) ||
-        (msg_queue_ready.find(which_port) == msg_queue_ready.end())) {
+msg_port_queue* basic_block::insert_queue(const pmt::pmt_t& which_port)
+{
+    msg_queue_map_t::const_iterator i = msg_queue.find(which_port);
+    if (i == msg_queue.end()) {
         GR_LOG_ERROR(d_logger,
                      std::string("attempted insertion on invalid queue ") +
                          pmt::symbol_to_string(which_port));
         throw std::runtime_error("attempted to insert_tail on invalid queue!");
     }
+    return i->second.get();
+}
+
+void basic_block::push_msg(msg_port_queue* q,
+                           const pmt::pmt_t& which_port,
+                           const pmt::pmt_t& msg)
+{
+    if (!q->push(msg) && q->ndropped() == 1) {
+        // Only the first time; after that the counters tell how bad it is.
+        GR_LOG_WARN(d_logger,
+                    "message queue of port " + pmt::symbol_to_string(which_port) +
+                        " full, dropping messages");
+    }
+}
 
-    msg_queue[which_port].push_back(msg);
-    msg_queue_ready[which_port]->notify_one();
+void basic_block::insert_tail(pmt::pmt_t which_port, pmt::pmt_t msg)
+{
+    push_msg(insert_queue(which_port), which_port, msg);
 
     // wake up thread if BLKD_IN or BLKD_OUT
-    global_block_registry.notify_blk(d_symbol_name);
+    notify_msg();
 }
 
-pmt::pmt_t basic_block::delete_head_nowait(pmt::pmt_t which_port)
+void basic_block::insert_tail(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs)
 {
-    gr::thread::scoped_lock guard(mutex);
-
-    if (empty_p(which_port)) {
-        return pmt::pmt_t();
+    msg_port_queue* q = insert_queue(which_port);
+    for (const pmt::pmt_t& msg : msgs) {
+        // Wake the thread before a push might wait for it to make room.
+        if (q->size() >= q->capacity())
+            notify_msg();
+        push_msg(q, which_port, msg);
     }
 
-    pmt::pmt_t m(msg_queue[which_port].front());
-    msg_queue[which_port].pop_front();
+    notify_msg();
+}
+
+void basic_block::notify_msg() { global_block_registry.notify_blk(d_symbol_name); }
 
-    return m;
+pmt::pmt_t basic_block::delete_head_nowait(pmt::pmt_t which_port)
+{
+    return port_queue(which_port)->pop();
 }
 
 pmt::pmt_t basic_block::message_subscribers(pmt::pmt_t port)
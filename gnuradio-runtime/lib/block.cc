@@ -35,6 +35,7 @@ block::block(const std::string& name,
       d_history(1),
       d_attr_delay(0),
       d_fixed_rate(false),
+      d_inplace(false),
       d_max_noutput_items_set(false),
       d_max_noutput_items(0),
       d_min_noutput_items(0),
@@ -43,6 +44,7 @@ block::block(const std::string& name,
       d_pc_rpc_set(false),
       d_update_rate(false),
       d_max_output_buffer(std::max(output_signature->max_streams(), 1), -1),
+      d_requested_max_output_buffer(std::max(output_signature->max_streams(), 1), -1),
       d_min_output_buffer(std::max(output_signature->max_streams(), 1), -1),
       d_pmt_done(pmt::intern("done")),
       d_system_port(pmt::intern("system"))
@@ -174,6 +176,16 @@ void block::produce(int which_output, int how_many_items)
     d_detail->produce(which_output, how_many_items);
 }
 
+std::shared_ptr<uint8_t> block::hold_input_items(int which_input, int start, int nitems)
+{
+    return d_detail->input(which_input)->hold(start, nitems);
+}
+
+std::shared_ptr<uint8_t> block::hold_output_items(int which_output, int start, int nitems)
+{
+    return buffer_hold_output(d_detail->output(which_output), start, nitems);
+}
+
 int block::fixed_rate_ninput_to_noutput(int ninput)
 {
     throw std::runtime_error("Unimplemented");
@@ -346,6 +358,27 @@ void block::set_max_output_buffer(int port, long max_output_buffer)
         d_max_output_buffer.push_back(max_output_buffer);
     else
         d_max_output_buffer[port] = max_output_buffer;
+
+    if ((size_t)port >= d_requested_max_output_buffer.size())
+        d_requested_max_output_buffer.push_back(max_output_buffer);
+    else
+        d_requested_max_output_buffer[port] = max_output_buffer;
+}
+
+long block::requested_max_output_buffer(size_t i)
+{
+    if (i >= d_requested_max_output_buffer.size())
+        throw std::invalid_argument(
+            "basic_block::requested_max_output_buffer: port out of range.");
+    return d_requested_max_output_buffer[i];
+}
+
+void block::set_allocated_output_buffer(int port, long nitems)
+{
+    if ((size_t)port >= d_max_output_buffer.size())
+        throw std::invalid_argument(
+            "basic_block::set_allocated_output_buffer: port out of range.");
+    d_max_output_buffer[port] = nitems;
 }
 
 long block::min_output_buffer(size_t i)
@@ -584,6 +617,30 @@ float block::pc_throughput_avg()
     }
 }
 
+std::vector<float> block::pc_msgs_received()
+{
+    std::vector<float> n;
+    for (const auto& i : msg_queue)
+        n.push_back(i.second->npushed());
+    return n;
+}
+
+std::vector<float> block::pc_msgs_dropped()
+{
+    std::vector<float> n;
+    for (const auto& i : msg_queue)
+        n.push_back(i.second->ndropped());
+    return n;
+}
+
+std::vector<float> block::pc_msgs_blocked()
+{
+    std::vector<float> n;
+    for (const auto& i : msg_queue)
+        n.push_back(i.second->nblocked());
+    return n;
+}
+
 void block::reset_perf_counters()
 {
     if (d_detail) {
@@ -592,13 +649,19 @@ void block::reset_perf_counters()
 }
 
 
+void block::notify_msg()
+{
+    if (d_detail)
+        d_detail->d_tpb.notify_msg();
+}
+
 void block::system_handler(pmt::pmt_t msg)
 {
     // std::cout << "system_handler " << msg << "\n";
     pmt::pmt_t op = pmt::car(msg);
     if (pmt::eqv(op, d_pmt_done)) {
         d_finished = pmt::to_long(pmt::cdr(msg));
-        global_block_registry.notify_blk(d_symbol_name);
+        notify_msg();
     } else {
         std::cout << "WARNING: bad message op on system port!\n";
         pmt::print(msg);
@@ -863,6 +926,42 @@ void block::setup_pc_rpc()
         "Var. of how full output buffers are",
         RPC_PRIVLVL_MIN,
         DISPTIME | DISPOPTSTRIP));
+
+    d_rpc_vars.emplace_back(new rpcbasic_register_get<block, std::vector<float>>(
+        alias(),
+        "msgs received",
+        &block::pc_msgs_received,
+        pmt::make_f32vector(0, 0),
+        pmt::make_f32vector(0, 1e9),
+        pmt::make_f32vector(0, 0),
+        "",
+        "messages received per input message port",
+        RPC_PRIVLVL_MIN,
+        DISPTIME | DISPOPTSTRIP));
+
+    d_rpc_vars.emplace_back(new rpcbasic_register_get<block, std::vector<float>>(
+        alias(),
+        "msgs dropped",
+        &block::pc_msgs_dropped,
+        pmt::make_f32vector(0, 0),
+        pmt::make_f32vector(0, 1e9),
+        pmt::make_f32vector(0, 0),
+        "",
+        "messages dropped by full input message queues",
+        RPC_PRIVLVL_MIN,
+        DISPTIME | DISPOPTSTRIP));
+
+    d_rpc_vars.emplace_back(new rpcbasic_register_get<block, std::vector<float>>(
+        alias(),
+        "msgs blocked",
+        &block::pc_msgs_blocked,
+        pmt::make_f32vector(0, 0),
+        pmt::make_f32vector(0, 1e9),
+        pmt::make_f32vector(0, 0),
+        "",
+        "times senders waited on full input message queues",
+        RPC_PRIVLVL_MIN,
+        DISPTIME | DISPOPTSTRIP));
 #endif /* defined(GR_CTRLPORT) && defined(GR_PERFORMANCE_COUNTERS) */
 }
 
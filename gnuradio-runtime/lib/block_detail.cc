@@ -198,22 +198,16 @@ void block_detail::get_tags_in_range(std::vector<tag_t>& v,
                                      const pmt::pmt_t& key,
                                      long id)
 {
-    std::vector<tag_t> found_items;
-
     v.resize(0);
 
-    // get from gr_buffer_reader's deque of tags
-    d_input[which_input]->get_tags_in_range(found_items, abs_start, abs_end, id);
-
-    // Filter further by key name
-    pmt::pmt_t itemkey;
-    std::vector<tag_t>::iterator itr;
-    for (itr = found_items.begin(); itr != found_items.end(); itr++) {
-        itemkey = (*itr).key;
-        if (pmt::eqv(key, itemkey)) {
-            v.push_back(*itr);
-        }
-    }
+    // Filter by key name in place, so only the matches get copied
+    d_input[which_input]->visit_tags_in_range(
+        abs_start, abs_end, id, [&](const tag_t& tag, uint64_t offset) {
+            if (pmt::eqv(key, tag.key)) {
+                v.push_back(tag);
+                v.back().offset = offset;
+            }
+        });
 }
 
 void block_detail::set_processor_affinity(const std::vector<int>& mask)
@@ -275,7 +269,6 @@ void block_detail::stop_perf_counters(int noutput_items, int nproduced)
         d_pc_start_time = (float)gr::high_res_timer_now();
         for (size_t i = 0; i < d_input.size(); i++) {
             buffer_reader_sptr in_buf = d_input[i];
-            gr::thread::scoped_lock guard(*in_buf->mutex());
             float pfull = static_cast<float>(in_buf->items_available()) /
                           static_cast<float>(in_buf->max_possible_items_available());
             d_ins_input_buffers_full[i] = pfull;
@@ -284,7 +277,6 @@ void block_detail::stop_perf_counters(int noutput_items, int nproduced)
         }
         for (size_t i = 0; i < d_output.size(); i++) {
             buffer_sptr out_buf = d_output[i];
-            gr::thread::scoped_lock guard(*out_buf->mutex());
             float pfull = 1.0f - static_cast<float>(out_buf->space_available()) /
                                      static_cast<float>(out_buf->bufsize());
             d_ins_output_buffers_full[i] = pfull;
@@ -315,7 +307,6 @@ void block_detail::stop_perf_counters(int noutput_items, int nproduced)
 
         for (size_t i = 0; i < d_input.size(); i++) {
             buffer_reader_sptr in_buf = d_input[i];
-            gr::thread::scoped_lock guard(*in_buf->mutex());
             float pfull = static_cast<float>(in_buf->items_available()) /
                           static_cast<float>(in_buf->max_possible_items_available());
 
@@ -327,7 +318,6 @@ void block_detail::stop_perf_counters(int noutput_items, int nproduced)
 
         for (size_t i = 0; i < d_output.size(); i++) {
             buffer_sptr out_buf = d_output[i];
-            gr::thread::scoped_lock guard(*out_buf->mutex());
             float pfull = 1.0f - static_cast<float>(out_buf->space_available()) /
                                      static_cast<float>(out_buf->bufsize());
 
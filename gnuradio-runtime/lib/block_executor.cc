@@ -65,7 +65,6 @@ min_available_space(block_detail* d, int output_multiple, int min_noutput_items)
         min_noutput_items = 1;
     for (int i = 0; i < d->noutputs(); i++) {
         buffer_sptr out_buf = d->output(i);
-        gr::thread::scoped_lock guard(*out_buf->mutex());
         int avail_n = round_down(out_buf->space_available(), output_multiple);
         int best_n = round_down(out_buf->bufsize() / 2, output_multiple);
         if (best_n < min_noutput_items)
@@ -82,23 +81,41 @@ min_available_space(block_detail* d, int output_multiple, int min_noutput_items)
     return min_space;
 }
 
+//
+// Where a tag at input item \p offset lands on the outputs.
+//
+static uint64_t
+propagated_offset(uint64_t offset, double rrate, mpq_class& mp_rrate, bool use_fp_rrate)
+{
+    static const mpq_class one_half(1, 2);
+
+    if (rrate == 1.0)
+        return offset;
+    if (use_fp_rrate)
+        return std::llround((double)offset * rrate);
+
+    mpz_class moffset;
+    mpz_import(moffset.get_mpz_t(), 1, 1, sizeof(offset), 0, 0, &offset);
+    moffset = moffset * mp_rrate + one_half;
+    return moffset.get_ui();
+}
+
 static bool propagate_tags(block::tag_propagation_policy_t policy,
                            block_detail* d,
                            const std::vector<uint64_t>& start_nitems_read,
                            double rrate,
                            mpq_class& mp_rrate,
                            bool use_fp_rrate,
-                           std::vector<tag_t>& rtags,
                            long block_id)
 {
-    static const mpq_class one_half(1, 2);
-
     // Move tags downstream
     // if a sink, we don't need to move downstream
     if (d->sink_p()) {
         return true;
     }
 
+    // Tags are read in place from the input buffer and copied once,
+    // straight into each output buffer.
     switch (policy) {
     case block::TPP_DONT:
     case block::TPP_CUSTOM:
@@ -108,49 +125,23 @@ static bool propagate_tags(block::tag_propagation_policy_t policy,
         std::vector<buffer_sptr> out_buf;
 
         for (int i = 0; i < d->ninputs(); i++) {
-            d->get_tags_in_range(
-                rtags, i, start_nitems_read[i], d->nitems_read(i), block_id);
-
-            if (rtags.empty()) {
-                continue;
-            }
-
-            if (out_buf.empty()) {
-                out_buf.reserve(d->noutputs());
-                for (int o = 0; o < d->noutputs(); o++)
-                    out_buf.push_back(d->output(o));
-            }
+            d->input(i)->visit_tags_in_range(
+                start_nitems_read[i],
+                d->nitems_read(i),
+                block_id,
+                [&](const tag_t& tag, uint64_t offset) {
+                    if (out_buf.empty()) {
+                        out_buf.reserve(d->noutputs());
+                        for (int o = 0; o < d->noutputs(); o++)
+                            out_buf.push_back(d->output(o));
+                    }
 
-            std::vector<tag_t>::iterator t;
-            if (rrate == 1.0) {
-                for (t = rtags.begin(); t != rtags.end(); t++) {
-                    for (int o = 0; o < d->noutputs(); o++)
-                        out_buf[o]->add_item_tag(*t);
-                }
-            } else if (use_fp_rrate) {
-                for (t = rtags.begin(); t != rtags.end(); t++) {
-                    tag_t new_tag = *t;
-                    new_tag.offset = std::llround((double)new_tag.offset * rrate);
-                    for (int o = 0; o < d->noutputs(); o++)
-                        out_buf[o]->add_item_tag(new_tag);
-                }
-            } else {
-                mpz_class offset;
-                for (t = rtags.begin(); t != rtags.end(); t++) {
-                    tag_t new_tag = *t;
-                    mpz_import(offset.get_mpz_t(),
-                               1,
-                               1,
-                               sizeof(new_tag.offset),
-                               0,
-                               0,
-                               &new_tag.offset);
-                    offset = offset * mp_rrate + one_half;
-                    new_tag.offset = offset.get_ui();
+                    tag_t new_tag = tag;
+                    new_tag.offset =
+                        propagated_offset(offset, rrate, mp_rrate, use_fp_rrate);
                     for (int o = 0; o < d->noutputs(); o++)
                         out_buf[o]->add_item_tag(new_tag);
-                }
-            }
+                });
         }
     } break;
     case block::TPP_ONE_TO_ONE:
@@ -158,45 +149,18 @@ static bool propagate_tags(block::tag_propagation_policy_t policy,
         // this requires d->ninputs() == d->noutputs; this is checked when this
         // type of tag-propagation system is selected in block_detail
         if (d->ninputs() == d->noutputs()) {
-            buffer_sptr out_buf;
-
             for (int i = 0; i < d->ninputs(); i++) {
-                d->get_tags_in_range(
-                    rtags, i, start_nitems_read[i], d->nitems_read(i), block_id);
-
-                if (rtags.empty()) {
-                    continue;
-                }
-
-                out_buf = d->output(i);
-
-                std::vector<tag_t>::iterator t;
-                if (rrate == 1.0) {
-                    for (t = rtags.begin(); t != rtags.end(); t++) {
-                        out_buf->add_item_tag(*t);
-                    }
-                } else if (use_fp_rrate) {
-                    for (t = rtags.begin(); t != rtags.end(); t++) {
-                        tag_t new_tag = *t;
-                        new_tag.offset = std::llround((double)new_tag.offset * rrate);
-                        out_buf->add_item_tag(new_tag);
-                    }
-                } else {
-                    mpz_class offset;
-                    for (t = rtags.begin(); t != rtags.end(); t++) {
-                        tag_t new_tag = *t;
-                        mpz_import(offset.get_mpz_t(),
-                                   1,
-                                   1,
-                                   sizeof(new_tag.offset),
-                                   0,
-                                   0,
-                                   &new_tag.offset);
-                        offset = offset * mp_rrate + one_half;
-                        new_tag.offset = offset.get_ui();
+                buffer_sptr out_buf = d->output(i);
+                d->input(i)->visit_tags_in_range(
+                    start_nitems_read[i],
+                    d->nitems_read(i),
+                    block_id,
+                    [&](const tag_t& tag, uint64_t offset) {
+                        tag_t new_tag = tag;
+                        new_tag.offset =
+                            propagated_offset(offset, rrate, mp_rrate, use_fp_rrate);
                         out_buf->add_item_tag(new_tag);
-                    }
-                }
+                    });
             }
         } else {
             std::ostringstream msg;
@@ -220,6 +184,12 @@ block_executor::block_executor(block_sptr block, int max_noutput_items)
 #ifdef GR_PERFORMANCE_COUNTERS
     prefs* prefs = prefs::singleton();
     d_use_pc = prefs->get_bool("PerfCounters", "on", false);
+
+    d_tracing = false;
+    d_trace.block_id = d_block->unique_id();
+    tracer::name_block(d_block->unique_id(), d_block->alias());
+    if (prefs->get_bool("PerfCounters", "trace", false))
+        tracer::enable();
 #endif /* GR_PERFORMANCE_COUNTERS */
 
     d_block->start(); // enable any drivers, etc.
@@ -230,7 +200,88 @@ block_executor::~block_executor()
     d_block->stop(); // stop any drivers, etc.
 }
 
+void block_executor::dispatch_msgs()
+{
+    block* m = d_block.get();
+    pmt::pmt_t msg;
+
+    for (const auto& i : m->msg_queue) {
+        // Check if we have a message handler attached before getting
+        // any messages. This is mostly a protection for the unknown
+        // startup sequence of the threads.
+        if (m->has_msg_batch_handler(i.first)) {
+            for (;;) {
+                d_msg_batch.clear();
+                if (!i.second->pop(d_msg_batch, i.second->capacity()))
+                    break;
+                m->dispatch_msg_batch(i.first, d_msg_batch);
+            }
+            d_msg_batch.clear();
+        } else if (m->has_msg_handler(i.first)) {
+            while ((msg = m->delete_head_nowait(i.first))) {
+                m->dispatch_msg(i.first, msg);
+            }
+        } else {
+            // If we don't have a handler but the queue filled up,
+            // prune it from the front so producers that wait for
+            // room aren't stuck.
+            if (i.second->size() >= i.second->capacity()) {
+                GR_LOG_WARN(d_logger,
+                            "asynchronous message buffer overflowing, dropping message");
+                msg = m->delete_head_nowait(i.first);
+            }
+        }
+    }
+}
+
 block_executor::state block_executor::run_one_iteration()
+{
+#ifdef GR_PERFORMANCE_COUNTERS
+    if (tracer::enabled())
+        return traced_iteration();
+#endif /* GR_PERFORMANCE_COUNTERS */
+    return iterate();
+}
+
+#ifdef GR_PERFORMANCE_COUNTERS
+block_executor::state block_executor::traced_iteration()
+{
+    block_detail* d = d_block->detail().get();
+
+    d_trace.start = 0;
+    d_trace.noutput_items = 0;
+    d_trace.nproduced = 0;
+    d_tracing = true;
+    state s = iterate();
+    d_tracing = false;
+
+    if (d_trace.start == 0) // work() wasn't called
+        d_trace.start = d_trace.end = gr::high_res_timer_now();
+    d_trace.result = static_cast<tracer::state>(s);
+
+    d_trace.input_full = 0;
+    for (int i = 0; i < d->ninputs(); i++) {
+        buffer_reader* in_buf = d->input(i).get();
+        d_trace.input_full =
+            std::max(d_trace.input_full,
+                     static_cast<float>(in_buf->items_available()) /
+                         static_cast<float>(in_buf->max_possible_items_available()));
+    }
+    d_trace.output_full = 0;
+    for (int i = 0; i < d->noutputs(); i++) {
+        buffer* out_buf = d->output(i).get();
+        d_trace.output_full =
+            std::max(d_trace.output_full,
+                     1.0f - static_cast<float>(out_buf->space_available()) /
+                                static_cast<float>(out_buf->bufsize()));
+    }
+
+    tracer::record(d_trace);
+    return s;
+}
+#endif /* GR_PERFORMANCE_COUNTERS */
+
+block_executor::state block_executor::iterate()
 {
     int noutput_items;
     int max_items_avail;
@@ -288,12 +339,13 @@ block_executor::state block_executor::run_one_iteration()
         for (int i = 0; i < d->ninputs(); i++) {
             {
                 /*
-                 * Acquire the mutex and grab local copies of items_available and done.
+                 * Grab local copies of done and items_available. Done goes
+                 * first: once it's set, every item written before it is
+                 * visible, so we can't miss the tail end of the stream.
                  */
                 buffer_reader_sptr in_buf = d->input(i);
-                gr::thread::scoped_lock guard(*in_buf->mutex());
-                d_ninput_items[i] = in_buf->items_available();
                 d_input_done[i] = in_buf->done();
+                d_ninput_items[i] = in_buf->items_available();
             }
 
             LOG(std::ostringstream msg;
@@ -339,12 +391,13 @@ block_executor::state block_executor::run_one_iteration()
         for (int i = 0; i < d->ninputs(); i++) {
             {
                 /*
-                 * Acquire the mutex and grab local copies of items_available and done.
+                 * Grab local copies of done and items_available. Done goes
+                 * first: once it's set, every item written before it is
+                 * visible, so we can't miss the tail end of the stream.
                  */
                 buffer_reader_sptr in_buf = d->input(i);
-                gr::thread::scoped_lock guard(*in_buf->mutex());
-                d_ninput_items[i] = in_buf->items_available();
                 d_input_done[i] = in_buf->done();
+                d_ninput_items[i] = in_buf->items_available();
             }
             max_items_avail = std::max(max_items_avail, d_ninput_items[i]);
         }
@@ -496,6 +549,8 @@ block_executor::state block_executor::run_one_iteration()
 #ifdef GR_PERFORMANCE_COUNTERS
         if (d_use_pc)
             d->start_perf_counters();
+        if (d_tracing)
+            d_trace.start = gr::high_res_timer_now();
 #endif /* GR_PERFORMANCE_COUNTERS */
 
         // Do the actual work of the block
@@ -505,6 +560,11 @@ block_executor::state block_executor::run_one_iteration()
 #ifdef GR_PERFORMANCE_COUNTERS
         if (d_use_pc)
             d->stop_perf_counters(noutput_items, n);
+        if (d_tracing) {
+            d_trace.end = gr::high_res_timer_now();
+            d_trace.noutput_items = noutput_items;
+            d_trace.nproduced = n;
+        }
 #endif /* GR_PERFORMANCE_COUNTERS */
 
         LOG(std::ostringstream msg;
@@ -524,7 +584,6 @@ block_executor::state block_executor::run_one_iteration()
                             m->relative_rate(),
                             m->mp_relative_rate(),
                             m->update_rate(),
-                            d_returned_tags,
                             m->unique_id()))
             goto were_done;
 
@@ -15,6 +15,7 @@
 #include <gnuradio/logger.h>
 #include <gnuradio/runtime_types.h>
 #include <gnuradio/tags.h>
+#include <gnuradio/tracer.h>
 #include <fstream>
 #include <memory>
 
@@ -39,17 +40,20 @@ protected:
     std::vector<bool> d_input_done;
     gr_vector_void_star d_output_items;
     std::vector<uint64_t> d_start_nitems_read; // stores where tag counts are before work
-    std::vector<tag_t> d_returned_tags;
     int d_max_noutput_items;
+    std::vector<pmt::pmt_t> d_msg_batch; // for ports with batch handlers
 
 #ifdef GR_PERFORMANCE_COUNTERS
     bool d_use_pc;
+    bool d_tracing; // record into d_trace during this iteration
+    tracer::event d_trace;
 #endif /* GR_PERFORMANCE_COUNTERS */
 
 public:
     block_executor(block_sptr block, int max_noutput_items = 100000);
     ~block_executor();
 
+    // Keep tracer::state in step with this.
     enum state {
         READY,           // We made progress; everything's cool.
         READY_NO_OUTPUT, // We consumed some input, but produced no output.
@@ -62,6 +66,20 @@ public:
      * \brief Run one iteration.
      */
     state run_one_iteration();
+
+    /*
+     * \brief Hand all queued messages to their handlers.
+     *
+     * Ports without a handler are pruned from the front once their
+     * queue is full.
+     */
+    void dispatch_msgs();
+
+private:
+    state iterate();
+#ifdef GR_PERFORMANCE_COUNTERS
+    state traced_iteration();
+#endif /* GR_PERFORMANCE_COUNTERS */
 };
 
 } /* namespace gr */
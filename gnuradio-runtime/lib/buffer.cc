@@ -12,6 +12,8 @@
 #include "config.h"
 #endif
 #include "vmcircbuf.h"
+#include <gnuradio/block.h>
+#include <gnuradio/block_detail.h>
 #include <gnuradio/buffer.h>
 #include <gnuradio/integer_math.h>
 #include <gnuradio/math.h>
@@ -71,10 +73,12 @@ buffer::buffer(int nitems, size_t sizeof_item, block_sptr link)
       d_max_reader_delay(0),
       d_sizeof_item(sizeof_item),
       d_link(link),
+      d_inplace(0),
       d_write_index(0),
       d_abs_write_offset(0),
       d_done(false),
-      d_last_min_items_read(0)
+      d_last_min_items_read(0),
+      d_nholds(0)
 {
     gr::configure_default_loggers(d_logger, d_debug_logger, "buffer");
     if (!allocate_buffer(nitems, sizeof_item))
@@ -83,14 +87,44 @@ buffer::buffer(int nitems, size_t sizeof_item, block_sptr link)
     s_buffer_count++;
 }
 
+buffer::buffer(buffer_sptr upstream, block_sptr link)
+    : d_base(upstream->d_base),
+      d_bufsize(upstream->d_bufsize),
+      d_max_reader_delay(0),
+      d_sizeof_item(upstream->d_sizeof_item),
+      d_link(link),
+      d_inplace_of(upstream),
+      d_inplace(0),
+      d_write_index(upstream->d_write_index.load()),
+      d_abs_write_offset(0),
+      d_done(false),
+      d_last_min_items_read(0),
+      d_nholds(0)
+{
+    gr::configure_default_loggers(d_logger, d_debug_logger, "buffer");
+
+    // A buffer left over from before a reconfiguration may still
+    // point at upstream, but its writer no longer reads from it.
+    upstream->d_inplace = this;
+
+    s_buffer_count++;
+}
+
 buffer_sptr make_buffer(int nitems, size_t sizeof_item, block_sptr link)
 {
     return buffer_sptr(new buffer(nitems, sizeof_item, link));
 }
 
+buffer_sptr make_buffer_inplace(buffer_sptr upstream, block_sptr link)
+{
+    return buffer_sptr(new buffer(upstream, link));
+}
+
 buffer::~buffer()
 {
     assert(d_readers.size() == 0);
+    if (d_inplace_of && d_inplace_of->d_inplace == this)
+        d_inplace_of->d_inplace = 0;
     s_buffer_count--;
 }
 
@@ -126,7 +160,14 @@ bool buffer::allocate_buffer(int nitems, size_t sizeof_item)
     }
 
     d_bufsize = nitems;
-    d_vmcircbuf.reset(gr::vmcircbuf_sysconfig::make(d_bufsize * d_sizeof_item));
+    // Put the pages near the CPUs the writer is pinned to, if it is.
+    std::vector<int> cpus;
+    block_sptr link = d_link.lock();
+    if (link)
+        cpus = link->processor_affinity();
+
+    d_vmcircbuf.reset(
+        gr::vmcircbuf_sysconfig::make_near(d_bufsize * d_sizeof_item, cpus));
     if (d_vmcircbuf == 0) {
         std::ostringstream msg;
         msg << "gr::buffer::allocate_buffer: failed to allocate buffer of size "
@@ -141,8 +182,8 @@ bool buffer::allocate_buffer(int nitems, size_t sizeof_item)
 
 int buffer::space_available()
 {
-    if (d_readers.empty())
-        return d_bufsize - 1; // See comment below
+    if (d_readers.empty()) // See comment below
+        return d_bufsize - held_items(d_write_index.load(std::memory_order_relaxed)) - 1;
 
     else {
         // Find out the maximum amount of data available to our readers
@@ -155,29 +196,114 @@ int buffer::space_available()
         }
 
         if (min_items_read != d_last_min_items_read) {
+            gr::thread::scoped_lock guard(*mutex());
             prune_tags(d_last_min_items_read);
             d_last_min_items_read = min_items_read;
         }
 
+        // Whoever reads a buffer sharing our memory is looking at
+        // items we wrote, so we can't reuse those either. Both use the
+        // same indices.
+        unsigned write_index = d_write_index.load(std::memory_order_relaxed);
+        for (buffer* b = d_inplace; b; b = b->d_inplace) {
+            for (buffer_reader* r : b->d_readers) {
+                most_data = std::max<int>(
+                    most_data,
+                    index_sub(write_index,
+                              r->d_read_index.load(std::memory_order_acquire)));
+            }
+            most_data = std::max(most_data, b->held_items(write_index));
+        }
+
+        // Items held for pmts are like a reader that hasn't got that far.
+        most_data = std::max(most_data, held_items(write_index));
+
         // The -1 ensures that the case d_write_index == d_read_index is
         // unambiguous.  It indicates that there is no data for the reader
         return d_bufsize - most_data - 1;
     }
 }
 
-void* buffer::write_pointer() { return &d_base[d_write_index * d_sizeof_item]; }
+void* buffer::write_pointer()
+{
+    return &d_base[d_write_index.load(std::memory_order_relaxed) * d_sizeof_item];
+}
 
 void buffer::update_write_pointer(int nitems)
 {
-    gr::thread::scoped_lock guard(*mutex());
-    d_write_index = index_add(d_write_index, nitems);
-    d_abs_write_offset += nitems;
+    // Only we write these, so relaxed loads are fine. Store the write
+    // index last: a reader that sees it also sees the new item count.
+    d_abs_write_offset.store(d_abs_write_offset.load(std::memory_order_relaxed) +
+                                 nitems,
+                             std::memory_order_release);
+    d_write_index.store(index_add(d_write_index.load(std::memory_order_relaxed), nitems),
+                        std::memory_order_release);
 }
 
-void buffer::set_done(bool done)
+void buffer::set_done(bool done) { d_done.store(done, std::memory_order_release); }
+
+int buffer::held_items(unsigned write_index)
 {
-    gr::thread::scoped_lock guard(*mutex());
-    d_done = done;
+    if (d_nholds.load(std::memory_order_acquire) == 0)
+        return 0;
+
+    // Held items are all behind the write pointer, so the oldest hold
+    // is the one furthest behind. There are rarely more than a few.
+    gr::thread::scoped_lock guard(d_hold_mutex);
+    int most = 0;
+    for (unsigned index : d_holds)
+        most = std::max<int>(most, index_sub(write_index, index));
+    return most;
+}
+
+std::shared_ptr<uint8_t> buffer::hold(const buffer_sptr& buf, unsigned index, int nitems)
+{
+    if (nitems <= 0 || (unsigned)nitems > buf->d_bufsize / 2)
+        return std::shared_ptr<uint8_t>();
+
+    hold_list_t::iterator h;
+    {
+        // Don't let the holds span more than half the buffer, or the
+        // writer may not get far enough for anyone to finish with them.
+        gr::thread::scoped_lock guard(buf->d_hold_mutex);
+        unsigned end = buf->index_add(index, nitems);
+        for (unsigned other : buf->d_holds) {
+            if (buf->index_sub(end, other) > buf->d_bufsize / 2)
+                return std::shared_ptr<uint8_t>();
+        }
+        h = buf->d_holds.insert(buf->d_holds.end(), index);
+        buf->d_nholds.fetch_add(1, std::memory_order_release);
+    }
+
+    // The circular mapping makes the items contiguous even if they
+    // wrap around the end of the buffer.
+    uint8_t* items =
+        reinterpret_cast<uint8_t*>(&buf->d_base[index * buf->d_sizeof_item]);
+    return std::shared_ptr<uint8_t>(items, [buf, h](uint8_t*) { buf->release(h); });
+}
+
+void buffer::release(hold_list_t::iterator h)
+{
+    {
+        gr::thread::scoped_lock guard(d_hold_mutex);
+        d_holds.erase(h);
+        d_nholds.fetch_sub(1, std::memory_order_release);
+    }
+
+    // The writers may be waiting for this space: ours or, if we share
+    // memory with the buffers upstream, theirs.
+    for (buffer* b = this; b; b = b->d_inplace_of.get()) {
+        block_sptr writer = b->d_link.lock();
+        if (writer && writer->detail())
+            writer->detail()->d_tpb.notify_msg();
+    }
+}
+
+std::shared_ptr<uint8_t> buffer_hold_output(buffer_sptr buf, int start, int nitems)
+{
+    unsigned index =
+        buf->index_add(buf->d_write_index.load(std::memory_order_relaxed), start);
+    return buffer::hold(buf, index, nitems);
 }
 
 buffer_reader_sptr
@@ -186,8 +312,8 @@ buffer_add_reader(buffer_sptr buf, int nzero_preload, block_sptr link, int delay
     if (nzero_preload < 0)
         throw std::invalid_argument("buffer_add_reader: nzero_preload must be >= 0");
 
-    buffer_reader_sptr r(
-        new buffer_reader(buf, buf->index_sub(buf->d_write_index, nzero_preload), link));
+    buffer_reader_sptr r(new buffer_reader(
+        buf, buf->index_sub(buf->d_write_index.load(), nzero_preload), link));
     r->declare_sample_delay(delay);
     buf->d_readers.push_back(r.get());
 
@@ -208,18 +334,21 @@ void buffer::drop_reader(buffer_reader* reader)
 void buffer::add_item_tag(const tag_t& tag)
 {
     gr::thread::scoped_lock guard(*mutex());
-    d_item_tags.insert(std::pair<uint64_t, tag_t>(tag.offset, tag));
+
+    // Tags nearly always arrive in order, so this is usually an append.
+    if (d_item_tags.empty() || d_item_tags.back().offset <= tag.offset)
+        d_item_tags.push_back(tag);
+    else
+        d_item_tags.insert(get_tags_upper_bound(tag.offset), tag);
 }
 
 void buffer::remove_item_tag(const tag_t& tag, long id)
 {
     gr::thread::scoped_lock guard(*mutex());
-    for (std::multimap<uint64_t, tag_t>::iterator it =
-             d_item_tags.lower_bound(tag.offset);
-         it != d_item_tags.upper_bound(tag.offset);
-         ++it) {
-        if ((*it).second == tag) {
-            (*it).second.marked_deleted.push_back(id);
+    tag_store_t::iterator it_end = get_tags_upper_bound(tag.offset);
+    for (tag_store_t::iterator it = get_tags_lower_bound(tag.offset); it != it_end; ++it) {
+        if (*it == tag) {
+            it->marked_deleted.push_back(id);
         }
     }
 }
@@ -228,39 +357,21 @@ void buffer::prune_tags(uint64_t max_time)
 {
     /* NOTE: this function _should_ lock the mutex before editing
        d_item_tags. In practice, this function is only called at
-       runtime by min_available_space in block_executor.cc, which
-       locks the mutex itself.
+       runtime by space_available, which locks the mutex itself.
 
        If this function is used elsewhere, remember to lock the
        buffer's mutex al la the scoped_lock:
            gr::thread::scoped_lock guard(*mutex());
      */
 
-    /*
-      http://www.cplusplus.com/reference/map/multimap/erase/
-      "Iterators, pointers and references referring to elements removed
-      by the function are invalidated. All other iterators, pointers
-      and references keep their validity."
-
-      Store the iterator to be deleted in tmp; increment itr to the
-      next valid iterator, then erase tmp, which now becomes invalid.
-     */
-
-    uint64_t item_time;
-    std::multimap<uint64_t, tag_t>::iterator itr(d_item_tags.begin()), tmp;
-    while (itr != d_item_tags.end()) {
-        item_time = (*itr).second.offset;
-        if (item_time + d_max_reader_delay + bufsize() < max_time) {
-            tmp = itr;
-            itr++;
-            d_item_tags.erase(tmp);
-        } else {
-            // d_item_tags is a map sorted by offset, so when the if
-            // condition above fails, all future tags in the map must also
-            // fail. So just break here.
-            break;
-        }
-    }
+    // Tags are sorted by offset, so the ones old enough to go are all
+    // at the front: find the first keeper and drop everything before it.
+    uint64_t keep_after = d_max_reader_delay + bufsize();
+    tag_store_t::iterator itr = std::partition_point(
+        d_item_tags.begin(), d_item_tags.end(), [=](const tag_t& t) {
+            return t.offset + keep_after < max_time;
+        });
+    d_item_tags.erase(d_item_tags.begin(), itr);
 }
 
 long buffer_ncurrently_allocated() { return s_buffer_count; }
@@ -293,19 +404,32 @@ unsigned buffer_reader::sample_delay() const { return d_attr_delay; }
 
 int buffer_reader::items_available() const
 {
-    return d_buffer->index_sub(d_buffer->d_write_index, d_read_index);
+    return d_buffer->index_sub(d_buffer->d_write_index.load(std::memory_order_acquire),
+                               d_read_index.load(std::memory_order_acquire));
 }
 
 const void* buffer_reader::read_pointer()
 {
-    return &d_buffer->d_base[d_read_index * d_buffer->d_sizeof_item];
+    return &d_buffer->d_base[d_read_index.load(std::memory_order_relaxed) *
+                             d_buffer->d_sizeof_item];
 }
 
 void buffer_reader::update_read_pointer(int nitems)
 {
-    gr::thread::scoped_lock guard(*mutex());
-    d_read_index = d_buffer->index_add(d_read_index, nitems);
-    d_abs_read_offset += nitems;
+    // Same as update_write_pointer: the writer looks at the read index
+    // to find free space, so it goes last.
+    d_abs_read_offset.store(d_abs_read_offset.load(std::memory_order_relaxed) + nitems,
+                            std::memory_order_release);
+    d_read_index.store(
+        d_buffer->index_add(d_read_index.load(std::memory_order_relaxed), nitems),
+        std::memory_order_release);
+}
+
+std::shared_ptr<uint8_t> buffer_reader::hold(int start, int nitems)
+{
+    unsigned index =
+        d_buffer->index_add(d_read_index.load(std::memory_order_relaxed), start);
+    return buffer::hold(d_buffer, index, nitems);
 }
 
 void buffer_reader::get_tags_in_range(std::vector<tag_t>& v,
@@ -313,40 +437,12 @@ void buffer_reader::get_tags_in_range(std::vector<tag_t>& v,
                                       uint64_t abs_end,
                                       long id)
 {
-    gr::thread::scoped_lock guard(*mutex());
-
-    uint64_t lower_bound = abs_start - d_attr_delay;
-    // check for underflow and if so saturate at 0
-    if (lower_bound > abs_start)
-        lower_bound = 0;
-    uint64_t upper_bound = abs_end - d_attr_delay;
-    // check for underflow and if so saturate at 0
-    if (upper_bound > abs_end)
-        upper_bound = 0;
-
     v.clear();
-    std::multimap<uint64_t, tag_t>::iterator itr =
-        d_buffer->get_tags_lower_bound(lower_bound);
-    std::multimap<uint64_t, tag_t>::iterator itr_end =
-        d_buffer->get_tags_upper_bound(upper_bound);
-
-    uint64_t item_time;
-    while (itr != itr_end) {
-        item_time = (*itr).second.offset + d_attr_delay;
-        if ((item_time >= abs_start) && (item_time < abs_end)) {
-            std::vector<long>::iterator id_itr;
-            id_itr = std::find(
-                itr->second.marked_deleted.begin(), itr->second.marked_deleted.end(), id);
-            // If id is not in the vector of marked blocks
-            if (id_itr == itr->second.marked_deleted.end()) {
-                tag_t t = (*itr).second;
-                t.offset += d_attr_delay;
-                v.push_back(t);
-                v.back().marked_deleted.clear();
-            }
-        }
-        itr++;
-    }
+    visit_tags_in_range(abs_start, abs_end, id, [&v](const tag_t& tag, uint64_t offset) {
+        // tag_t's copy leaves marked_deleted behind
+        v.push_back(tag);
+        v.back().offset = offset;
+    });
 }
 
 long buffer_reader_ncurrently_allocated() { return s_buffer_reader_count; }
@@ -17,10 +17,17 @@
 #include <gnuradio/buffer.h>
 #include <gnuradio/logger.h>
 #include <gnuradio/prefs.h>
+#include <gnuradio/sync_block.h>
 #include <volk/volk.h>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <iostream>
 #include <map>
+#include <set>
+
+#ifdef HAVE_SYSCONF
+#include <unistd.h>
+#endif
 
 namespace gr {
 
@@ -29,6 +36,53 @@ namespace gr {
 
 static const unsigned int s_fixed_buffer_size = GR_FIXED_BUFFER_SIZE;
 
+// Adaptive sizing keeps buffers between this and the L2 cache size...
+static const long s_min_buffer_size = 4 * (1L << 10);
+
+// ...and at unlock() grows the ones that ran fuller than this on
+// average and shrinks the ones that ran emptier than that.
+static const float s_grow_threshold = 0.9;
+static const float s_shrink_threshold = 0.1;
+
+static bool adaptive_buffers()
+{
+    return prefs::singleton()->get_string("Buffers", "sizing", "fixed") == "adaptive";
+}
+
+static bool fuse_sync_blocks()
+{
+    return prefs::singleton()->get_bool("Scheduler", "fuse_sync_blocks", false);
+}
+
+static bool inplace_buffers()
+{
+    return prefs::singleton()->get_bool("Scheduler", "inplace_buffers", false);
+}
+
+static long l1_cache_size()
+{
+    long size = prefs::singleton()->get_long("Buffers", "l1_cache_size", 0);
+#if defined(HAVE_SYSCONF) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    if (size <= 0)
+        size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+#endif
+    if (size <= 0)
+        size = 32 * (1L << 10);
+    return size;
+}
+
+static long l2_cache_size()
+{
+    long size = prefs::singleton()->get_long("Buffers", "l2_cache_size", 0);
+#if defined(HAVE_SYSCONF) && defined(_SC_LEVEL2_CACHE_SIZE)
+    if (size <= 0)
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (size <= 0)
+        size = 256 * (1L << 10);
+    return size;
+}
+
 flat_flowgraph_sptr make_flat_flowgraph()
 {
     return flat_flowgraph_sptr(new flat_flowgraph());
@@ -44,8 +98,11 @@ flat_flowgraph::~flat_flowgraph() {}
 void flat_flowgraph::setup_connections()
 {
     basic_block_vector_t blocks = calc_used_blocks();
+    d_item_rates.clear();
 
-    // Assign block details to blocks
+    // Assign block details to blocks, upstream first so a block that
+    // writes over its input finds that buffer already there.
+    blocks = topological_sort(blocks);
     for (basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++)
         cast_to_block_sptr(*p)->set_detail(allocate_block_detail(*p));
 
@@ -94,30 +151,53 @@ block_detail_sptr flat_flowgraph::allocate_block_detail(basic_block_sptr block)
         detail->set_output(i, buffer);
 
         // Update the block's max_output_buffer based on what was actually allocated.
-        if ((grblock->max_output_buffer(i) != buffer->bufsize()) &&
-            (grblock->max_output_buffer(i) != -1))
+        if ((grblock->requested_max_output_buffer(i) != buffer->bufsize()) &&
+            (grblock->requested_max_output_buffer(i) != -1))
             GR_LOG_WARN(d_logger,
                         boost::format("Block (%1%) max output buffer set to %2%"
                                       " instead of requested %3%") %
                             grblock->alias() % buffer->bufsize() %
-                            grblock->max_output_buffer(i));
-        grblock->set_max_output_buffer(i, buffer->bufsize());
+                            grblock->requested_max_output_buffer(i));
+        grblock->set_allocated_output_buffer(i, buffer->bufsize());
     }
 
     return detail;
 }
 
-buffer_sptr flat_flowgraph::allocate_buffer(basic_block_sptr block, int port)
+buffer_sptr
+flat_flowgraph::allocate_buffer(basic_block_sptr block, int port, int nitems_hint)
 {
     block_sptr grblock = cast_to_block_sptr(block);
     if (!grblock)
         throw std::runtime_error("allocate_buffer found non-gr::block");
     int item_size = block->output_signature()->sizeof_stream_item(port);
 
+    // A block that writes over its input needs no memory of its own.
+    if (nitems_hint <= 0) {
+        buffer_sptr upstream = inplace_source(grblock);
+        if (upstream) {
+            if (!grblock->is_set_max_noutput_items())
+                grblock->set_max_noutput_items(upstream->bufsize());
+            return make_buffer_inplace(upstream, grblock);
+        }
+    }
+
     // *2 because we're now only filling them 1/2 way in order to
     // increase the available parallelism when using the TPB scheduler.
     // (We're double buffering, where we used to single buffer)
-    int nitems = s_fixed_buffer_size * 2 / item_size;
+    //
+    // Inside a fused chain the reader runs right after the writer, in
+    // the same thread, so half the L1 cache is plenty: the block's
+    // input and output tiles both stay in it.
+    int nitems;
+    if (nitems_hint > 0)
+        nitems = nitems_hint;
+    else if (fuse_sync_blocks() && fusible_successor(grblock))
+        nitems = std::max(l1_cache_size() / 2 / item_size, 1L);
+    else if (adaptive_buffers())
+        nitems = adaptive_buffer_items(grblock, port);
+    else
+        nitems = s_fixed_buffer_size * 2 / item_size;
 
     // Make sure there are at least twice the output_multiple no. of items
     if (nitems < 2 * grblock->output_multiple()) // Note: this means output_multiple()
@@ -128,10 +208,11 @@ buffer_sptr flat_flowgraph::allocate_buffer(basic_block_sptr block, int port)
     basic_block_vector_t blocks = calc_downstream_blocks(block, port);
 
     // limit buffer size if indicated
-    if (grblock->max_output_buffer(port) > 0) {
+    if (grblock->requested_max_output_buffer(port) > 0) {
         // std::cout << "constraining output items to " << block->max_output_buffer(port)
         // << "\n";
-        nitems = std::min((long)nitems, (long)grblock->max_output_buffer(port));
+        nitems =
+            std::min((long)nitems, (long)grblock->requested_max_output_buffer(port));
         nitems -= nitems % grblock->output_multiple();
         if (nitems < 1)
             throw std::runtime_error("problems allocating a buffer with the given max "
@@ -176,6 +257,220 @@ buffer_sptr flat_flowgraph::allocate_buffer(basic_block_sptr block, int port)
     return b;
 }
 
+int flat_flowgraph::adaptive_buffer_items(block_sptr block, int port)
+{
+    int item_size = block->output_signature()->sizeof_stream_item(port);
+
+    // Give each edge its share of the fixed size: one carrying the
+    // sources' byte rate gets just that, one behind a decimate-by-100
+    // a hundredth of it, one behind an interpolator more. The floor
+    // keeps low rate edges from starving; the ceiling keeps a buffer
+    // (and whoever's reading it) in cache.
+    double bytes = 2.0 * s_fixed_buffer_size * item_rate(block) * item_size;
+    bytes = std::max(bytes, (double)s_min_buffer_size);
+    bytes = std::min(bytes, (double)std::max(l2_cache_size(), s_min_buffer_size));
+
+    return std::max(1, static_cast<int>(bytes / item_size));
+}
+
+double flat_flowgraph::item_rate(block_sptr block)
+{
+    std::map<basic_block_sptr, double>::iterator it = d_item_rates.find(block);
+    if (it != d_item_rates.end())
+        return it->second;
+
+    // Sources put out one byte per unit time on their first port.
+    double rate = 0;
+    edge_vector_t in_edges = calc_upstream_edges(block);
+    if (in_edges.empty()) {
+        rate = 1.0 / block->output_signature()->sizeof_stream_item(0);
+    } else {
+        for (edge_viter_t e = in_edges.begin(); e != in_edges.end(); e++)
+            rate = std::max(rate, item_rate(cast_to_block_sptr(e->src().block())));
+        rate *= block->relative_rate();
+    }
+
+    d_item_rates[block] = rate;
+    return rate;
+}
+
+buffer_sptr flat_flowgraph::inplace_source(block_sptr block)
+{
+    if (!inplace_buffers() || !block->inplace() || in_fused_chain(block) ||
+        !dynamic_cast<sync_block*>(block.get()) ||
+        block->relative_rate() != 1.0 || block->history() != 1 ||
+        calc_used_ports(block, true).size() != 1 ||
+        calc_used_ports(block, false).size() != 1 ||
+        block->input_signature()->sizeof_stream_item(0) !=
+            block->output_signature()->sizeof_stream_item(0))
+        return buffer_sptr();
+
+    // Overwriting items is only fine if nobody else reads them.
+    edge e = calc_upstream_edge(block, 0);
+    block_sptr src = cast_to_block_sptr(e.src().block());
+    int src_port = e.src().port();
+    if (!src || !src->detail() || src->detail()->noutputs() <= src_port ||
+        calc_downstream_blocks(src, src_port).size() != 1)
+        return buffer_sptr();
+
+    // The shared buffer also has to suit whoever reads our output.
+    buffer_sptr upstream = src->detail()->output(src_port);
+    int nitems = std::max(2 * block->output_multiple(),
+                          static_cast<int>(block->min_output_buffer(0)));
+    basic_block_vector_t blocks = calc_downstream_blocks(block, 0);
+    for (basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++) {
+        block_sptr dgrblock = cast_to_block_sptr(*p);
+        if (!dgrblock)
+            return buffer_sptr();
+
+        double decimation = (1.0 / dgrblock->relative_rate());
+        int multiple = dgrblock->output_multiple();
+        int history = dgrblock->history();
+        nitems =
+            std::max(nitems, static_cast<int>(2 * (decimation * multiple + history)));
+    }
+    if (upstream->bufsize() < nitems)
+        return buffer_sptr();
+
+    return upstream;
+}
+
+bool flat_flowgraph::fusible_block(block_sptr block)
+{
+    // Decimators and interpolators are sync blocks too.
+    return dynamic_cast<sync_block*>(block.get()) && block->relative_rate() == 1.0 &&
+           calc_used_ports(block, true).size() == 1 &&
+           calc_used_ports(block, false).size() == 1;
+}
+
+block_sptr flat_flowgraph::fusible_successor(block_sptr block)
+{
+    if (!fusible_block(block))
+        return block_sptr();
+
+    basic_block_vector_t next = calc_downstream_blocks(block, 0);
+    if (next.size() != 1)
+        return block_sptr();
+
+    // One thread can only have one affinity and priority.
+    block_sptr successor = cast_to_block_sptr(next[0]);
+    if (!successor || !fusible_block(successor) ||
+        successor->processor_affinity() != block->processor_affinity() ||
+        successor->thread_priority() != block->thread_priority())
+        return block_sptr();
+
+    return successor;
+}
+
+bool flat_flowgraph::in_fused_chain(block_sptr block)
+{
+    if (!fuse_sync_blocks() || !fusible_block(block))
+        return false;
+    if (fusible_successor(block))
+        return true;
+
+    // The last block of a chain
+    block_sptr src = cast_to_block_sptr(calc_upstream_edge(block, 0).src().block());
+    return src && fusible_successor(src) == block;
+}
+
+std::vector<block_vector_t> flat_flowgraph::fused_chains()
+{
+    std::vector<block_vector_t> chains;
+    if (!fuse_sync_blocks())
+        return chains;
+
+    basic_block_vector_t blocks = calc_used_blocks();
+    std::set<block_sptr> successors;
+    for (basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++) {
+        block_sptr next = fusible_successor(cast_to_block_sptr(*p));
+        if (next)
+            successors.insert(next);
+    }
+
+    // Start a chain at each block that has a successor but isn't one.
+    for (basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++) {
+        block_sptr block = cast_to_block_sptr(*p);
+        if (successors.count(block))
+            continue;
+
+        block_vector_t chain;
+        for (block_sptr b = block; b; b = fusible_successor(b))
+            chain.push_back(b);
+        if (chain.size() > 1)
+            chains.push_back(chain);
+    }
+
+    return chains;
+}
+
+bool flat_flowgraph::buffer_drained(buffer_sptr buf)
+{
+    for (size_t i = 0; i < buf->nreaders(); i++) {
+        if (buf->reader(i)->items_available() > 0)
+            return false;
+    }
+
+    // Readers of buffers sharing its memory read its items too.
+    for (basic_block_viter_t p = d_blocks.begin(); p != d_blocks.end(); p++) {
+        block_detail_sptr detail = cast_to_block_sptr(*p)->detail();
+        for (int i = 0; detail && i < detail->noutputs(); i++) {
+            if (detail->output(i)->inplace_of() == buf &&
+                !buffer_drained(detail->output(i)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void flat_flowgraph::resize_buffers(block_sptr block)
+{
+    block_detail_sptr detail = block->detail();
+
+    // Nothing to go on unless the performance counters ran.
+    if (detail->pc_work_time_total() <= 0)
+        return;
+
+    for (int i = 0; i < detail->noutputs(); i++) {
+        if (block->requested_max_output_buffer(i) > 0)
+            continue; // the user fixed its size
+
+        buffer_sptr old_buffer = detail->output(i);
+        if (old_buffer->inplace_of())
+            continue; // it's the size of the buffer it shares
+
+        // Readers would lose the items they haven't read yet.
+        if (!buffer_drained(old_buffer))
+            continue;
+
+        int item_size = old_buffer->get_sizeof_item();
+        int max_nitems = std::max(l2_cache_size(), s_min_buffer_size) / item_size;
+        int min_nitems = s_min_buffer_size / item_size;
+        float full = detail->pc_output_buffers_full_avg(i);
+
+        int nitems = old_buffer->bufsize();
+        if (full > s_grow_threshold)
+            nitems = std::min(2 * nitems, max_nitems);
+        else if (full < s_shrink_threshold)
+            nitems = std::max(nitems / 2, min_nitems);
+        if (nitems == old_buffer->bufsize())
+            continue;
+
+        buffer_sptr buffer = allocate_buffer(block, i, nitems);
+        block->set_allocated_output_buffer(i, buffer->bufsize());
+        detail->set_output(i, buffer);
+
+        GR_LOG_DEBUG(d_debug_logger,
+                     boost::format("resized buffer on %s:%d from %d to %d items "
+                                   "(%.0f%% full on average)") %
+                         block->identifier() % i % old_buffer->bufsize() %
+                         buffer->bufsize() % (100 * full));
+    }
+
+    detail->reset_perf_counters();
+}
+
 void flat_flowgraph::connect_block_inputs(basic_block_sptr block)
 {
     block_sptr grblock = cast_to_block_sptr(block);
@@ -213,10 +508,13 @@ void flat_flowgraph::connect_block_inputs(basic_block_sptr block)
 
 void flat_flowgraph::merge_connections(flat_flowgraph_sptr old_ffg)
 {
+    d_item_rates.clear();
+
     // Allocate block details if needed.  Only new blocks that aren't pruned out
     // by flattening will need one; existing blocks still in the new flowgraph will
-    // already have one.
-    for (basic_block_viter_t p = d_blocks.begin(); p != d_blocks.end(); p++) {
+    // already have one. Go upstream first, like setup_connections.
+    basic_block_vector_t sorted_blocks = topological_sort(d_blocks);
+    for (basic_block_viter_t p = sorted_blocks.begin(); p != sorted_blocks.end(); p++) {
         block_sptr block = cast_to_block_sptr(*p);
 
         if (!block->detail()) {
@@ -230,6 +528,31 @@ void flat_flowgraph::merge_connections(flat_flowgraph_sptr old_ffg)
         }
     }
 
+    // Resize buffers that didn't suit the traffic they saw. This has to
+    // happen before readers are matched up with buffers below.
+    if (adaptive_buffers()) {
+        for (basic_block_viter_t p = d_blocks.begin(); p != d_blocks.end(); p++) {
+            if (old_ffg->has_block_p(*p))
+                resize_buffers(cast_to_block_sptr(*p));
+        }
+    }
+
+    // A block writing over its input must still be the only reader of
+    // the buffer it shares; if not, it gets one of its own (or another
+    // one to share). Its readers get matched up with it below.
+    for (basic_block_viter_t p = sorted_blocks.begin(); p != sorted_blocks.end(); p++) {
+        block_sptr block = cast_to_block_sptr(*p);
+        block_detail_sptr detail = block->detail();
+        for (int i = 0; i < detail->noutputs(); i++) {
+            buffer_sptr upstream = detail->output(i)->inplace_of();
+            if (upstream && upstream != inplace_source(block)) {
+                buffer_sptr buffer = allocate_buffer(block, i);
+                block->set_allocated_output_buffer(i, buffer->bufsize());
+                detail->set_output(i, buffer);
+            }
+        }
+    }
+
     // Calculate the old edges that will be going away, and clear the
     // buffer readers on the RHS.
     for (edge_viter_t old_edge = old_ffg->d_edges.begin();
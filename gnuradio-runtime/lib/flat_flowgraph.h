@@ -15,6 +15,7 @@
 #include <gnuradio/block.h>
 #include <gnuradio/flowgraph.h>
 #include <gnuradio/logger.h>
+#include <map>
 
 namespace gr {
 
@@ -49,6 +50,15 @@ public:
 
     void dump();
 
+    /*!
+     * Chains of two or more 1:1 sync blocks, in stream order, that a
+     * scheduler may run back to back in one thread. Each block in a
+     * chain but the last feeds only the next one, through a buffer
+     * sized to stay in L1 cache. Empty unless the [Scheduler]
+     * fuse_sync_blocks preference is on.
+     */
+    std::vector<block_vector_t> fused_chains();
+
     /*!
      * Make a vector of gr::block from a vector of gr::basic_block
      */
@@ -79,9 +89,53 @@ private:
     flat_flowgraph();
 
     block_detail_sptr allocate_block_detail(basic_block_sptr block);
-    buffer_sptr allocate_buffer(basic_block_sptr block, int port);
+    buffer_sptr allocate_buffer(basic_block_sptr block, int port, int nitems_hint = 0);
     void connect_block_inputs(basic_block_sptr block);
 
+    /* Whether \p block is a sync block with one input and one output
+     * that doesn't change the rate.
+     */
+    bool fusible_block(block_sptr block);
+
+    /* If \p block and the single block after it both are fusible,
+     * return that block.
+     */
+    block_sptr fusible_successor(block_sptr block);
+
+    /* Whether \p block is one of the blocks of a fused chain. */
+    bool in_fused_chain(block_sptr block);
+
+    /* If \p block can write its output over its input and is the only
+     * reader of the buffer it reads from, return that buffer. Blocks
+     * in fused chains keep their L1 sized buffers instead.
+     */
+    buffer_sptr inplace_source(block_sptr block);
+
+    /* With adaptive buffer sizing, how many items the buffer on
+     * \p port of \p block should nominally hold, before the
+     * output_multiple and downstream constraints.
+     */
+    int adaptive_buffer_items(block_sptr block, int port);
+
+    /* Items per unit of time at the output of \p block, where each
+     * source puts out one byte per unit. Memoized in d_item_rates.
+     */
+    double item_rate(block_sptr block);
+
+    /* Whether every reader of \p buf, and of any buffer sharing its
+     * memory, has read all there is to read.
+     */
+    bool buffer_drained(buffer_sptr buf);
+
+    /* With adaptive buffer sizing, replace the output buffers of
+     * \p block that ran nearly full or nearly empty since the last
+     * start, as seen by the performance counters, and that no reader
+     * still has items to read from. Buffers the user set a maximum size
+     * for are left alone. Called from merge_connections before readers
+     * are reattached, so readers of a replaced buffer get new ones.
+     */
+    void resize_buffers(block_sptr block);
+
     /* When reusing a flowgraph's blocks, this call makes sure all of
      * the buffer's are aligned at the machine's alignment boundary
      * and tells the blocks that they are aligned.
@@ -91,6 +145,8 @@ private:
      */
     void setup_buffer_alignment(block_sptr block);
 
+    std::map<basic_block_sptr, double> d_item_rates;
+
     gr::logger_ptr d_logger;
     gr::logger_ptr d_debug_logger;
 };
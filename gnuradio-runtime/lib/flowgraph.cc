@@ -126,12 +126,10 @@ void flowgraph::check_valid_port(const msg_endpoint& e)
         std::cout << "check_valid_port( " << e.block() << ", " << e.port() << ")\n";
 
     if (!e.block()->has_msg_port(e.port())) {
-        const gr::basic_block::msg_queue_map_t& msg_map = e.block()->get_msg_map();
+        pmt::pmt_t ports = e.block()->message_ports_in();
         std::cout << "Could not find port: " << e.port() << " in:" << std::endl;
-        for (gr::basic_block::msg_queue_map_t::const_iterator it = msg_map.begin();
-             it != msg_map.end();
-             ++it)
-            std::cout << it->first << std::endl;
+        for (size_t i = 0; i < pmt::length(ports); i++)
+            std::cout << pmt::vector_ref(ports, i) << std::endl;
         std::cout << std::endl;
         throw std::invalid_argument("invalid msg port in connect() or disconnect()");
     }
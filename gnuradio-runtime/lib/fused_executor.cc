@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "fused_executor.h"
+#include <gnuradio/block_detail.h>
+
+namespace gr {
+
+fused_executor::fused_executor(const block_vector_t& blocks, int max_noutput_items)
+    : d_blocks(blocks), d_ndone(0)
+{
+    for (const block_sptr& b : d_blocks) {
+        // If set, use internal value instead of global value
+        int block_max_noutput_items =
+            b->is_set_max_noutput_items() ? b->max_noutput_items() : max_noutput_items;
+
+        // Constructing the executor starts the block.
+        d_execs.emplace_back(new block_executor(b, block_max_noutput_items));
+
+        // make sure our block isn't finished
+        b->clear_finished();
+    }
+}
+
+fused_executor::~fused_executor() {}
+
+void fused_executor::dispatch_msgs()
+{
+    for (const auto& e : d_execs) {
+        if (e)
+            e->dispatch_msgs();
+    }
+}
+
+block_executor::state fused_executor::run_one_iteration()
+{
+    bool progress = false;
+
+    for (size_t i = 0; i < d_blocks.size(); i++) {
+        if (!d_execs[i])
+            continue;
+
+        block* m = d_blocks[i].get();
+        block_executor::state s = d_execs[i]->run_one_iteration();
+
+        if (m->finished() && s == block_executor::READY_NO_OUTPUT) {
+            s = block_executor::DONE;
+            m->detail()->set_done(true);
+        }
+
+        // A block that consumed without producing, or that's blocked,
+        // leaves nothing new for its neighbors in the chain.
+        if (s == block_executor::READY) {
+            progress = true;
+        } else if (s == block_executor::DONE) {
+            m->notify_msg_neighbors();
+            d_execs[i].reset(); // stop any drivers, etc.
+            d_ndone++;
+            progress = true;
+        }
+    }
+
+    if (d_ndone == d_blocks.size())
+        return block_executor::DONE;
+    return progress ? block_executor::READY : block_executor::BLKD_IN;
+}
+
+} /* namespace gr */
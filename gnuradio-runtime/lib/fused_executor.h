@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_GR_RUNTIME_FUSED_EXECUTOR_H
+#define INCLUDED_GR_RUNTIME_FUSED_EXECUTOR_H
+
+#include "block_executor.h"
+#include <gnuradio/api.h>
+#include <gnuradio/block.h>
+#include <memory>
+#include <vector>
+
+namespace gr {
+
+/*!
+ * \brief Manage the execution of a chain of blocks as if it were one.
+ * \ingroup internal
+ *
+ * The chain comes from flat_flowgraph::fused_chains(): each block
+ * feeds only the next one. An iteration runs every block once, in
+ * stream order, so a tile written by one block is read by the next
+ * while it's still in cache. Each block keeps its own detail and
+ * buffers, so tags, item counters and message ports work as usual.
+ *
+ * To the scheduler the chain looks like a block with the first
+ * block's inputs and the last block's outputs.
+ */
+class GR_RUNTIME_API fused_executor
+{
+    block_vector_t d_blocks;
+    std::vector<std::unique_ptr<block_executor>> d_execs; // null once done
+    size_t d_ndone;
+
+public:
+    fused_executor(const block_vector_t& blocks, int max_noutput_items = 100000);
+    ~fused_executor();
+
+    const block_vector_t& blocks() const { return d_blocks; }
+    block_sptr head() const { return d_blocks.front(); }
+    block_sptr tail() const { return d_blocks.back(); }
+
+    /*!
+     * \brief Run one iteration of each block that isn't done yet.
+     *
+     * Returns READY if any block made progress or finished, DONE
+     * once all of them are done, and BLKD_IN otherwise. In the last
+     * case the chain can only move again once its head's input, its
+     * tail's output or some block's message queue changes.
+     */
+    block_executor::state run_one_iteration();
+
+    /*!
+     * \brief Hand all queued messages to their handlers, for every
+     * block that isn't done yet.
+     */
+    void dispatch_msgs();
+};
+
+} /* namespace gr */
+
+#endif /* INCLUDED_GR_RUNTIME_FUSED_EXECUTOR_H */
@@ -45,4 +45,18 @@ void msg_accepter::post(pmt::pmt_t which_port, pmt::pmt_t msg)
     throw std::runtime_error("unknown derived class");
 }
 
+void msg_accepter::post(pmt::pmt_t which_port, const std::vector<pmt::pmt_t>& msgs)
+{
+    // Blocks queue the lot and wake up once...
+    block* p = dynamic_cast<block*>(this);
+    if (p) {
+        p->_post(which_port, msgs);
+        return;
+    }
+
+    // ...anything else gets them one at a time.
+    for (const pmt::pmt_t& msg : msgs)
+        post(which_port, msg);
+}
+
 } /* namespace gr */
@@ -0,0 +1,337 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/msg_port_queue.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+namespace gr {
+
+msg_port_queue::msg_port_queue(size_t capacity, overflow_policy policy)
+    : d_mask([capacity]() {
+          size_t n = 2;
+          while (n < capacity)
+              n *= 2;
+          return n - 1;
+      }()),
+      d_cells(new cell[d_mask + 1]),
+      d_tail(0),
+      d_head(0),
+      d_policy(policy),
+      d_capacity(d_mask + 1),
+      d_npushed(0),
+      d_ndropped(0),
+      d_nblocked(0),
+      d_noverflow(0),
+      d_nheld(0),
+      d_nwaiting(0)
+{
+    // Cell i is free for the push at position i.
+    for (size_t i = 0; i <= d_mask; i++)
+        d_cells[i].seq.store(i, std::memory_order_relaxed);
+}
+
+msg_port_queue::~msg_port_queue() {}
+
+bool msg_port_queue::try_push(const pmt::pmt_t& msg)
+{
+    size_t pos = d_tail.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+        c = &d_cells[pos & d_mask];
+        size_t seq = c->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (d_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false; // the cell still holds last lap's message
+        } else {
+            pos = d_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    c->msg = msg;
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+pmt::pmt_t msg_port_queue::pop_ring()
+{
+    size_t pos = d_head.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+        c = &d_cells[pos & d_mask];
+        size_t seq = c->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (d_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return pmt::pmt_t(); // empty, or the push is still going on
+        } else {
+            pos = d_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    pmt::pmt_t msg;
+    msg.swap(c->msg);
+    c->seq.store(pos + d_mask + 1, std::memory_order_release);
+    return msg;
+}
+
+size_t msg_port_queue::pop_ring(std::vector<pmt::pmt_t>& msgs, size_t max)
+{
+    if (max == 0)
+        return 0;
+
+    size_t pos = d_head.load(std::memory_order_relaxed);
+    size_t n;
+    for (;;) {
+        size_t seq = d_cells[pos & d_mask].seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff < 0)
+            return 0;
+        if (diff > 0) {
+            pos = d_head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // Take the run of finished pushes that follows, if head is
+        // still where we saw it.
+        n = 1;
+        while (n < max) {
+            cell& next = d_cells[(pos + n) & d_mask];
+            if (next.seq.load(std::memory_order_acquire) != pos + n + 1)
+                break;
+            n++;
+        }
+        if (d_head.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+            break;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        cell& c = d_cells[(pos + i) & d_mask];
+        msgs.push_back(pmt::pmt_t());
+        msgs.back().swap(c.msg);
+        c.seq.store(pos + i + d_mask + 1, std::memory_order_release);
+    }
+    return n;
+}
+
+pmt::pmt_t msg_port_queue::pop_held()
+{
+    pmt::pmt_t msg;
+    gr::thread::scoped_lock guard(d_overflow_mutex);
+    if (!d_held.empty()) {
+        msg.swap(d_held.front());
+        d_held.pop_front();
+        d_nheld.fetch_sub(1, std::memory_order_release);
+    }
+    return msg;
+}
+
+pmt::pmt_t msg_port_queue::pop()
+{
+    pmt::pmt_t msg;
+    if (d_nheld.load(std::memory_order_acquire) > 0)
+        msg = pop_held();
+    if (!msg)
+        msg = pop_ring();
+    if (!msg && d_noverflow.load(std::memory_order_acquire) > 0) {
+        gr::thread::scoped_lock guard(d_overflow_mutex);
+        if (!d_overflow.empty()) {
+            msg.swap(d_overflow.front());
+            d_overflow.pop_front();
+            d_noverflow.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    if (msg)
+        wake_producers();
+    return msg;
+}
+
+size_t msg_port_queue::pop(std::vector<pmt::pmt_t>& msgs, size_t max)
+{
+    size_t n = 0;
+    while (n < max && d_nheld.load(std::memory_order_acquire) > 0) {
+        pmt::pmt_t msg = pop_held();
+        if (!msg)
+            break;
+        msgs.push_back(std::move(msg));
+        n++;
+    }
+    n += pop_ring(msgs, max - n);
+    if (n < max && d_noverflow.load(std::memory_order_acquire) > 0) {
+        // Whatever is in the ring was pushed before these.
+        gr::thread::scoped_lock guard(d_overflow_mutex);
+        while (n < max && !d_overflow.empty()) {
+            msgs.push_back(pmt::pmt_t());
+            msgs.back().swap(d_overflow.front());
+            d_overflow.pop_front();
+            d_noverflow.fetch_sub(1, std::memory_order_release);
+            n++;
+        }
+    }
+
+    if (n > 0)
+        wake_producers();
+    return n;
+}
+
+void msg_port_queue::wake_producers()
+{
+    // Either a waiting producer has announced itself by now, or its
+    // next try will see the cells we just freed.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (d_nwaiting.load(std::memory_order_relaxed) > 0) {
+        gr::thread::scoped_lock guard(d_mutex);
+        d_not_full.notify_all();
+    }
+}
+
+void msg_port_queue::push_any(const pmt::pmt_t& msg)
+{
+    if (d_noverflow.load(std::memory_order_acquire) == 0 && try_push(msg))
+        return;
+
+    gr::thread::scoped_lock guard(d_overflow_mutex);
+    d_overflow.push_back(msg);
+    d_noverflow.fetch_add(1, std::memory_order_release);
+}
+
+bool msg_port_queue::push(const pmt::pmt_t& msg)
+{
+    d_npushed.fetch_add(1, std::memory_order_relaxed);
+    overflow_policy p = policy();
+    if (p == GROW || !full()) {
+        push_any(msg);
+        return true;
+    }
+
+    switch (p) {
+    case DROP_NEWEST:
+        d_ndropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+
+    case DROP_OLDEST:
+        // Someone else may pop in between; keep going until there's
+        // room for our message.
+        do {
+            if (pop())
+                d_ndropped.fetch_add(1, std::memory_order_relaxed);
+        } while (full());
+        push_any(msg);
+        return false;
+
+    case BLOCK:
+    default:
+        d_nblocked.fetch_add(1, std::memory_order_relaxed);
+        gr::thread::scoped_lock guard(d_mutex);
+        d_nwaiting.fetch_add(1, std::memory_order_seq_cst);
+        try {
+            // Interrupting the thread, as stopping a flowgraph does,
+            // gets us out of here.
+            while (full()) {
+                if (policy() != BLOCK) {
+                    d_nwaiting.fetch_sub(1, std::memory_order_seq_cst);
+                    guard.unlock();
+                    d_npushed.fetch_sub(1, std::memory_order_relaxed);
+                    return push(msg);
+                }
+                d_not_full.wait(guard);
+            }
+        } catch (...) {
+            d_nwaiting.fetch_sub(1, std::memory_order_seq_cst);
+            throw;
+        }
+        d_nwaiting.fetch_sub(1, std::memory_order_seq_cst);
+        guard.unlock();
+        push_any(msg);
+        return true;
+    }
+}
+
+size_t msg_port_queue::size() const
+{
+    size_t head = d_head.load(std::memory_order_relaxed);
+    size_t tail = d_tail.load(std::memory_order_relaxed);
+    return (tail > head ? tail - head : 0) + d_noverflow.load(std::memory_order_relaxed) +
+           d_nheld.load(std::memory_order_relaxed);
+}
+
+void msg_port_queue::set_capacity(size_t capacity)
+{
+    size_t n = 2;
+    while (n < capacity)
+        n *= 2;
+    d_capacity.store(n, std::memory_order_relaxed);
+
+    // Let anyone waiting for room look again.
+    gr::thread::scoped_lock guard(d_mutex);
+    d_not_full.notify_all();
+}
+
+void msg_port_queue::set_policy(overflow_policy policy)
+{
+    d_policy.store(policy, std::memory_order_relaxed);
+
+    // Let anyone waiting under the old policy look again.
+    gr::thread::scoped_lock guard(d_mutex);
+    d_not_full.notify_all();
+}
+
+std::deque<pmt::pmt_t>& msg_port_queue::hold_all()
+{
+    gr::thread::scoped_lock guard(d_overflow_mutex);
+
+    // What's in the ring was pushed before what's behind it.
+    for (pmt::pmt_t msg; (msg = pop_ring());)
+        d_held.push_back(std::move(msg));
+    size_t n = d_overflow.size();
+    std::move(d_overflow.begin(), d_overflow.end(), std::back_inserter(d_held));
+    d_overflow.clear();
+    d_noverflow.fetch_sub(n, std::memory_order_release);
+    d_nheld.store(d_held.size(), std::memory_order_release);
+    return d_held;
+}
+
+void msg_port_queue::erase_held(std::deque<pmt::pmt_t>::iterator it)
+{
+    {
+        gr::thread::scoped_lock guard(d_overflow_mutex);
+        d_held.erase(it);
+        d_nheld.fetch_sub(1, std::memory_order_release);
+    }
+    wake_producers();
+}
+
+msg_port_queue::overflow_policy
+msg_port_queue::policy_from_string(const std::string& name)
+{
+    if (name == "block")
+        return BLOCK;
+    if (name == "drop_oldest")
+        return DROP_OLDEST;
+    if (name == "drop_newest")
+        return DROP_NEWEST;
+    if (name == "grow")
+        return GROW;
+    throw std::invalid_argument("msg_port_queue: unknown overflow policy " + name);
+}
+
+} /* namespace gr */
@@ -16,9 +16,14 @@
 #include <gnuradio/messages/msg_accepter.h>
 #include <pmt/pmt.h>
 #include <pmt/pmt_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <cstdio>
 #include <cstring>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace pmt {
@@ -68,6 +73,8 @@ static pmt_complex* _complex(pmt_t x) { return dynamic_cast<pmt_complex*>(x.get(
 
 static pmt_pair* _pair(pmt_t x) { return dynamic_cast<pmt_pair*>(x.get()); }
 
+static pmt_dict* _dict(const pmt_t& x) { return dynamic_cast<pmt_dict*>(x.get()); }
+
 static pmt_vector* _vector(pmt_t x) { return dynamic_cast<pmt_vector*>(x.get()); }
 
 static pmt_tuple* _tuple(pmt_t x) { return dynamic_cast<pmt_tuple*>(x.get()); }
@@ -87,19 +94,19 @@ pmt_null::pmt_null() {}
 
 pmt_t get_PMT_NIL()
 {
-    static pmt_t _NIL = pmt_t(new pmt_null());
+    static pmt_t _NIL = make_pmt<pmt_null>();
     return _NIL;
 }
 
 pmt_t get_PMT_T()
 {
-    static const pmt_t _T = pmt_t(new pmt_bool());
+    static const pmt_t _T = make_pmt<pmt_bool>();
     return _T;
 }
 
 pmt_t get_PMT_F()
 {
-    static const pmt_t _F = pmt_t(new pmt_bool());
+    static const pmt_t _F = make_pmt<pmt_bool>();
     return _F;
 }
 
@@ -136,18 +143,108 @@ bool to_bool(pmt_t val)
 //                             Symbols
 ////////////////////////////////////////////////////////////////////////////
 
-static const unsigned int get_symbol_hash_table_size()
-{
-    static const unsigned int SYMBOL_HASH_TABLE_SIZE = 8192;
-    return SYMBOL_HASH_TABLE_SIZE;
-}
+/*
+ * Interned symbols live in a set of shards picked by the low bits of the
+ * name's hash. Each shard is an open addressed table of immortal entries
+ * that readers probe without locking; the shard's mutex is only taken to
+ * insert. When a table gets half full it's copied into one twice the size
+ * and the new one published. Readers may still be probing the old table,
+ * so old tables are kept around rather than freed. That costs at most as
+ * much again as the live tables, and symbols are never freed anyway.
+ */
+namespace {
+
+const unsigned SYMBOL_SHARD_BITS = 4;
+const unsigned SYMBOL_NSHARDS = 1 << SYMBOL_SHARD_BITS;
+const size_t SYMBOL_INITIAL_SLOTS = 64;
+
+struct symbol_entry {
+    size_t hash;
+    pmt_t sym;
+};
+
+struct symbol_slots {
+    size_t mask;
+    std::unique_ptr<std::atomic<symbol_entry*>[]> slots;
+
+    explicit symbol_slots(size_t n)
+        : mask(n - 1), slots(new std::atomic<symbol_entry*>[n])
+    {
+        for (size_t i = 0; i < n; i++)
+            slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+};
+
+struct symbol_shard {
+    std::atomic<symbol_slots*> table;
+    size_t count; // guarded by mutex
+    std::mutex mutex;
+    std::vector<std::unique_ptr<symbol_slots>> tables; // current one is last
+
+    symbol_shard() : count(0)
+    {
+        tables.emplace_back(new symbol_slots(SYMBOL_INITIAL_SLOTS));
+        table.store(tables.back().get(), std::memory_order_relaxed);
+    }
+
+    static const pmt_t* find(const symbol_slots* t, size_t hash, const std::string& name)
+    {
+        for (size_t i = hash >> SYMBOL_SHARD_BITS;; i++) {
+            const symbol_entry* e = t->slots[i & t->mask].load(std::memory_order_acquire);
+            if (!e)
+                return nullptr;
+            if (e->hash == hash &&
+                static_cast<pmt_symbol*>(e->sym.get())->name() == name)
+                return &e->sym;
+        }
+    }
+
+    static void put(symbol_slots* t, symbol_entry* e)
+    {
+        size_t i = e->hash >> SYMBOL_SHARD_BITS;
+        while (t->slots[i & t->mask].load(std::memory_order_relaxed))
+            i++;
+        t->slots[i & t->mask].store(e, std::memory_order_release);
+    }
+
+    pmt_t intern(size_t hash, const std::string& name)
+    {
+        if (const pmt_t* sym = find(table.load(std::memory_order_acquire), hash, name))
+            return *sym;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        // Re-do the search in case another thread inserted it meanwhile.
+        symbol_slots* t = tables.back().get();
+        if (const pmt_t* sym = find(t, hash, name))
+            return *sym;
+
+        if (2 * (count + 1) > t->mask + 1) {
+            std::unique_ptr<symbol_slots> bigger(new symbol_slots(2 * (t->mask + 1)));
+            for (size_t i = 0; i <= t->mask; i++) {
+                if (symbol_entry* e = t->slots[i].load(std::memory_order_relaxed))
+                    put(bigger.get(), e);
+            }
+            t = bigger.get();
+            tables.push_back(std::move(bigger));
+            table.store(t, std::memory_order_release);
+        }
+
+        symbol_entry* e = new symbol_entry{ hash, make_pmt<pmt_symbol>(name) };
+        put(t, e);
+        count++;
+        return e->sym;
+    }
+};
 
-static std::vector<pmt_t>* get_symbol_hash_table()
+// Never destroyed, so symbols stay valid during static destruction.
+symbol_shard* get_symbol_shards()
 {
-    static std::vector<pmt_t> s_symbol_hash_table(get_symbol_hash_table_size());
-    return &s_symbol_hash_table;
+    static symbol_shard* s_shards = new symbol_shard[SYMBOL_NSHARDS];
+    return s_shards;
 }
 
+} // namespace
+
 pmt_symbol::pmt_symbol(const std::string& name) : d_name(name) {}
 
 
@@ -155,29 +252,8 @@ bool is_symbol(const pmt_t& obj) { return obj->is_symbol(); }
 
 pmt_t string_to_symbol(const std::string& name)
 {
-    unsigned hash = std::hash<std::string>()(name) % get_symbol_hash_table_size();
-
-    // Does a symbol with this name already exist?
-    for (pmt_t sym = (*get_symbol_hash_table())[hash]; sym; sym = _symbol(sym)->next()) {
-        if (name == _symbol(sym)->name())
-            return sym; // Yes.  Return it
-    }
-
-    // Lock the table on insert for thread safety:
-    static boost::mutex thread_safety;
-    boost::mutex::scoped_lock lock(thread_safety);
-    // Re-do the search in case another thread inserted this symbol into the table
-    // before we got the lock
-    for (pmt_t sym = (*get_symbol_hash_table())[hash]; sym; sym = _symbol(sym)->next()) {
-        if (name == _symbol(sym)->name())
-            return sym; // Yes.  Return it
-    }
-
-    // Nope.  Make a new one.
-    pmt_t sym = pmt_t(new pmt_symbol(name));
-    _symbol(sym)->set_next((*get_symbol_hash_table())[hash]);
-    (*get_symbol_hash_table())[hash] = sym;
-    return sym;
+    size_t hash = std::hash<std::string>()(name);
+    return get_symbol_shards()[hash & (SYMBOL_NSHARDS - 1)].intern(hash, name);
 }
 
 // alias...
@@ -207,7 +283,7 @@ pmt_integer::pmt_integer(long value) : d_value(value) {}
 bool is_integer(pmt_t x) { return x->is_integer(); }
 
 
-pmt_t from_long(long x) { return pmt_t(new pmt_integer(x)); }
+pmt_t from_long(long x) { return make_pmt<pmt_integer>(x); }
 
 long to_long(pmt_t x)
 {
@@ -227,7 +303,7 @@ pmt_uint64::pmt_uint64(uint64_t value) : d_value(value) {}
 bool is_uint64(pmt_t x) { return x->is_uint64(); }
 
 
-pmt_t from_uint64(uint64_t x) { return pmt_t(new pmt_uint64(x)); }
+pmt_t from_uint64(uint64_t x) { return make_pmt<pmt_uint64>(x); }
 
 uint64_t to_uint64(pmt_t x)
 {
@@ -250,9 +326,9 @@ pmt_real::pmt_real(double value) : d_value(value) {}
 
 bool is_real(pmt_t x) { return x->is_real(); }
 
-pmt_t from_double(double x) { return pmt_t(new pmt_real(x)); }
+pmt_t from_double(double x) { return make_pmt<pmt_real>(x); }
 
-pmt_t from_float(float x) { return pmt_t(new pmt_real(x)); }
+pmt_t from_float(float x) { return make_pmt<pmt_real>(x); }
 
 double to_double(pmt_t x)
 {
@@ -280,15 +356,12 @@ pmt_t from_complex(double re, double im) { return pmt_from_complex(re, im); }
 
 pmt_t pmt_from_complex(double re, double im)
 {
-    return pmt_t(new pmt_complex(std::complex<double>(re, im)));
+    return make_pmt<pmt_complex>(std::complex<double>(re, im));
 }
 
-pmt_t pmt_from_complex(const std::complex<double>& z)
-{
-    return pmt_t(new pmt_complex(z));
-}
+pmt_t pmt_from_complex(const std::complex<double>& z) { return make_pmt<pmt_complex>(z); }
 
-pmt_t from_complex(const std::complex<double>& z) { return pmt_t(new pmt_complex(z)); }
+pmt_t from_complex(const std::complex<double>& z) { return make_pmt<pmt_complex>(z); }
 
 std::complex<double> to_complex(pmt_t x)
 {
@@ -312,13 +385,16 @@ bool is_null(const pmt_t& x) { return x == PMT_NIL; }
 
 bool is_pair(const pmt_t& obj) { return obj->is_pair(); }
 
-pmt_t cons(const pmt_t& x, const pmt_t& y) { return pmt_t(new pmt_pair(x, y)); }
+pmt_t cons(const pmt_t& x, const pmt_t& y) { return make_pmt<pmt_pair>(x, y); }
 
 pmt_t car(const pmt_t& pair)
 {
     pmt_pair* p = dynamic_cast<pmt_pair*>(pair.get());
-    if (p)
+    if (p) {
+        if (p->is_dict())
+            static_cast<pmt_dict*>(p)->materialize();
         return p->car();
+    }
 
     throw wrong_type("pmt_car", pair);
 }
@@ -326,25 +402,32 @@ pmt_t car(const pmt_t& pair)
 pmt_t cdr(const pmt_t& pair)
 {
     pmt_pair* p = dynamic_cast<pmt_pair*>(pair.get());
-    if (p)
+    if (p) {
+        if (p->is_dict())
+            static_cast<pmt_dict*>(p)->materialize();
         return p->cdr();
+    }
 
     throw wrong_type("pmt_cdr", pair);
 }
 
 void set_car(pmt_t pair, pmt_t obj)
 {
-    if (pair->is_pair())
+    if (pair->is_pair()) {
+        if (pair->is_dict())
+            _dict(pair)->drop_index();
         _pair(pair)->set_car(obj);
-    else
+    } else
         throw wrong_type("pmt_set_car", pair);
 }
 
 void set_cdr(pmt_t pair, pmt_t obj)
 {
-    if (pair->is_pair())
+    if (pair->is_pair()) {
+        if (pair->is_dict())
+            _dict(pair)->drop_index();
         _pair(pair)->set_cdr(obj);
-    else
+    } else
         throw wrong_type("pmt_set_cdr", pair);
 }
 
@@ -380,7 +463,7 @@ void pmt_vector::fill(pmt_t obj)
 
 bool is_vector(pmt_t obj) { return obj->is_vector(); }
 
-pmt_t make_vector(size_t k, pmt_t fill) { return pmt_t(new pmt_vector(k, fill)); }
+pmt_t make_vector(size_t k, pmt_t fill) { return make_pmt<pmt_vector>(k, fill); }
 
 pmt_t vector_ref(pmt_t vector, size_t k)
 {
@@ -428,52 +511,57 @@ pmt_t tuple_ref(const pmt_t& tuple, size_t k)
 // for (i=0; i < 10; i++)
 //   make_constructor()
 
-pmt_t make_tuple() { return pmt_t(new pmt_tuple(0)); }
+pmt_t make_tuple() { return make_pmt<pmt_tuple>(0); }
 
 pmt_t make_tuple(const pmt_t& e0)
 {
-    pmt_tuple* t = new pmt_tuple(1);
+    pmt_t r = make_pmt<pmt_tuple>(1);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0, const pmt_t& e1)
 {
-    pmt_tuple* t = new pmt_tuple(2);
+    pmt_t r = make_pmt<pmt_tuple>(2);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0, const pmt_t& e1, const pmt_t& e2)
 {
-    pmt_tuple* t = new pmt_tuple(3);
+    pmt_t r = make_pmt<pmt_tuple>(3);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0, const pmt_t& e1, const pmt_t& e2, const pmt_t& e3)
 {
-    pmt_tuple* t = new pmt_tuple(4);
+    pmt_t r = make_pmt<pmt_tuple>(4);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
     t->_set(3, e3);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(
     const pmt_t& e0, const pmt_t& e1, const pmt_t& e2, const pmt_t& e3, const pmt_t& e4)
 {
-    pmt_tuple* t = new pmt_tuple(5);
+    pmt_t r = make_pmt<pmt_tuple>(5);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
     t->_set(3, e3);
     t->_set(4, e4);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0,
@@ -483,14 +571,15 @@ pmt_t make_tuple(const pmt_t& e0,
                  const pmt_t& e4,
                  const pmt_t& e5)
 {
-    pmt_tuple* t = new pmt_tuple(6);
+    pmt_t r = make_pmt<pmt_tuple>(6);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
     t->_set(3, e3);
     t->_set(4, e4);
     t->_set(5, e5);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0,
@@ -501,7 +590,8 @@ pmt_t make_tuple(const pmt_t& e0,
                  const pmt_t& e5,
                  const pmt_t& e6)
 {
-    pmt_tuple* t = new pmt_tuple(7);
+    pmt_t r = make_pmt<pmt_tuple>(7);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
@@ -509,7 +599,7 @@ pmt_t make_tuple(const pmt_t& e0,
     t->_set(4, e4);
     t->_set(5, e5);
     t->_set(6, e6);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0,
@@ -521,7 +611,8 @@ pmt_t make_tuple(const pmt_t& e0,
                  const pmt_t& e6,
                  const pmt_t& e7)
 {
-    pmt_tuple* t = new pmt_tuple(8);
+    pmt_t r = make_pmt<pmt_tuple>(8);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
@@ -530,7 +621,7 @@ pmt_t make_tuple(const pmt_t& e0,
     t->_set(5, e5);
     t->_set(6, e6);
     t->_set(7, e7);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0,
@@ -543,7 +634,8 @@ pmt_t make_tuple(const pmt_t& e0,
                  const pmt_t& e7,
                  const pmt_t& e8)
 {
-    pmt_tuple* t = new pmt_tuple(9);
+    pmt_t r = make_pmt<pmt_tuple>(9);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
@@ -553,7 +645,7 @@ pmt_t make_tuple(const pmt_t& e0,
     t->_set(6, e6);
     t->_set(7, e7);
     t->_set(8, e8);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t make_tuple(const pmt_t& e0,
@@ -567,7 +659,8 @@ pmt_t make_tuple(const pmt_t& e0,
                  const pmt_t& e8,
                  const pmt_t& e9)
 {
-    pmt_tuple* t = new pmt_tuple(10);
+    pmt_t r = make_pmt<pmt_tuple>(10);
+    pmt_tuple* t = _tuple(r);
     t->_set(0, e0);
     t->_set(1, e1);
     t->_set(2, e2);
@@ -578,7 +671,7 @@ pmt_t make_tuple(const pmt_t& e0,
     t->_set(7, e7);
     t->_set(8, e8);
     t->_set(9, e9);
-    return pmt_t(t);
+    return r;
 }
 
 pmt_t to_tuple(const pmt_t& x)
@@ -587,8 +680,8 @@ pmt_t to_tuple(const pmt_t& x)
         return x;
 
     size_t len = length(x);
-    pmt_tuple* t = new pmt_tuple(len);
-    pmt_t r = pmt_t(t);
+    pmt_t r = make_pmt<pmt_tuple>(len);
+    pmt_tuple* t = _tuple(r);
 
     if (x->is_vector()) {
         for (size_t i = 0; i < len; i++)
@@ -636,20 +729,304 @@ void* uniform_vector_writable_elements(pmt_t vector, size_t& len)
     return _uniform_vector(vector)->uniform_writable_elements(len);
 }
 
+pmt_t uniform_vector_slice(pmt_t vector, size_t start, size_t k)
+{
+    if (!vector->is_uniform_vector())
+        throw wrong_type("pmt_uniform_vector_slice", vector);
+    return _uniform_vector(vector)->slice(vector, start, k);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 //                            Dictionaries
 ////////////////////////////////////////////////////////////////////////////
 
 /*
- * This is an a-list implementation.
+ * dcons() builds plain a-list cells. dict_add() builds hashed dicts: a
+ * persistent hash array mapped trie from key to (key . value) pair, 32
+ * ways per level, with every change copying just the path to the
+ * changed slot. That makes add, ref and delete O(log n) while earlier
+ * versions of the dict stay as they were.
  *
- * When we need better performance for large dictionaries, consider implementing
- * persistent Red-Black trees as described in "Purely Functional Data Structures",
- * Chris Okasaki, 1998, section 3.3.
+ * Keys are hashed consistently with eqv(): numbers by value, anything
+ * else (interned symbols in particular) by address. Each pair carries
+ * the stamp of when it was added, so the a-list a hashed dict turns
+ * into when walked has the same order dict_add() always gave it: most
+ * recently added first.
  */
 
-pmt_dict::pmt_dict(const pmt_t& car, const pmt_t& cdr) : pmt_pair::pmt_pair(car, cdr) {}
+struct pmt_dict::node {
+    struct slot {
+        uint64_t hash;
+        pmt_t item;   // (key . value), or null if this slot leads to child
+        uint64_t seq; // when item was added
+        node_ptr child;
+    };
+
+    uint32_t bitmap; // which of the 32 branches are in slots, in order
+    std::vector<slot> slots;
+};
+
+typedef pmt_dict::node dict_node;
+
+static const unsigned DICT_BITS = 5;  // branching of 32 per level
+static const unsigned DICT_LEAF = 64; // hash used up; collisions are listed
+
+static uint64_t dict_hash(const pmt_t& key)
+{
+    uint64_t h;
+    if (key->is_integer())
+        h = static_cast<uint64_t>(_integer(key)->value());
+    else if (key->is_uint64())
+        h = _uint64(key)->value();
+    else if (key->is_real()) {
+        double d = _real(key)->value();
+        h = std::hash<double>()(d == 0.0 ? 0.0 : d); // -0.0 eqv 0.0
+    } else if (key->is_complex()) {
+        std::complex<double> z = _complex(key)->value();
+        h = std::hash<double>()(z.real() == 0.0 ? 0.0 : z.real()) * 31 +
+            std::hash<double>()(z.imag() == 0.0 ? 0.0 : z.imag());
+    } else
+        h = reinterpret_cast<uintptr_t>(key.get());
+
+    // Pointers have their low bits clear and small numbers their high
+    // bits; spread them over all levels of the trie.
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static const pmt_t& dict_key(const dict_node::slot& s)
+{
+    return static_cast<const pmt_pair*>(s.item.get())->d_car;
+}
+
+static bool dict_match(const dict_node::slot& s, uint64_t hash, const pmt_t& key)
+{
+    return s.item && s.hash == hash && eqv(dict_key(s), key);
+}
+
+static unsigned dict_branch(uint64_t hash, unsigned shift)
+{
+    return static_cast<unsigned>(hash >> shift) & ((1u << DICT_BITS) - 1);
+}
+
+static size_t dict_index(uint32_t bitmap, uint32_t bit)
+{
+    return std::bitset<32>(bitmap & (bit - 1)).count();
+}
+
+static const dict_node::slot*
+dict_find(const dict_node* n, uint64_t hash, const pmt_t& key)
+{
+    for (unsigned shift = 0; n; shift += DICT_BITS) {
+        if (shift >= DICT_LEAF) {
+            for (const auto& s : n->slots)
+                if (dict_match(s, hash, key))
+                    return &s;
+            return nullptr;
+        }
+
+        uint32_t bit = 1u << dict_branch(hash, shift);
+        if (!(n->bitmap & bit))
+            return nullptr;
+
+        const dict_node::slot& s = n->slots[dict_index(n->bitmap, bit)];
+        if (s.child)
+            n = s.child.get();
+        else
+            return dict_match(s, hash, key) ? &s : nullptr;
+    }
+    return nullptr;
+}
+
+/*
+ * Return a copy of \p n with \p s added, replacing any pair with the
+ * same key. \p n may be null.
+ */
+static pmt_dict::node_ptr
+dict_insert(const dict_node* n, unsigned shift, const dict_node::slot& s, bool& replaced)
+{
+    std::shared_ptr<dict_node> r(n ? new dict_node(*n) : new dict_node());
+
+    if (shift >= DICT_LEAF) {
+        for (auto& t : r->slots) {
+            if (dict_match(t, s.hash, dict_key(s))) {
+                t = s;
+                replaced = true;
+                return r;
+            }
+        }
+        r->slots.push_back(s);
+        return r;
+    }
+
+    uint32_t bit = 1u << dict_branch(s.hash, shift);
+    size_t i = dict_index(r->bitmap, bit);
+    if (!(r->bitmap & bit)) {
+        r->bitmap |= bit;
+        r->slots.insert(r->slots.begin() + i, s);
+        return r;
+    }
+
+    dict_node::slot& t = r->slots[i];
+    if (t.child) {
+        t.child = dict_insert(t.child.get(), shift + DICT_BITS, s, replaced);
+    } else if (dict_match(t, s.hash, dict_key(s))) {
+        t = s;
+        replaced = true;
+    } else {
+        // Two keys on this branch now; push both down a level.
+        bool dummy = false;
+        pmt_dict::node_ptr sub = dict_insert(nullptr, shift + DICT_BITS, t, dummy);
+        t.child = dict_insert(sub.get(), shift + DICT_BITS, s, dummy);
+        t.item.reset();
+    }
+    return r;
+}
+
+/*
+ * Return a copy of \p n without \p key, null if that leaves it empty,
+ * or \p n itself if \p key isn't there.
+ */
+static pmt_dict::node_ptr dict_erase(const pmt_dict::node_ptr& n,
+                                     unsigned shift,
+                                     uint64_t hash,
+                                     const pmt_t& key,
+                                     bool& found)
+{
+    size_t i;
+    if (shift >= DICT_LEAF) {
+        for (i = 0; i < n->slots.size(); i++)
+            if (dict_match(n->slots[i], hash, key))
+                break;
+        if (i == n->slots.size())
+            return n;
+    } else {
+        uint32_t bit = 1u << dict_branch(hash, shift);
+        if (!(n->bitmap & bit))
+            return n;
+
+        i = dict_index(n->bitmap, bit);
+        const dict_node::slot& t = n->slots[i];
+        if (t.child) {
+            pmt_dict::node_ptr c =
+                dict_erase(t.child, shift + DICT_BITS, hash, key, found);
+            if (!found)
+                return n;
+            if (c) {
+                std::shared_ptr<dict_node> r(new dict_node(*n));
+                if (c->slots.size() == 1 && !c->slots[0].child)
+                    r->slots[i] = c->slots[0]; // pull a lone pair back up
+                else
+                    r->slots[i].child = c;
+                return r;
+            }
+        } else if (!dict_match(t, hash, key)) {
+            return n;
+        }
+    }
+
+    found = true;
+    if (n->slots.size() == 1)
+        return pmt_dict::node_ptr();
+
+    std::shared_ptr<dict_node> r(new dict_node(*n));
+    if (shift < DICT_LEAF)
+        r->bitmap &= ~(1u << dict_branch(hash, shift));
+    r->slots.erase(r->slots.begin() + i);
+    return r;
+}
+
+static void dict_collect(const dict_node* n, std::vector<const dict_node::slot*>& out)
+{
+    for (const auto& s : n->slots) {
+        if (s.child)
+            dict_collect(s.child.get(), out);
+        else
+            out.push_back(&s);
+    }
+}
+
+pmt_dict::pmt_dict(const pmt_t& car, const pmt_t& cdr)
+    : pmt_pair::pmt_pair(car, cdr), d_size(0), d_next_seq(0)
+{
+}
+
+pmt_dict::pmt_dict(const node_ptr& root, size_t size, uint64_t next_seq)
+    : pmt_pair::pmt_pair(PMT_NIL, PMT_NIL),
+      d_root(root),
+      d_size(size),
+      d_next_seq(next_seq)
+{
+}
+
+void pmt_dict::materialize()
+{
+    if (!d_root)
+        return;
+
+    std::call_once(d_materialized, [this]() {
+        std::vector<const node::slot*> items;
+        items.reserve(d_size);
+        dict_collect(d_root.get(), items);
+        std::sort(items.begin(),
+                  items.end(),
+                  [](const node::slot* a, const node::slot* b) {
+                      return a->seq > b->seq;
+                  });
+
+        pmt_t rest = PMT_NIL;
+        for (size_t i = items.size() - 1; i > 0; i--)
+            rest = make_pmt<pmt_dict>(items[i]->item, rest);
+        d_car = items[0]->item;
+        d_cdr = rest;
+    });
+}
+
+void pmt_dict::drop_index()
+{
+    materialize();
+    d_root.reset();
+    d_size = 0;
+}
+
+/*
+ * Hashed copy of a dict, so adding to it doesn't take O(n). Where a
+ * key shows up more than once in an a-list, the first one wins, just
+ * as for assv().
+ */
+static pmt_dict* dict_index_alist(const pmt_t& dict, pmt_t& holder)
+{
+    if (is_null(dict) || _dict(dict)->hashed()) {
+        holder = dict;
+        return is_null(dict) ? nullptr : _dict(dict);
+    }
+
+    std::vector<pmt_t> items;
+    for (pmt_t d = dict; is_pair(d); d = cdr(d)) {
+        if (!is_pair(car(d)))
+            throw wrong_type("pmt_dict_add: malformed dict", dict);
+        items.push_back(car(d));
+    }
+
+    pmt_dict::node_ptr root;
+    size_t size = 0;
+    uint64_t seq = 0;
+    for (auto i = items.rbegin(); i != items.rend(); ++i) {
+        bool replaced = false;
+        dict_node::slot s = { dict_hash(car(*i)), *i, seq++, pmt_dict::node_ptr() };
+        root = dict_insert(root.get(), 0, s, replaced);
+        if (!replaced)
+            size++;
+    }
+
+    holder = make_pmt<pmt_dict>(root, size, seq);
+    return _dict(holder);
+}
 
 bool is_dict(const pmt_t& obj) { return is_null(obj) || obj->is_dict(); }
 
@@ -663,18 +1040,23 @@ pmt_t dcons(const pmt_t& x, const pmt_t& y)
     if (!is_dict(y))
         throw wrong_type("pmt_dcons: not a dict", y);
 
-    return pmt_t(new pmt_dict(x, y));
+    return make_pmt<pmt_dict>(x, y);
 }
 
 pmt_t dict_add(const pmt_t& dict, const pmt_t& key, const pmt_t& value)
 {
-    if (is_null(dict))
-        return acons(key, value, PMT_NIL);
+    if (!is_dict(dict))
+        throw wrong_type("pmt_dict_add: not a dict", dict);
+
+    pmt_t holder;
+    pmt_dict* d = dict_index_alist(dict, holder);
 
-    if (dict_has_key(dict, key))
-        return acons(key, value, dict_delete(dict, key));
+    bool replaced = false;
+    dict_node::slot s = { dict_hash(key), cons(key, value), d ? d->next_seq() : 0 };
+    pmt_dict::node_ptr root = dict_insert(d ? d->root().get() : nullptr, 0, s, replaced);
+    size_t size = d ? d->size() : 0;
 
-    return acons(key, value, dict);
+    return make_pmt<pmt_dict>(root, replaced ? size : size + 1, s.seq + 1);
 }
 
 pmt_t dict_update(const pmt_t& dict1, const pmt_t& dict2)
@@ -694,6 +1076,17 @@ pmt_t dict_delete(const pmt_t& dict, const pmt_t& key)
     if (is_null(dict))
         return dict;
 
+    pmt_dict* d = _dict(dict);
+    if (d && d->hashed()) {
+        bool found = false;
+        pmt_dict::node_ptr root = dict_erase(d->root(), 0, dict_hash(key), key, found);
+        if (!found)
+            return dict;
+        if (!root)
+            return PMT_NIL;
+        return make_pmt<pmt_dict>(root, d->size() - 1, d->next_seq());
+    }
+
     if (eqv(caar(dict), key))
         return cdr(dict);
 
@@ -702,6 +1095,12 @@ pmt_t dict_delete(const pmt_t& dict, const pmt_t& key)
 
 pmt_t dict_ref(const pmt_t& dict, const pmt_t& key, const pmt_t& not_found)
 {
+    pmt_dict* d = _dict(dict);
+    if (d && d->hashed()) {
+        const dict_node::slot* s = dict_find(d->root().get(), dict_hash(key), key);
+        return s ? static_cast<const pmt_pair*>(s->item.get())->d_cdr : not_found;
+    }
+
     pmt_t p = assv(key, dict); // look for (key . value) pair
     if (is_pair(p))
         return cdr(p);
@@ -711,6 +1110,10 @@ pmt_t dict_ref(const pmt_t& dict, const pmt_t& key, const pmt_t& not_found)
 
 bool dict_has_key(const pmt_t& dict, const pmt_t& key)
 {
+    pmt_dict* d = _dict(dict);
+    if (d && d->hashed())
+        return dict_find(d->root().get(), dict_hash(key), key) != nullptr;
+
     return is_pair(assv(key, dict));
 }
 
@@ -719,7 +1122,7 @@ pmt_t dict_items(pmt_t dict)
     if (!is_dict(dict))
         throw wrong_type("pmt_dict_values", dict);
 
-    return dict; // equivalent to dict in the a-list case
+    return dict; // walking it as a list yields the (key . value) pairs
 }
 
 pmt_t dict_keys(pmt_t dict)
@@ -746,7 +1149,7 @@ pmt_any::pmt_any(const boost::any& any) : d_any(any) {}
 
 bool is_any(pmt_t obj) { return obj->is_any(); }
 
-pmt_t make_any(const boost::any& any) { return pmt_t(new pmt_any(any)); }
+pmt_t make_any(const boost::any& any) { return make_pmt<pmt_any>(any); }
 
 boost::any any_ref(pmt_t obj)
 {
@@ -913,6 +1316,9 @@ size_t length(const pmt_t& x)
     if (x->is_null())
         return 0;
 
+    if (x->is_dict() && _dict(x)->hashed())
+        return _dict(x)->size();
+
     // also returns correct result for dictionaries
     if (x->is_pair()) {
         size_t length = 1;
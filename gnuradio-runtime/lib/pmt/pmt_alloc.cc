@@ -0,0 +1,289 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "pmt_alloc.h"
+#include <boost/align/aligned_alloc.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace pmt {
+namespace alloc {
+
+namespace {
+
+/*
+ * Memory comes in chunks of CHUNK_SIZE bytes, aligned to CHUNK_SIZE, each
+ * cut into blocks of one size class. The chunk header says which thread
+ * cache the blocks belong to, so a free can find it from the address.
+ * Chunks are never given back; freed blocks are reused.
+ */
+const size_t CHUNK_SIZE = 64 * 1024;
+const size_t HEADER_SIZE = 64;
+const size_t BATCH_SIZE = 32; // blocks handed back to another thread at once
+const int NPENDING = 8;       // owners a thread collects batches for at once
+
+// 16 byte steps up to 128 bytes, then 64 byte steps up to max_pooled.
+const int NCLASSES = 8 + (max_pooled - 128) / 64;
+
+inline int size_class(size_t nbytes)
+{
+    if (nbytes <= 128)
+        return nbytes ? static_cast<int>((nbytes + 15) / 16 - 1) : 0;
+    return static_cast<int>(8 + (nbytes - 128 + 63) / 64 - 1);
+}
+
+inline size_t class_size(int cls)
+{
+    return cls < 8 ? 16 * (cls + 1) : 128 + 64 * (cls - 7);
+}
+
+struct block {
+    block* next;
+};
+
+struct thread_cache;
+
+struct chunk {
+    thread_cache* owner;
+    int cls;
+};
+
+inline chunk* chunk_of(void* p)
+{
+    return reinterpret_cast<chunk*>(reinterpret_cast<uintptr_t>(p) & ~(CHUNK_SIZE - 1));
+}
+
+// A run of blocks freed by this thread on their way back to their owner.
+struct pending_batch {
+    thread_cache* owner;
+    int cls;
+    block* head;
+    block* tail;
+    size_t n;
+};
+
+struct thread_cache {
+    struct pool {
+        block* free;               // only touched by the owning thread
+        char* bump;                // rest of the newest chunk
+        char* bump_end;
+        std::atomic<block*> remote; // batches other threads handed back
+    };
+
+    pool pools[NCLASSES];
+    pending_batch pending[NPENDING];
+    int next_victim;
+    thread_cache* next_orphan;
+
+    thread_cache() : next_victim(0), next_orphan(nullptr)
+    {
+        for (auto& p : pools) {
+            p.free = nullptr;
+            p.bump = p.bump_end = nullptr;
+            p.remote.store(nullptr, std::memory_order_relaxed);
+        }
+        for (auto& b : pending)
+            b.owner = nullptr;
+    }
+
+    void* allocate(int cls)
+    {
+        pool& p = pools[cls];
+        if (!p.free)
+            p.free = p.remote.exchange(nullptr, std::memory_order_acquire);
+        if (p.free) {
+            block* b = p.free;
+            p.free = b->next;
+            return b;
+        }
+
+        size_t size = class_size(cls);
+        if (p.bump == p.bump_end) {
+            char* c = static_cast<char*>(
+                boost::alignment::aligned_alloc(CHUNK_SIZE, CHUNK_SIZE));
+            if (!c)
+                throw std::bad_alloc();
+            reinterpret_cast<chunk*>(c)->owner = this;
+            reinterpret_cast<chunk*>(c)->cls = cls;
+            p.bump = c + HEADER_SIZE;
+            p.bump_end = p.bump + (CHUNK_SIZE - HEADER_SIZE) / size * size;
+        }
+        void* b = p.bump;
+        p.bump += size;
+        return b;
+    }
+
+    void free_local(block* b, int cls)
+    {
+        b->next = pools[cls].free;
+        pools[cls].free = b;
+    }
+
+    // Hold on to b until there's a batch's worth for its owner.
+    void free_remote(block* b, thread_cache* owner, int cls)
+    {
+        pending_batch* slot = nullptr;
+        for (auto& pb : pending) {
+            if (pb.owner == owner && pb.cls == cls) {
+                slot = &pb;
+                break;
+            }
+            if (!pb.owner && !slot)
+                slot = &pb;
+        }
+        if (!slot) {
+            slot = &pending[next_victim];
+            next_victim = (next_victim + 1) % NPENDING;
+            flush(*slot);
+        }
+        if (!slot->owner) {
+            slot->owner = owner;
+            slot->cls = cls;
+            slot->head = slot->tail = nullptr;
+            slot->n = 0;
+        }
+
+        b->next = slot->head;
+        slot->head = b;
+        if (!slot->tail)
+            slot->tail = b;
+        if (++slot->n == BATCH_SIZE)
+            flush(*slot);
+    }
+
+    void flush(pending_batch& pb)
+    {
+        if (pb.owner)
+            pb.owner->give_back(pb.cls, pb.head, pb.tail);
+        pb.owner = nullptr;
+    }
+
+    void flush_all()
+    {
+        for (auto& pb : pending)
+            flush(pb);
+    }
+
+    // Called by other threads.
+    void give_back(int cls, block* head, block* tail)
+    {
+        std::atomic<block*>& r = pools[cls].remote;
+        block* old = r.load(std::memory_order_relaxed);
+        do {
+            tail->next = old;
+        } while (!r.compare_exchange_weak(
+            old, head, std::memory_order_release, std::memory_order_relaxed));
+    }
+};
+
+/*
+ * Caches outlive their threads, since what a thread allocated may be
+ * freed long after it's gone. A finished thread's cache goes on the
+ * orphan list for the next new thread to take over. None of this is
+ * ever destroyed, so pmts freed during static destruction still have
+ * somewhere to go.
+ */
+std::mutex& orphan_mutex()
+{
+    static std::mutex* m = new std::mutex;
+    return *m;
+}
+thread_cache* s_orphans = nullptr;
+
+// For threads whose cache has already been released at exit.
+thread_cache& fallback_cache()
+{
+    static thread_cache* c = new thread_cache;
+    return *c;
+}
+std::mutex& fallback_mutex()
+{
+    static std::mutex* m = new std::mutex;
+    return *m;
+}
+
+thread_local thread_cache* t_cache = nullptr;
+thread_local bool t_exited = false;
+
+struct cache_release {
+    bool active = false;
+
+    ~cache_release()
+    {
+        if (!t_cache)
+            return;
+        t_cache->flush_all();
+        std::lock_guard<std::mutex> guard(orphan_mutex());
+        t_cache->next_orphan = s_orphans;
+        s_orphans = t_cache;
+        t_cache = nullptr;
+        t_exited = true;
+    }
+};
+thread_local cache_release t_release;
+
+thread_cache* this_cache()
+{
+    if (t_cache || t_exited)
+        return t_cache;
+
+    t_release.active = true; // registers the destructor for this thread
+    std::lock_guard<std::mutex> guard(orphan_mutex());
+    if (s_orphans) {
+        t_cache = s_orphans;
+        s_orphans = t_cache->next_orphan;
+    } else {
+        t_cache = new thread_cache;
+    }
+    return t_cache;
+}
+
+} // namespace
+
+void* allocate(size_t nbytes)
+{
+    if (nbytes > max_pooled)
+        return ::operator new(nbytes);
+
+    thread_cache* tc = this_cache();
+    if (!tc) {
+        std::lock_guard<std::mutex> guard(fallback_mutex());
+        return fallback_cache().allocate(size_class(nbytes));
+    }
+    return tc->allocate(size_class(nbytes));
+}
+
+void deallocate(void* p, size_t nbytes)
+{
+    if (!p)
+        return;
+    if (nbytes > max_pooled) {
+        ::operator delete(p);
+        return;
+    }
+
+    chunk* c = chunk_of(p);
+    block* b = static_cast<block*>(p);
+    thread_cache* tc = this_cache();
+    if (c->owner == tc)
+        tc->free_local(b, c->cls);
+    else if (tc)
+        tc->free_remote(b, c->owner, c->cls);
+    else
+        c->owner->give_back(c->cls, b, b);
+}
+
+} /* namespace alloc */
+} /* namespace pmt */
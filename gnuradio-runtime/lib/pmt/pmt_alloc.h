@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#ifndef INCLUDED_PMT_ALLOC_H
+#define INCLUDED_PMT_ALLOC_H
+
+#include <pmt/api.h>
+#include <cstddef>
+#include <new>
+
+/*
+ * EVERYTHING IN THIS FILE IS PRIVATE TO THE IMPLEMENTATION!
+ */
+
+namespace pmt {
+
+/*
+ * Small-object allocator for pmts.
+ *
+ * Each thread allocates from its own free lists, one per size class,
+ * without taking a lock. Memory freed by another thread is handed back
+ * to its owner in batches. Requests bigger than the largest size class
+ * go to operator new.
+ */
+namespace alloc {
+
+PMT_API void* allocate(size_t nbytes);
+PMT_API void deallocate(void* p, size_t nbytes);
+
+//! Largest request served from the pools.
+const size_t max_pooled = 1024;
+
+} /* namespace alloc */
+
+/*!
+ * \brief std allocator on top of pmt::alloc, for allocate_shared and
+ * the element storage of uniform vectors.
+ */
+template <typename T>
+class pool_allocator
+{
+public:
+    typedef T value_type;
+
+    pool_allocator() noexcept {}
+    template <typename U>
+    pool_allocator(const pool_allocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n) { return static_cast<T*>(alloc::allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) noexcept { alloc::deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&)
+{
+    return false;
+}
+
+} /* namespace pmt */
+
+#endif /* INCLUDED_PMT_ALLOC_H */
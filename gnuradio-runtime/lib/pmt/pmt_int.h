@@ -10,10 +10,16 @@
 #ifndef INCLUDED_PMT_INT_H
 #define INCLUDED_PMT_INT_H
 
+#include "pmt_alloc.h"
 #include <pmt/pmt.h>
 #include <boost/atomic.hpp>
 #include <boost/utility.hpp>
 #include <boost/version.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 /*
  * EVERYTHING IN THIS FILE IS PRIVATE TO THE IMPLEMENTATION!
@@ -23,6 +29,15 @@
 
 namespace pmt {
 
+/*
+ * Allocate a T and its reference count in one go from the thread's
+ * pmt pools.
+ */
+template <typename T, typename... Args>
+inline pmt_t make_pmt(Args&&... args)
+{
+    return std::allocate_shared<T>(pool_allocator<T>(), std::forward<Args>(args)...);
+}
 
 class pmt_bool : public pmt_base
 {
@@ -36,18 +51,14 @@ public:
 
 class pmt_symbol : public pmt_base
 {
-    std::string d_name;
-    pmt_t d_next;
+    const std::string d_name;
 
 public:
     pmt_symbol(const std::string& name);
     //~pmt_symbol(){}
 
     bool is_symbol() const override { return true; }
-    const std::string name() { return d_name; }
-
-    pmt_t next() { return d_next; } // symbol table link
-    void set_next(pmt_t next) { d_next = next; }
+    const std::string& name() const { return d_name; }
 };
 
 class pmt_integer : public pmt_base
@@ -128,13 +139,39 @@ public:
     void set_cdr(pmt_t cdr) { d_cdr = cdr; }
 };
 
+/*
+ * A dict is either a plain a-list cell, as built by dcons(), or the
+ * head of a hashed dict, as built by dict_add(). The latter keeps its
+ * (key . value) pairs in a persistent hash trie and only fills in its
+ * car and cdr when first walked as a list.
+ */
 class pmt_dict : public pmt_pair
 {
 public:
+    struct node;
+    typedef std::shared_ptr<const node> node_ptr;
+
     pmt_dict(const pmt_t& car, const pmt_t& cdr);
+    pmt_dict(const node_ptr& root, size_t size, uint64_t next_seq);
     //~pmt_dict(){};
 
     bool is_dict() const override { return true; }
+
+    bool hashed() const { return d_root != nullptr; }
+    const node_ptr& root() const { return d_root; }
+    size_t size() const { return d_size; }
+    uint64_t next_seq() const { return d_next_seq; }
+
+    //! Fill in car and cdr from the trie, once. Safe to call from any thread.
+    void materialize();
+    //! Turn into a plain a-list cell, before car or cdr get changed.
+    void drop_index();
+
+private:
+    node_ptr d_root; // null for a-list cells
+    size_t d_size;
+    uint64_t d_next_seq; // insertion stamp for the next pair; orders the list
+    std::once_flag d_materialized;
 };
 
 class pmt_vector : public pmt_base
@@ -190,6 +227,8 @@ public:
     bool is_uniform_vector() const override { return true; }
     virtual const void* uniform_elements(size_t& len) = 0;
     virtual void* uniform_writable_elements(size_t& len) = 0;
+    //! Elements [start, start + k) sharing this vector's storage; self owns this.
+    virtual pmt_t slice(const pmt_t& self, size_t start, size_t k) const = 0;
     virtual size_t length() const = 0;
     virtual size_t itemsize() const = 0;
     virtual const std::string string_ref(size_t k) const
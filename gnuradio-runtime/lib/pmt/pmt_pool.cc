@@ -12,9 +12,11 @@
 #include <config.h>
 #endif
 
+#include "pmt_alloc.h"
 #include <pmt/pmt_pool.h>
 #include <algorithm>
 #include <cstdint>
+#include <new>
 
 namespace pmt {
 
@@ -99,4 +101,104 @@ void pmt_pool::free(void* foo)
         d_cond.notify_one();
 }
 
+static const std::align_val_t SLAB_ALIGN = std::align_val_t(64);
+
+// Shared with the buffers handed out, which may outlive the pool.
+struct slab_pool::state {
+    typedef boost::unique_lock<boost::mutex> scoped_lock;
+    boost::mutex mutex;
+    boost::condition_variable cond;
+
+    const size_t slab_size;
+    const size_t max_slabs;
+    const size_t max_idle;
+    size_t nout;
+    std::vector<uint8_t*> idle;
+
+    state(size_t slab_size, size_t max_slabs, size_t max_idle)
+        : slab_size(slab_size), max_slabs(max_slabs), max_idle(max_idle), nout(0)
+    {
+        idle.reserve(max_idle);
+    }
+
+    ~state()
+    {
+        for (uint8_t* p : idle)
+            release(p);
+    }
+
+    static uint8_t* allocate(size_t n)
+    {
+        return static_cast<uint8_t*>(::operator new(n, SLAB_ALIGN));
+    }
+
+    static void release(uint8_t* p) { ::operator delete(p, SLAB_ALIGN); }
+
+    uint8_t* get()
+    {
+        scoped_lock guard(mutex);
+        if (max_slabs != 0) {
+            while (nout >= max_slabs)
+                cond.wait(guard);
+        }
+        nout++;
+        if (!idle.empty()) {
+            uint8_t* p = idle.back();
+            idle.pop_back();
+            return p;
+        }
+        guard.unlock();
+        try {
+            return allocate(slab_size);
+        } catch (...) {
+            guard.lock();
+            nout--;
+            throw;
+        }
+    }
+
+    void put(uint8_t* p)
+    {
+        scoped_lock guard(mutex);
+        nout--;
+        if (max_slabs != 0)
+            cond.notify_one();
+        if (idle.size() < max_idle) {
+            idle.push_back(p);
+            return;
+        }
+        guard.unlock();
+        release(p);
+    }
+};
+
+slab_pool::slab_pool(size_t slab_size, size_t max_slabs, size_t max_idle)
+    : d_state(std::make_shared<state>(slab_size, max_slabs, max_idle)),
+      d_slab_size(slab_size)
+{
+}
+
+std::shared_ptr<uint8_t> slab_pool::get()
+{
+    std::shared_ptr<state> st = d_state;
+    return std::shared_ptr<uint8_t>(
+        st->get(), [st](uint8_t* p) { st->put(p); }, pool_allocator<uint8_t>());
+}
+
+pmt_t slab_pool::make_u8vector(size_t n, std::shared_ptr<uint8_t>& buf)
+{
+    if (2 * n < d_slab_size)
+        return init_u8vector(n, buf.get());
+
+    pmt_t v = make_u8vector_view(n, buf);
+    buf = get();
+    return v;
+}
+
+size_t slab_pool::nidle() const
+{
+    state::scoped_lock guard(d_state->mutex);
+    return d_state->idle.size();
+}
+
 } /* namespace pmt */
@@ -16,6 +16,7 @@
 #include "pmt_int.h"
 #include <pmt/pmt.h>
 #include <boost/endian/conversion.hpp>
+#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -23,88 +24,503 @@ namespace pmt {
 
 static pmt_t parse_pair(std::streambuf& sb, uint8_t type);
 
-// ----------------------------------------------------------------
-// output primitives
-// ----------------------------------------------------------------
+// Version byte written after PST_FRAME
+static const uint8_t FRAME_VERSION = 1;
 
-static bool serialize_untagged_u8(uint8_t i, std::streambuf& sb)
+// Copies nwords words of type T between big-endian and native byte order,
+// going through memcpy so neither side needs to be aligned.
+template <typename T>
+static void copy_swapped(void* out, const void* in, size_t nwords)
 {
-    return sb.sputc((i >> 0) & 0xff) != std::streambuf::traits_type::eof();
+    if (boost::endian::order::native == boost::endian::order::big) {
+        memcpy(out, in, nwords * sizeof(T));
+        return;
+    }
+    for (size_t i = 0; i < nwords; i++) {
+        T x;
+        memcpy(&x, static_cast<const char*>(in) + i * sizeof(T), sizeof(T));
+        boost::endian::endian_reverse_inplace(x);
+        memcpy(static_cast<char*>(out) + i * sizeof(T), &x, sizeof(T));
+    }
 }
 
-// always writes big-endian
-static bool serialize_untagged_u16(uint16_t i, std::streambuf& sb)
+static void copy_swapped(void* out, const void* in, size_t nbytes, size_t wordsize)
 {
-    boost::endian::native_to_big_inplace(i);
-    return sb.sputn((char*)&i, sizeof(i)) != std::streambuf::traits_type::eof();
+    switch (wordsize) {
+    case 2:
+        copy_swapped<uint16_t>(out, in, nbytes / 2);
+        break;
+    case 4:
+        copy_swapped<uint32_t>(out, in, nbytes / 4);
+        break;
+    case 8:
+        copy_swapped<uint64_t>(out, in, nbytes / 8);
+        break;
+    default:
+        memcpy(out, in, nbytes);
+    }
 }
 
-// always writes big-endian
-static bool serialize_untagged_u32(uint32_t i, std::streambuf& sb)
+/*
+ * Uniform vector subtypes, with the size of the words their elements are
+ * byte-swapped in. c32 elements are swapped as one 64 bit word, so real
+ * and imag trade places on the wire; c64 as two 64 bit words.
+ */
+static bool uniform_vector_subtype(uint8_t utag, size_t& itemsize, size_t& wordsize)
 {
-    boost::endian::native_to_big_inplace(i);
-    return sb.sputn((char*)&i, sizeof(i)) != std::streambuf::traits_type::eof();
+    switch (utag) {
+    case UVI_U8:
+    case UVI_S8:
+        itemsize = wordsize = 1;
+        return true;
+    case UVI_U16:
+    case UVI_S16:
+        itemsize = wordsize = 2;
+        return true;
+    case UVI_U32:
+    case UVI_S32:
+    case UVI_F32:
+        itemsize = wordsize = 4;
+        return true;
+    case UVI_U64:
+    case UVI_S64:
+    case UVI_F64:
+    case UVI_C32:
+        itemsize = wordsize = 8;
+        return true;
+    case UVI_C64:
+        itemsize = 16;
+        wordsize = 8;
+        return true;
+    default:
+        return false;
+    }
 }
 
-static bool serialize_untagged_f64(double i, std::streambuf& sb)
+static uint8_t uniform_vector_subtype(pmt_t obj)
 {
-    typedef union {
-        double id;
-        uint64_t ii;
-    } iu_t;
-    iu_t iu;
-    iu.id = i;
-    boost::endian::native_to_big_inplace(iu.ii);
-    return sb.sputn((char*)&iu.ii, sizeof(iu.ii)) != std::streambuf::traits_type::eof();
+    if (is_u8vector(obj))
+        return UVI_U8;
+    if (is_s8vector(obj))
+        return UVI_S8;
+    if (is_u16vector(obj))
+        return UVI_U16;
+    if (is_s16vector(obj))
+        return UVI_S16;
+    if (is_u32vector(obj))
+        return UVI_U32;
+    if (is_s32vector(obj))
+        return UVI_S32;
+    if (is_u64vector(obj))
+        return UVI_U64;
+    if (is_s64vector(obj))
+        return UVI_S64;
+    if (is_f32vector(obj))
+        return UVI_F32;
+    if (is_f64vector(obj))
+        return UVI_F64;
+    if (is_c32vector(obj))
+        return UVI_C32;
+    return UVI_C64;
 }
 
-// always writes big-endian
-static bool serialize_untagged_u64(uint64_t i, std::streambuf& sb)
+// ----------------------------------------------------------------
+// encoder
+// ----------------------------------------------------------------
+
+namespace {
+
+/*
+ * Appends the byte-serial representation to a string. Fields go
+ * straight into memory, big-endian; nothing goes through a streambuf.
+ */
+class encoder
 {
-    boost::endian::native_to_big_inplace(i);
-    return sb.sputn((char*)&i, sizeof(i)) != std::streambuf::traits_type::eof();
-}
+    std::string& d_buf;
+
+public:
+    explicit encoder(std::string& buf) : d_buf(buf) {}
+
+    void put_u8(uint8_t x) { d_buf.push_back(static_cast<char>(x)); }
+
+    template <typename T>
+    void put_be(T x)
+    {
+        boost::endian::native_to_big_inplace(x);
+        d_buf.append(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+
+    void put_f64(double x)
+    {
+        uint64_t i;
+        memcpy(&i, &x, sizeof(i));
+        put_be(i);
+    }
+
+    void put_bytes(const void* data, size_t len)
+    {
+        d_buf.append(static_cast<const char*>(data), len);
+    }
+
+    void put_swapped(const void* data, size_t nbytes, size_t wordsize)
+    {
+        size_t pos = d_buf.size();
+        d_buf.resize(pos + nbytes);
+        if (nbytes)
+            copy_swapped(&d_buf[pos], data, nbytes, wordsize);
+    }
 
-// always writes big-endian
-static bool
-serialize_untagged_u8_array(const uint8_t* data, size_t length, std::streambuf& sb)
+    void encode(pmt_t obj);
+};
+
+/*
+ * N.B., Circular structures cause infinite recursion.
+ */
+void encoder::encode(pmt_t obj)
 {
-    return sb.sputn((char*)data, length) != std::streambuf::traits_type::eof();
+tail_recursion:
+
+    if (is_bool(obj)) {
+        put_u8(eq(obj, PMT_T) ? PST_TRUE : PST_FALSE);
+        return;
+    }
+
+    if (is_null(obj)) {
+        put_u8(PST_NULL);
+        return;
+    }
+
+    if (is_symbol(obj)) {
+        const std::string& s = symbol_to_string(obj);
+        put_u8(PST_SYMBOL);
+        put_be<uint16_t>(s.size());
+        put_bytes(s.data(), s.size());
+        return;
+    }
+
+    if (is_pair(obj)) {
+        put_u8(is_dict(obj) ? PST_DICT : PST_PAIR);
+        encode(car(obj));
+        obj = cdr(obj);
+        goto tail_recursion;
+    }
+
+    if (is_number(obj)) {
+        if (is_uint64(obj)) {
+            put_u8(PST_UINT64);
+            put_be<uint64_t>(to_uint64(obj));
+            return;
+        }
+
+        if (is_integer(obj)) {
+            long i = to_long(obj);
+            if ((sizeof(long) > 4) && ((i < std::numeric_limits<std::int32_t>::min() ||
+                                        i > std::numeric_limits<std::int32_t>::max()))) {
+                // Serializing as 4 bytes won't work for this value, serialize as 8 bytes
+                put_u8(PST_INT64);
+                put_be<uint64_t>(i);
+            } else {
+                put_u8(PST_INT32);
+                put_be<uint32_t>(i);
+            }
+            return;
+        }
+
+        if (is_real(obj)) {
+            put_u8(PST_DOUBLE);
+            put_f64(to_double(obj));
+            return;
+        }
+
+        if (is_complex(obj)) {
+            std::complex<double> i = to_complex(obj);
+            put_u8(PST_COMPLEX);
+            put_f64(i.real());
+            put_f64(i.imag());
+            return;
+        }
+    }
+
+    if (is_vector(obj)) {
+        size_t vec_len = pmt::length(obj);
+        put_u8(PST_VECTOR);
+        put_be<uint32_t>(vec_len);
+        for (size_t i = 0; i < vec_len; i++)
+            encode(vector_ref(obj, i));
+        return;
+    }
+
+    if (is_uniform_vector(obj)) {
+        uint8_t utag = uniform_vector_subtype(obj);
+        size_t itemsize, wordsize, nbytes;
+        uniform_vector_subtype(utag, itemsize, wordsize);
+        const void* data = uniform_vector_elements(obj, nbytes);
+
+        put_u8(PST_UNIFORM_VECTOR);
+        put_u8(utag);
+        put_be<uint32_t>(nbytes / itemsize);
+        put_u8(1); // npad
+        put_u8(0);
+        put_swapped(data, nbytes, wordsize);
+        return;
+    }
+
+    if (is_dict(obj))
+        throw notimplemented("pmt::serialize (dict)", obj);
+
+    if (is_tuple(obj)) {
+        size_t tuple_len = pmt::length(obj);
+        put_u8(PST_TUPLE);
+        put_be<uint32_t>(tuple_len);
+        for (size_t i = 0; i < tuple_len; i++)
+            encode(tuple_ref(obj, i));
+        return;
+    }
+
+    throw notimplemented("pmt::serialize (?)", obj);
 }
 
-static bool
-serialize_untagged_u16_array(const uint16_t* data, size_t length, std::streambuf& sb)
+// ----------------------------------------------------------------
+// decoder
+// ----------------------------------------------------------------
+
+/*
+ * Reads the byte-serial representation out of memory. If an owner of
+ * that memory is given, u8vectors are made to refer to it rather than
+ * copying out of it.
+ */
+class decoder
+{
+    const uint8_t* d_start;
+    const uint8_t* d_p;
+    const uint8_t* d_end;
+    const std::shared_ptr<uint8_t>* d_owner;
+
+    pmt_t decode_pair(uint8_t type);
+    pmt_t decode_uniform_vector();
+
+public:
+    decoder(const void* data, size_t len, const std::shared_ptr<uint8_t>* owner)
+        : d_start(static_cast<const uint8_t*>(data)),
+          d_p(d_start),
+          d_end(d_start + len),
+          d_owner(owner)
+    {
+    }
+
+    bool at_end() const { return d_p == d_end; }
+    size_t used() const { return d_p - d_start; }
+
+    // Throw unless there are at least n more bytes.
+    void need(size_t n) const
+    {
+        if (n > size_t(d_end - d_p))
+            throw exception("pmt::deserialize: malformed input stream", PMT_F);
+    }
+
+    const uint8_t* take(size_t n)
+    {
+        need(n);
+        const uint8_t* p = d_p;
+        d_p += n;
+        return p;
+    }
+
+    uint8_t get_u8() { return *take(1); }
+
+    template <typename T>
+    T get_be()
+    {
+        T x;
+        memcpy(&x, take(sizeof(T)), sizeof(T));
+        return boost::endian::big_to_native(x);
+    }
+
+    double get_f64()
+    {
+        uint64_t i = get_be<uint64_t>();
+        double x;
+        memcpy(&x, &i, sizeof(x));
+        return x;
+    }
+
+    pmt_t decode();
+};
+
+pmt_t decoder::decode()
 {
-    std::vector<uint16_t> bedata(length);
-    for (size_t i = 0; i < length; i++) {
-        bedata[i] = boost::endian::native_to_big(data[i]);
+    uint8_t tag = get_u8();
+
+    switch (tag) {
+    case PST_TRUE:
+        return PMT_T;
+
+    case PST_FALSE:
+        return PMT_F;
+
+    case PST_NULL:
+        return PMT_NIL;
+
+    case PST_SYMBOL: {
+        uint16_t len = get_be<uint16_t>();
+        const char* s = reinterpret_cast<const char*>(take(len));
+        return intern(std::string(s, len));
+    }
+
+    case PST_INT32:
+        return from_long((int32_t)get_be<uint32_t>());
+
+    case PST_UINT64:
+        return from_uint64(get_be<uint64_t>());
+
+    case PST_INT64:
+        return from_long(get_be<uint64_t>());
+
+    case PST_PAIR:
+    case PST_DICT:
+        return decode_pair(tag);
+
+    case PST_DOUBLE:
+        return from_double(get_f64());
+
+    case PST_COMPLEX: {
+        double r = get_f64();
+        double i = get_f64();
+        return make_rectangular(r, i);
+    }
+
+    case PST_TUPLE:
+    case PST_VECTOR: {
+        uint32_t nitems = get_be<uint32_t>();
+        need(nitems); // at least a byte each, before allocating for them
+        pmt_t vec = make_vector(nitems, PMT_NIL);
+        for (uint32_t i = 0; i < nitems; i++)
+            vector_set(vec, i, decode());
+        return tag == PST_TUPLE ? to_tuple(vec) : vec;
+    }
+
+    case PST_UNIFORM_VECTOR:
+        return decode_uniform_vector();
+
+    case PST_FRAME: {
+        uint8_t version = get_u8();
+        uint32_t len = get_be<uint32_t>();
+        if (version != FRAME_VERSION)
+            throw notimplemented("pmt::deserialize: frame version = ",
+                                 from_long(version));
+        decoder body(take(len), len, d_owner);
+        pmt_t obj = body.decode();
+        if (!body.at_end())
+            throw exception("pmt::deserialize: malformed input stream", PMT_F);
+        return obj;
+    }
+
+    case PST_COMMENT:
+        throw notimplemented("pmt::deserialize: tag value = ", from_long(tag));
+
+    default:
+        throw exception("pmt::deserialize: malformed input stream, tag value = ",
+                        from_long(tag));
     }
-    return sb.sputn((char*)&bedata[0], length * sizeof(uint16_t)) !=
-           std::streambuf::traits_type::eof();
 }
 
-static bool
-serialize_untagged_u32_array(const uint32_t* data, size_t length, std::streambuf& sb)
+// Like parse_pair, iterative along the cdrs so long lists don't
+// exhaust the stack. The PST_PAIR or PST_DICT tag has been read.
+pmt_t decoder::decode_pair(uint8_t type)
 {
-    std::vector<uint32_t> bedata(length);
-    for (size_t i = 0; i < length; i++) {
-        bedata[i] = boost::endian::native_to_big(data[i]);
+    pmt_t val, expr, lastnptr = PMT_NIL;
+
+    while (1) {
+        expr = decode(); // the car
+        pmt_t nptr = type == PST_DICT ? dcons(expr, PMT_NIL) : cons(expr, PMT_NIL);
+        if (is_null(lastnptr))
+            val = nptr;
+        else
+            set_cdr(lastnptr, nptr);
+        lastnptr = nptr;
+
+        uint8_t tag = get_u8(); // tag of the cdr
+        if (tag == PST_PAIR)
+            continue;
+        if (tag == PST_NULL) {
+            expr = PMT_NIL;
+            break;
+        }
+        d_p--;
+        expr = decode();
+        break;
     }
-    return sb.sputn((char*)&bedata[0], length * sizeof(uint32_t)) !=
-           std::streambuf::traits_type::eof();
+
+    set_cdr(lastnptr, expr);
+    return val;
 }
 
-static bool
-serialize_untagged_u64_array(const uint64_t* data, size_t length, std::streambuf& sb)
+pmt_t decoder::decode_uniform_vector()
 {
-    std::vector<uint64_t> bedata(length);
-    for (size_t i = 0; i < length; i++) {
-        bedata[i] = boost::endian::native_to_big(data[i]);
+    uint8_t utag = get_u8();
+    uint32_t nitems = get_be<uint32_t>();
+    uint8_t npad = get_u8();
+    take(npad);
+
+    size_t itemsize, wordsize;
+    if (!uniform_vector_subtype(utag, itemsize, wordsize))
+        throw exception("pmt::deserialize: malformed input stream, tag value = ",
+                        from_long(utag));
+    if (nitems > std::numeric_limits<size_t>::max() / itemsize)
+        throw exception("pmt::deserialize: malformed input stream", PMT_F);
+    const uint8_t* data = take(nitems * itemsize);
+
+    pmt_t vec;
+    switch (utag) {
+    case UVI_U8:
+        if (d_owner) {
+            uint8_t* p = const_cast<uint8_t*>(data);
+            return make_u8vector_view(nitems, std::shared_ptr<uint8_t>(*d_owner, p));
+        }
+        return init_u8vector(nitems, data);
+    case UVI_S8:
+        return init_s8vector(nitems, reinterpret_cast<const int8_t*>(data));
+    case UVI_U16:
+        vec = make_u16vector(nitems, 0);
+        break;
+    case UVI_S16:
+        vec = make_s16vector(nitems, 0);
+        break;
+    case UVI_U32:
+        vec = make_u32vector(nitems, 0);
+        break;
+    case UVI_S32:
+        vec = make_s32vector(nitems, 0);
+        break;
+    case UVI_U64:
+        vec = make_u64vector(nitems, 0);
+        break;
+    case UVI_S64:
+        vec = make_s64vector(nitems, 0);
+        break;
+    case UVI_F32:
+        vec = make_f32vector(nitems, 0);
+        break;
+    case UVI_F64:
+        vec = make_f64vector(nitems, 0);
+        break;
+    case UVI_C32:
+        vec = make_c32vector(nitems, 0);
+        break;
+    default:
+        vec = make_c64vector(nitems, 0);
+        break;
     }
-    return sb.sputn((char*)&bedata[0], length * sizeof(uint64_t)) !=
-           std::streambuf::traits_type::eof();
+
+    size_t nbytes;
+    void* out = uniform_vector_writable_elements(vec, nbytes);
+    if (nbytes)
+        copy_swapped(out, data, nbytes, wordsize);
+    return vec;
 }
 
+} /* namespace */
+
 // ----------------------------------------------------------------
 // input primitives
 // ----------------------------------------------------------------
@@ -255,265 +671,36 @@ static bool deserialize_untagged_u64_vector(std::vector<uint64_t>& data,
  */
 bool serialize(pmt_t obj, std::streambuf& sb)
 {
-    bool ok = true;
-
-tail_recursion:
-
-    if (is_bool(obj)) {
-        if (eq(obj, PMT_T))
-            return serialize_untagged_u8(PST_TRUE, sb);
-        else
-            return serialize_untagged_u8(PST_FALSE, sb);
-    }
-
-    if (is_null(obj))
-        return serialize_untagged_u8(PST_NULL, sb);
-
-    if (is_symbol(obj)) {
-        const std::string s = symbol_to_string(obj);
-        size_t len = s.size();
-        ok = serialize_untagged_u8(PST_SYMBOL, sb);
-        ok &= serialize_untagged_u16(len, sb);
-        ok &= serialize_untagged_u8_array((const uint8_t*)s.c_str(), len, sb);
-        return ok;
-    }
-
-    if (is_pair(obj)) {
-        ok = serialize_untagged_u8(is_dict(obj) ? PST_DICT : PST_PAIR, sb);
-        ok &= serialize(car(obj), sb);
-        if (!ok)
-            return false;
-        obj = cdr(obj);
-        goto tail_recursion;
-    }
-
-    if (is_number(obj)) {
-
-        if (is_uint64(obj)) {
-            uint64_t i = to_uint64(obj);
-            ok = serialize_untagged_u8(PST_UINT64, sb);
-            ok &= serialize_untagged_u64(i, sb);
-            return ok;
-        } else {
-            if (is_integer(obj)) {
-                long i = to_long(obj);
-                if ((sizeof(long) > 4) &&
-                    ((i < std::numeric_limits<std::int32_t>::min() ||
-                      i > std::numeric_limits<std::int32_t>::max()))) {
-                    // Serializing as 4 bytes won't work for this value, serialize as 8
-                    // bytes
-                    ok = serialize_untagged_u8(PST_INT64, sb);
-                    ok &= serialize_untagged_u64(i, sb);
-                } else {
-                    ok = serialize_untagged_u8(PST_INT32, sb);
-                    ok &= serialize_untagged_u32(i, sb);
-                }
-                return ok;
-            }
-        }
-
-        if (is_real(obj)) {
-            double i = to_double(obj);
-            ok = serialize_untagged_u8(PST_DOUBLE, sb);
-            ok &= serialize_untagged_f64(i, sb);
-            return ok;
-        }
-
-        if (is_complex(obj)) {
-            std::complex<double> i = to_complex(obj);
-            ok = serialize_untagged_u8(PST_COMPLEX, sb);
-            ok &= serialize_untagged_f64(i.real(), sb);
-            ok &= serialize_untagged_f64(i.imag(), sb);
-            return ok;
-        }
-    }
-
-    if (is_vector(obj)) {
-        size_t vec_len = pmt::length(obj);
-        ok = serialize_untagged_u8(PST_VECTOR, sb);
-        ok &= serialize_untagged_u32(vec_len, sb);
-        for (size_t i = 0; i < vec_len; i++) {
-            ok &= serialize(vector_ref(obj, i), sb);
-        }
-        return ok;
-    }
-
-    if (is_uniform_vector(obj)) {
-        size_t npad = 1;
-        size_t vec_len = pmt::length(obj);
-
-        if (is_u8vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_U8, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u8_array(&u8vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_s8vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_S8, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u8_array(
-                (uint8_t*)&s8vector_elements(obj)[0], vec_len, sb);
-
-            return ok;
-        }
-
-        if (is_u16vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_U16, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u16_array(&u16vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_s16vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_S16, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u16_array(
-                (uint16_t*)&s16vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_u32vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_U32, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u32_array(&u32vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_s32vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_S32, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u32_array(
-                (uint32_t*)&s32vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_u64vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_U64, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u64_array(&u64vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_s64vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_S64, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u64_array(
-                (uint64_t*)&s64vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_f32vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_F32, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u32_array(
-                (uint32_t*)&f32vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_f64vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_F64, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            ok &= serialize_untagged_u64_array(
-                (uint64_t*)&f64vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_c32vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_C32, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            // Note that if endianness causes byte swap that real/imag will also be
-            // swapped
-            ok &= serialize_untagged_u64_array(
-                (uint64_t*)&c32vector_elements(obj)[0], vec_len, sb);
-            return ok;
-        }
-
-        if (is_c64vector(obj)) {
-            ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-            ok &= serialize_untagged_u8(UVI_C64, sb);
-            ok &= serialize_untagged_u32(vec_len, sb);
-            ok &= serialize_untagged_u8(npad, sb);
-            for (size_t i = 0; i < npad; i++) {
-                ok &= serialize_untagged_u8(0, sb);
-            }
-            // No known portable 128 bit swap function, so double the length
-            ok &= serialize_untagged_u64_array(
-                (uint64_t*)&c64vector_elements(obj)[0], vec_len * 2, sb);
-            return ok;
-        }
-    }
+    // Encode into memory and hand it to sb in one go. The scratch buffer
+    // is kept so its capacity is reused.
+    static thread_local std::string buf;
+    buf.clear();
+    serialize_append(obj, buf);
+    return sb.sputn(buf.data(), buf.size()) == std::streamsize(buf.size());
+}
 
-    if (is_dict(obj))
-        throw notimplemented("pmt::serialize (dict)", obj);
+void serialize_append(pmt_t obj, std::string& buf)
+{
+    encoder e(buf);
+    e.encode(obj);
+}
 
-    if (is_tuple(obj)) {
-        size_t tuple_len = pmt::length(obj);
-        ok = serialize_untagged_u8(PST_TUPLE, sb);
-        ok &= serialize_untagged_u32(tuple_len, sb);
-        for (size_t i = 0; i < tuple_len; i++) {
-            ok &= serialize(tuple_ref(obj, i), sb);
-        }
-        return ok;
+void serialize_frame(pmt_t obj, std::string& buf)
+{
+    size_t start = buf.size();
+    encoder e(buf);
+    e.put_u8(PST_FRAME);
+    e.put_u8(FRAME_VERSION);
+    e.put_be<uint32_t>(0); // length, filled in below
+    e.encode(obj);
+
+    size_t len = buf.size() - start - 6;
+    if (len > std::numeric_limits<uint32_t>::max()) {
+        buf.resize(start);
+        throw notimplemented("pmt::serialize_frame: frame too long", obj);
     }
-    // throw pmt_notimplemented("pmt::serialize (tuple)", obj);
-
-    throw notimplemented("pmt::serialize (?)", obj);
+    uint32_t be_len = boost::endian::native_to_big(uint32_t(len));
+    memcpy(&buf[start + 2], &be_len, sizeof(be_len));
 }
 
 /*
@@ -697,6 +884,21 @@ pmt_t deserialize(std::streambuf& sb)
         }
     }
 
+    case PST_FRAME: {
+        if (!deserialize_untagged_u8(&u8, sb) || !deserialize_untagged_u32(&u32, sb))
+            goto error;
+        if (u8 != FRAME_VERSION)
+            throw notimplemented("pmt::deserialize: frame version = ", from_long(u8));
+        std::vector<char> body(u32);
+        if (sb.sgetn(body.data(), u32) != std::streamsize(u32))
+            goto error;
+        size_t used;
+        pmt_t obj = deserialize_buffer(body.data(), body.size(), used);
+        if (used != body.size())
+            goto error;
+        return obj;
+    }
+
     case PST_COMMENT:
         throw notimplemented("pmt::deserialize: tag value = ", from_long(tag));
 
@@ -709,14 +911,30 @@ error:
     throw exception("pmt::deserialize: malformed input stream", PMT_F);
 }
 
+pmt_t deserialize_buffer(const void* data, size_t len, size_t& used)
+{
+    decoder d(data, len, nullptr);
+    pmt_t obj = d.at_end() ? PMT_EOF : d.decode();
+    used = d.used();
+    return obj;
+}
+
+pmt_t deserialize_buffer(const std::shared_ptr<uint8_t>& data, size_t len, size_t& used)
+{
+    decoder d(data.get(), len, &data);
+    pmt_t obj = d.at_end() ? PMT_EOF : d.decode();
+    used = d.used();
+    return obj;
+}
+
 /*
  * provide a simple string accessor to the serialized pmt form
  */
 std::string serialize_str(pmt_t obj)
 {
-    std::stringbuf sb;
-    serialize(obj, sb);
-    return sb.str();
+    std::string s;
+    serialize_append(obj, s);
+    return s;
 }
 
 /*
@@ -724,8 +942,8 @@ std::string serialize_str(pmt_t obj)
  */
 pmt_t deserialize_str(std::string s)
 {
-    std::stringbuf sb(s);
-    return deserialize(sb);
+    size_t used;
+    return deserialize_buffer(s.data(), s.size(), used);
 }
 
 /*
@@ -30,72 +30,93 @@ namespace pmt {
 static pmt_u8vector* _u8vector(pmt_t x) { return dynamic_cast<pmt_u8vector*>(x.get()); }
 
 
-pmt_u8vector::pmt_u8vector(size_t k, uint8_t fill) : d_v(k)
+pmt_u8vector::pmt_u8vector(size_t k, uint8_t fill) : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_u8vector::pmt_u8vector(size_t k, const uint8_t* data) : d_v(k)
+pmt_u8vector::pmt_u8vector(size_t k, const uint8_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(uint8_t));
 }
 
+pmt_u8vector::pmt_u8vector(size_t k, uint8_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 uint8_t pmt_u8vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_u8vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_u8vector::set(size_t k, uint8_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_u8vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const uint8_t* pmt_u8vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 uint8_t* pmt_u8vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_u8vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(uint8_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_u8vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(uint8_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_u8vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_u8vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_u8vector>(k, d_elts + start, owner);
 }
 
 bool is_u8vector(pmt_t obj) { return obj->is_u8vector(); }
 
-pmt_t make_u8vector(size_t k, uint8_t fill) { return pmt_t(new pmt_u8vector(k, fill)); }
+pmt_t make_u8vector(size_t k, uint8_t fill) { return make_pmt<pmt_u8vector>(k, fill); }
 
 pmt_t init_u8vector(size_t k, const uint8_t* data)
 {
-    return pmt_t(new pmt_u8vector(k, data));
+    return make_pmt<pmt_u8vector>(k, data);
 }
 
 pmt_t init_u8vector(size_t k, const std::vector<uint8_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_u8vector(k, &data[0]));
+        return make_pmt<pmt_u8vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_u8vector(k, static_cast<uint8_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_u8vector>(
+        k, static_cast<uint8_t>(0)); // fills an empty vector with 0
+}
+
+pmt_t make_u8vector_view(size_t k, const std::shared_ptr<uint8_t>& data)
+{
+    return make_pmt<pmt_u8vector>(k, data.get(), data);
 }
 
 uint8_t u8vector_ref(pmt_t vector, size_t k)
@@ -153,72 +174,88 @@ namespace pmt {
 static pmt_s8vector* _s8vector(pmt_t x) { return dynamic_cast<pmt_s8vector*>(x.get()); }
 
 
-pmt_s8vector::pmt_s8vector(size_t k, int8_t fill) : d_v(k)
+pmt_s8vector::pmt_s8vector(size_t k, int8_t fill) : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_s8vector::pmt_s8vector(size_t k, const int8_t* data) : d_v(k)
+pmt_s8vector::pmt_s8vector(size_t k, const int8_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(int8_t));
 }
 
+pmt_s8vector::pmt_s8vector(size_t k, int8_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 int8_t pmt_s8vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_s8vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_s8vector::set(size_t k, int8_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_s8vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const int8_t* pmt_s8vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 int8_t* pmt_s8vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_s8vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(int8_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_s8vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(int8_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_s8vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_s8vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_s8vector>(k, d_elts + start, owner);
 }
 
 bool is_s8vector(pmt_t obj) { return obj->is_s8vector(); }
 
-pmt_t make_s8vector(size_t k, int8_t fill) { return pmt_t(new pmt_s8vector(k, fill)); }
+pmt_t make_s8vector(size_t k, int8_t fill) { return make_pmt<pmt_s8vector>(k, fill); }
 
 pmt_t init_s8vector(size_t k, const int8_t* data)
 {
-    return pmt_t(new pmt_s8vector(k, data));
+    return make_pmt<pmt_s8vector>(k, data);
 }
 
 pmt_t init_s8vector(size_t k, const std::vector<int8_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_s8vector(k, &data[0]));
+        return make_pmt<pmt_s8vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_s8vector(k, static_cast<int8_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_s8vector>(
+        k, static_cast<int8_t>(0)); // fills an empty vector with 0
 }
 
 int8_t s8vector_ref(pmt_t vector, size_t k)
@@ -279,75 +316,89 @@ static pmt_u16vector* _u16vector(pmt_t x)
 }
 
 
-pmt_u16vector::pmt_u16vector(size_t k, uint16_t fill) : d_v(k)
+pmt_u16vector::pmt_u16vector(size_t k, uint16_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_u16vector::pmt_u16vector(size_t k, const uint16_t* data) : d_v(k)
+pmt_u16vector::pmt_u16vector(size_t k, const uint16_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(uint16_t));
 }
 
+pmt_u16vector::pmt_u16vector(size_t k, uint16_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 uint16_t pmt_u16vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_u16vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_u16vector::set(size_t k, uint16_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_u16vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const uint16_t* pmt_u16vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 uint16_t* pmt_u16vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_u16vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(uint16_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_u16vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(uint16_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
 }
 
-bool is_u16vector(pmt_t obj) { return obj->is_u16vector(); }
-
-pmt_t make_u16vector(size_t k, uint16_t fill)
+pmt_t pmt_u16vector::slice(const pmt_t& self, size_t start, size_t k) const
 {
-    return pmt_t(new pmt_u16vector(k, fill));
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_u16vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_u16vector>(k, d_elts + start, owner);
 }
 
+bool is_u16vector(pmt_t obj) { return obj->is_u16vector(); }
+
+pmt_t make_u16vector(size_t k, uint16_t fill) { return make_pmt<pmt_u16vector>(k, fill); }
+
 pmt_t init_u16vector(size_t k, const uint16_t* data)
 {
-    return pmt_t(new pmt_u16vector(k, data));
+    return make_pmt<pmt_u16vector>(k, data);
 }
 
 pmt_t init_u16vector(size_t k, const std::vector<uint16_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_u16vector(k, &data[0]));
+        return make_pmt<pmt_u16vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_u16vector(k, static_cast<uint16_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_u16vector>(
+        k, static_cast<uint16_t>(0)); // fills an empty vector with 0
 }
 
 uint16_t u16vector_ref(pmt_t vector, size_t k)
@@ -407,72 +458,89 @@ static pmt_s16vector* _s16vector(pmt_t x)
 }
 
 
-pmt_s16vector::pmt_s16vector(size_t k, int16_t fill) : d_v(k)
+pmt_s16vector::pmt_s16vector(size_t k, int16_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_s16vector::pmt_s16vector(size_t k, const int16_t* data) : d_v(k)
+pmt_s16vector::pmt_s16vector(size_t k, const int16_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(int16_t));
 }
 
+pmt_s16vector::pmt_s16vector(size_t k, int16_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 int16_t pmt_s16vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_s16vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_s16vector::set(size_t k, int16_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_s16vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const int16_t* pmt_s16vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 int16_t* pmt_s16vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_s16vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(int16_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_s16vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(int16_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_s16vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_s16vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_s16vector>(k, d_elts + start, owner);
 }
 
 bool is_s16vector(pmt_t obj) { return obj->is_s16vector(); }
 
-pmt_t make_s16vector(size_t k, int16_t fill) { return pmt_t(new pmt_s16vector(k, fill)); }
+pmt_t make_s16vector(size_t k, int16_t fill) { return make_pmt<pmt_s16vector>(k, fill); }
 
 pmt_t init_s16vector(size_t k, const int16_t* data)
 {
-    return pmt_t(new pmt_s16vector(k, data));
+    return make_pmt<pmt_s16vector>(k, data);
 }
 
 pmt_t init_s16vector(size_t k, const std::vector<int16_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_s16vector(k, &data[0]));
+        return make_pmt<pmt_s16vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_s16vector(k, static_cast<int16_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_s16vector>(
+        k, static_cast<int16_t>(0)); // fills an empty vector with 0
 }
 
 int16_t s16vector_ref(pmt_t vector, size_t k)
@@ -532,75 +600,89 @@ static pmt_u32vector* _u32vector(pmt_t x)
 }
 
 
-pmt_u32vector::pmt_u32vector(size_t k, uint32_t fill) : d_v(k)
+pmt_u32vector::pmt_u32vector(size_t k, uint32_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_u32vector::pmt_u32vector(size_t k, const uint32_t* data) : d_v(k)
+pmt_u32vector::pmt_u32vector(size_t k, const uint32_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(uint32_t));
 }
 
+pmt_u32vector::pmt_u32vector(size_t k, uint32_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 uint32_t pmt_u32vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_u32vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_u32vector::set(size_t k, uint32_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_u32vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const uint32_t* pmt_u32vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 uint32_t* pmt_u32vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_u32vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(uint32_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_u32vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(uint32_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
 }
 
-bool is_u32vector(pmt_t obj) { return obj->is_u32vector(); }
-
-pmt_t make_u32vector(size_t k, uint32_t fill)
+pmt_t pmt_u32vector::slice(const pmt_t& self, size_t start, size_t k) const
 {
-    return pmt_t(new pmt_u32vector(k, fill));
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_u32vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_u32vector>(k, d_elts + start, owner);
 }
 
+bool is_u32vector(pmt_t obj) { return obj->is_u32vector(); }
+
+pmt_t make_u32vector(size_t k, uint32_t fill) { return make_pmt<pmt_u32vector>(k, fill); }
+
 pmt_t init_u32vector(size_t k, const uint32_t* data)
 {
-    return pmt_t(new pmt_u32vector(k, data));
+    return make_pmt<pmt_u32vector>(k, data);
 }
 
 pmt_t init_u32vector(size_t k, const std::vector<uint32_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_u32vector(k, &data[0]));
+        return make_pmt<pmt_u32vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_u32vector(k, static_cast<uint32_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_u32vector>(
+        k, static_cast<uint32_t>(0)); // fills an empty vector with 0
 }
 
 uint32_t u32vector_ref(pmt_t vector, size_t k)
@@ -660,72 +742,89 @@ static pmt_s32vector* _s32vector(pmt_t x)
 }
 
 
-pmt_s32vector::pmt_s32vector(size_t k, int32_t fill) : d_v(k)
+pmt_s32vector::pmt_s32vector(size_t k, int32_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_s32vector::pmt_s32vector(size_t k, const int32_t* data) : d_v(k)
+pmt_s32vector::pmt_s32vector(size_t k, const int32_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(int32_t));
 }
 
+pmt_s32vector::pmt_s32vector(size_t k, int32_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 int32_t pmt_s32vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_s32vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_s32vector::set(size_t k, int32_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_s32vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const int32_t* pmt_s32vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 int32_t* pmt_s32vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_s32vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(int32_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_s32vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(int32_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_s32vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_s32vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_s32vector>(k, d_elts + start, owner);
 }
 
 bool is_s32vector(pmt_t obj) { return obj->is_s32vector(); }
 
-pmt_t make_s32vector(size_t k, int32_t fill) { return pmt_t(new pmt_s32vector(k, fill)); }
+pmt_t make_s32vector(size_t k, int32_t fill) { return make_pmt<pmt_s32vector>(k, fill); }
 
 pmt_t init_s32vector(size_t k, const int32_t* data)
 {
-    return pmt_t(new pmt_s32vector(k, data));
+    return make_pmt<pmt_s32vector>(k, data);
 }
 
 pmt_t init_s32vector(size_t k, const std::vector<int32_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_s32vector(k, &data[0]));
+        return make_pmt<pmt_s32vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_s32vector(k, static_cast<int32_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_s32vector>(
+        k, static_cast<int32_t>(0)); // fills an empty vector with 0
 }
 
 int32_t s32vector_ref(pmt_t vector, size_t k)
@@ -785,75 +884,89 @@ static pmt_u64vector* _u64vector(pmt_t x)
 }
 
 
-pmt_u64vector::pmt_u64vector(size_t k, uint64_t fill) : d_v(k)
+pmt_u64vector::pmt_u64vector(size_t k, uint64_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_u64vector::pmt_u64vector(size_t k, const uint64_t* data) : d_v(k)
+pmt_u64vector::pmt_u64vector(size_t k, const uint64_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(uint64_t));
 }
 
+pmt_u64vector::pmt_u64vector(size_t k, uint64_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 uint64_t pmt_u64vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_u64vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_u64vector::set(size_t k, uint64_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_u64vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const uint64_t* pmt_u64vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 uint64_t* pmt_u64vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_u64vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(uint64_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_u64vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(uint64_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
 }
 
-bool is_u64vector(pmt_t obj) { return obj->is_u64vector(); }
-
-pmt_t make_u64vector(size_t k, uint64_t fill)
+pmt_t pmt_u64vector::slice(const pmt_t& self, size_t start, size_t k) const
 {
-    return pmt_t(new pmt_u64vector(k, fill));
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_u64vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_u64vector>(k, d_elts + start, owner);
 }
 
+bool is_u64vector(pmt_t obj) { return obj->is_u64vector(); }
+
+pmt_t make_u64vector(size_t k, uint64_t fill) { return make_pmt<pmt_u64vector>(k, fill); }
+
 pmt_t init_u64vector(size_t k, const uint64_t* data)
 {
-    return pmt_t(new pmt_u64vector(k, data));
+    return make_pmt<pmt_u64vector>(k, data);
 }
 
 pmt_t init_u64vector(size_t k, const std::vector<uint64_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_u64vector(k, &data[0]));
+        return make_pmt<pmt_u64vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_u64vector(k, static_cast<uint64_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_u64vector>(
+        k, static_cast<uint64_t>(0)); // fills an empty vector with 0
 }
 
 uint64_t u64vector_ref(pmt_t vector, size_t k)
@@ -913,72 +1026,89 @@ static pmt_s64vector* _s64vector(pmt_t x)
 }
 
 
-pmt_s64vector::pmt_s64vector(size_t k, int64_t fill) : d_v(k)
+pmt_s64vector::pmt_s64vector(size_t k, int64_t fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_s64vector::pmt_s64vector(size_t k, const int64_t* data) : d_v(k)
+pmt_s64vector::pmt_s64vector(size_t k, const int64_t* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(int64_t));
 }
 
+pmt_s64vector::pmt_s64vector(size_t k, int64_t* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 int64_t pmt_s64vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_s64vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_s64vector::set(size_t k, int64_t x)
 {
     if (k >= length())
         throw out_of_range("pmt_s64vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const int64_t* pmt_s64vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 int64_t* pmt_s64vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_s64vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(int64_t);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_s64vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(int64_t);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_s64vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_s64vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_s64vector>(k, d_elts + start, owner);
 }
 
 bool is_s64vector(pmt_t obj) { return obj->is_s64vector(); }
 
-pmt_t make_s64vector(size_t k, int64_t fill) { return pmt_t(new pmt_s64vector(k, fill)); }
+pmt_t make_s64vector(size_t k, int64_t fill) { return make_pmt<pmt_s64vector>(k, fill); }
 
 pmt_t init_s64vector(size_t k, const int64_t* data)
 {
-    return pmt_t(new pmt_s64vector(k, data));
+    return make_pmt<pmt_s64vector>(k, data);
 }
 
 pmt_t init_s64vector(size_t k, const std::vector<int64_t>& data)
 {
     if (k) {
-        return pmt_t(new pmt_s64vector(k, &data[0]));
+        return make_pmt<pmt_s64vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_s64vector(k, static_cast<int64_t>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_s64vector>(
+        k, static_cast<int64_t>(0)); // fills an empty vector with 0
 }
 
 int64_t s64vector_ref(pmt_t vector, size_t k)
@@ -1038,72 +1168,93 @@ static pmt_f32vector* _f32vector(pmt_t x)
 }
 
 
-pmt_f32vector::pmt_f32vector(size_t k, float fill) : d_v(k)
+pmt_f32vector::pmt_f32vector(size_t k, float fill) : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_f32vector::pmt_f32vector(size_t k, const float* data) : d_v(k)
+pmt_f32vector::pmt_f32vector(size_t k, const float* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(float));
 }
 
+pmt_f32vector::pmt_f32vector(size_t k, float* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 float pmt_f32vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_f32vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_f32vector::set(size_t k, float x)
 {
     if (k >= length())
         throw out_of_range("pmt_f32vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const float* pmt_f32vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 float* pmt_f32vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_f32vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(float);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_f32vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(float);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_f32vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_f32vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_f32vector>(k, d_elts + start, owner);
 }
 
 bool is_f32vector(pmt_t obj) { return obj->is_f32vector(); }
 
-pmt_t make_f32vector(size_t k, float fill) { return pmt_t(new pmt_f32vector(k, fill)); }
+pmt_t make_f32vector(size_t k, float fill) { return make_pmt<pmt_f32vector>(k, fill); }
 
 pmt_t init_f32vector(size_t k, const float* data)
 {
-    return pmt_t(new pmt_f32vector(k, data));
+    return make_pmt<pmt_f32vector>(k, data);
 }
 
 pmt_t init_f32vector(size_t k, const std::vector<float>& data)
 {
     if (k) {
-        return pmt_t(new pmt_f32vector(k, &data[0]));
+        return make_pmt<pmt_f32vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_f32vector(k, static_cast<float>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_f32vector>(
+        k, static_cast<float>(0)); // fills an empty vector with 0
+}
+
+pmt_t make_f32vector_view(size_t k, const std::shared_ptr<float>& data)
+{
+    return make_pmt<pmt_f32vector>(k, data.get(), data);
 }
 
 float f32vector_ref(pmt_t vector, size_t k)
@@ -1165,72 +1316,88 @@ static pmt_f64vector* _f64vector(pmt_t x)
 }
 
 
-pmt_f64vector::pmt_f64vector(size_t k, double fill) : d_v(k)
+pmt_f64vector::pmt_f64vector(size_t k, double fill) : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_f64vector::pmt_f64vector(size_t k, const double* data) : d_v(k)
+pmt_f64vector::pmt_f64vector(size_t k, const double* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(double));
 }
 
+pmt_f64vector::pmt_f64vector(size_t k, double* data, const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 double pmt_f64vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_f64vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_f64vector::set(size_t k, double x)
 {
     if (k >= length())
         throw out_of_range("pmt_f64vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const double* pmt_f64vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 double* pmt_f64vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_f64vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(double);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_f64vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(double);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_f64vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_f64vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_f64vector>(k, d_elts + start, owner);
 }
 
 bool is_f64vector(pmt_t obj) { return obj->is_f64vector(); }
 
-pmt_t make_f64vector(size_t k, double fill) { return pmt_t(new pmt_f64vector(k, fill)); }
+pmt_t make_f64vector(size_t k, double fill) { return make_pmt<pmt_f64vector>(k, fill); }
 
 pmt_t init_f64vector(size_t k, const double* data)
 {
-    return pmt_t(new pmt_f64vector(k, data));
+    return make_pmt<pmt_f64vector>(k, data);
 }
 
 pmt_t init_f64vector(size_t k, const std::vector<double>& data)
 {
     if (k) {
-        return pmt_t(new pmt_f64vector(k, &data[0]));
+        return make_pmt<pmt_f64vector>(k, &data[0]);
     }
-    return pmt_t(
-        new pmt_f64vector(k, static_cast<double>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_f64vector>(
+        k, static_cast<double>(0)); // fills an empty vector with 0
 }
 
 double f64vector_ref(pmt_t vector, size_t k)
@@ -1293,75 +1460,99 @@ static pmt_c32vector* _c32vector(pmt_t x)
 }
 
 
-pmt_c32vector::pmt_c32vector(size_t k, std::complex<float> fill) : d_v(k)
+pmt_c32vector::pmt_c32vector(size_t k, std::complex<float> fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_c32vector::pmt_c32vector(size_t k, const std::complex<float>* data) : d_v(k)
+pmt_c32vector::pmt_c32vector(size_t k, const std::complex<float>* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(std::complex<float>));
 }
 
+pmt_c32vector::pmt_c32vector(size_t k,
+                             std::complex<float>* data,
+                             const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 std::complex<float> pmt_c32vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_c32vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_c32vector::set(size_t k, std::complex<float> x)
 {
     if (k >= length())
         throw out_of_range("pmt_c32vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const std::complex<float>* pmt_c32vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 std::complex<float>* pmt_c32vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_c32vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(std::complex<float>);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_c32vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(std::complex<float>);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_c32vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_c32vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_c32vector>(k, d_elts + start, owner);
 }
 
 bool is_c32vector(pmt_t obj) { return obj->is_c32vector(); }
 
 pmt_t make_c32vector(size_t k, std::complex<float> fill)
 {
-    return pmt_t(new pmt_c32vector(k, fill));
+    return make_pmt<pmt_c32vector>(k, fill);
 }
 
 pmt_t init_c32vector(size_t k, const std::complex<float>* data)
 {
-    return pmt_t(new pmt_c32vector(k, data));
+    return make_pmt<pmt_c32vector>(k, data);
 }
 
 pmt_t init_c32vector(size_t k, const std::vector<std::complex<float>>& data)
 {
     if (k) {
-        return pmt_t(new pmt_c32vector(k, &data[0]));
+        return make_pmt<pmt_c32vector>(k, &data[0]);
     }
-    return pmt_t(new pmt_c32vector(
-        k, static_cast<std::complex<float>>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_c32vector>(
+        k, static_cast<std::complex<float>>(0)); // fills an empty vector with 0
+}
+
+pmt_t make_c32vector_view(size_t k, const std::shared_ptr<std::complex<float>>& data)
+{
+    return make_pmt<pmt_c32vector>(k, data.get(), data);
 }
 
 std::complex<float> c32vector_ref(pmt_t vector, size_t k)
@@ -1423,75 +1614,94 @@ static pmt_c64vector* _c64vector(pmt_t x)
 }
 
 
-pmt_c64vector::pmt_c64vector(size_t k, std::complex<double> fill) : d_v(k)
+pmt_c64vector::pmt_c64vector(size_t k, std::complex<double> fill)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     for (size_t i = 0; i < k; i++)
         d_v[i] = fill;
 }
 
-pmt_c64vector::pmt_c64vector(size_t k, const std::complex<double>* data) : d_v(k)
+pmt_c64vector::pmt_c64vector(size_t k, const std::complex<double>* data)
+    : d_v(k), d_elts(d_v.data()), d_len(k)
 {
     if (k)
         memcpy(&d_v[0], data, k * sizeof(std::complex<double>));
 }
 
+pmt_c64vector::pmt_c64vector(size_t k,
+                             std::complex<double>* data,
+                             const std::shared_ptr<void>& owner)
+    : d_owner(owner), d_elts(data), d_len(k)
+{
+}
+
 std::complex<double> pmt_c64vector::ref(size_t k) const
 {
     if (k >= length())
         throw out_of_range("pmt_c64vector_ref", from_long(k));
-    return d_v[k];
+    return d_elts[k];
 }
 
 void pmt_c64vector::set(size_t k, std::complex<double> x)
 {
     if (k >= length())
         throw out_of_range("pmt_c64vector_set", from_long(k));
-    d_v[k] = x;
+    d_elts[k] = x;
 }
 
 const std::complex<double>* pmt_c64vector::elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 std::complex<double>* pmt_c64vector::writable_elements(size_t& len)
 {
     len = length();
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 const void* pmt_c64vector::uniform_elements(size_t& len)
 {
     len = length() * sizeof(std::complex<double>);
-    return len ? &d_v[0] : nullptr;
+    return len ? d_elts : nullptr;
 }
 
 void* pmt_c64vector::uniform_writable_elements(size_t& len)
 {
     len = length() * sizeof(std::complex<double>);
-    return len ? (&d_v[0]) : nullptr;
+    return len ? d_elts : nullptr;
+}
+
+pmt_t pmt_c64vector::slice(const pmt_t& self, size_t start, size_t k) const
+{
+    if (start > d_len || k > d_len - start)
+        throw out_of_range("pmt_c64vector_slice", from_long(start + k));
+    std::shared_ptr<void> owner = d_owner;
+    if (!owner)
+        owner = self;
+    return make_pmt<pmt_c64vector>(k, d_elts + start, owner);
 }
 
 bool is_c64vector(pmt_t obj) { return obj->is_c64vector(); }
 
 pmt_t make_c64vector(size_t k, std::complex<double> fill)
 {
-    return pmt_t(new pmt_c64vector(k, fill));
+    return make_pmt<pmt_c64vector>(k, fill);
 }
 
 pmt_t init_c64vector(size_t k, const std::complex<double>* data)
 {
-    return pmt_t(new pmt_c64vector(k, data));
+    return make_pmt<pmt_c64vector>(k, data);
 }
 
 pmt_t init_c64vector(size_t k, const std::vector<std::complex<double>>& data)
 {
     if (k) {
-        return pmt_t(new pmt_c64vector(k, &data[0]));
+        return make_pmt<pmt_c64vector>(k, &data[0]);
     }
-    return pmt_t(new pmt_c64vector(
-        k, static_cast<std::complex<double>>(0))); // fills an empty vector with 0
+    return make_pmt<pmt_c64vector>(
+        k, static_cast<std::complex<double>>(0)); // fills an empty vector with 0
 }
 
 std::complex<double> c64vector_ref(pmt_t vector, size_t k)
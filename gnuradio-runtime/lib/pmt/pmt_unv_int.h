@@ -14,6 +14,7 @@
 #include "pmt_int.h"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace pmt {
@@ -22,15 +23,19 @@ namespace pmt {
 ////////////////////////////////////////////////////////////////////////////
 class PMT_API pmt_u8vector : public pmt_uniform_vector
 {
-    std::vector<uint8_t> d_v;
+    std::vector<uint8_t, pool_allocator<uint8_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    uint8_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_u8vector(size_t k, uint8_t fill);
     pmt_u8vector(size_t k, const uint8_t* data);
+    pmt_u8vector(size_t k, uint8_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_u8vector();
 
     bool is_u8vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(uint8_t); }
     uint8_t ref(size_t k) const;
     void set(size_t k, uint8_t x);
@@ -38,6 +43,7 @@ public:
     uint8_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -47,15 +53,19 @@ public:
 
 class pmt_s8vector : public pmt_uniform_vector
 {
-    std::vector<int8_t> d_v;
+    std::vector<int8_t, pool_allocator<int8_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    int8_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_s8vector(size_t k, int8_t fill);
     pmt_s8vector(size_t k, const int8_t* data);
+    pmt_s8vector(size_t k, int8_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_s8vector();
 
     bool is_s8vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(int8_t); }
     int8_t ref(size_t k) const;
     void set(size_t k, int8_t x);
@@ -63,6 +73,7 @@ public:
     int8_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -72,15 +83,19 @@ public:
 
 class pmt_u16vector : public pmt_uniform_vector
 {
-    std::vector<uint16_t> d_v;
+    std::vector<uint16_t, pool_allocator<uint16_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    uint16_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_u16vector(size_t k, uint16_t fill);
     pmt_u16vector(size_t k, const uint16_t* data);
+    pmt_u16vector(size_t k, uint16_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_u16vector();
 
     bool is_u16vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(uint16_t); }
     uint16_t ref(size_t k) const;
     void set(size_t k, uint16_t x);
@@ -88,6 +103,7 @@ public:
     uint16_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -97,15 +113,19 @@ public:
 
 class pmt_s16vector : public pmt_uniform_vector
 {
-    std::vector<int16_t> d_v;
+    std::vector<int16_t, pool_allocator<int16_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    int16_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_s16vector(size_t k, int16_t fill);
     pmt_s16vector(size_t k, const int16_t* data);
+    pmt_s16vector(size_t k, int16_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_s16vector();
 
     bool is_s16vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(int16_t); }
     int16_t ref(size_t k) const;
     void set(size_t k, int16_t x);
@@ -113,6 +133,7 @@ public:
     int16_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -122,15 +143,19 @@ public:
 
 class pmt_u32vector : public pmt_uniform_vector
 {
-    std::vector<uint32_t> d_v;
+    std::vector<uint32_t, pool_allocator<uint32_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    uint32_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_u32vector(size_t k, uint32_t fill);
     pmt_u32vector(size_t k, const uint32_t* data);
+    pmt_u32vector(size_t k, uint32_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_u32vector();
 
     bool is_u32vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(uint32_t); }
     uint32_t ref(size_t k) const;
     void set(size_t k, uint32_t x);
@@ -138,6 +163,7 @@ public:
     uint32_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -147,15 +173,19 @@ public:
 
 class pmt_s32vector : public pmt_uniform_vector
 {
-    std::vector<int32_t> d_v;
+    std::vector<int32_t, pool_allocator<int32_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    int32_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_s32vector(size_t k, int32_t fill);
     pmt_s32vector(size_t k, const int32_t* data);
+    pmt_s32vector(size_t k, int32_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_s32vector();
 
     bool is_s32vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(int32_t); }
     int32_t ref(size_t k) const;
     void set(size_t k, int32_t x);
@@ -163,6 +193,7 @@ public:
     int32_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -172,15 +203,19 @@ public:
 
 class pmt_u64vector : public pmt_uniform_vector
 {
-    std::vector<uint64_t> d_v;
+    std::vector<uint64_t, pool_allocator<uint64_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    uint64_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_u64vector(size_t k, uint64_t fill);
     pmt_u64vector(size_t k, const uint64_t* data);
+    pmt_u64vector(size_t k, uint64_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_u64vector();
 
     bool is_u64vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(uint64_t); }
     uint64_t ref(size_t k) const;
     void set(size_t k, uint64_t x);
@@ -188,6 +223,7 @@ public:
     uint64_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -197,15 +233,19 @@ public:
 
 class pmt_s64vector : public pmt_uniform_vector
 {
-    std::vector<int64_t> d_v;
+    std::vector<int64_t, pool_allocator<int64_t>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    int64_t* d_elts;
+    size_t d_len;
 
 public:
     pmt_s64vector(size_t k, int64_t fill);
     pmt_s64vector(size_t k, const int64_t* data);
+    pmt_s64vector(size_t k, int64_t* data, const std::shared_ptr<void>& owner);
     // ~pmt_s64vector();
 
     bool is_s64vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(int64_t); }
     int64_t ref(size_t k) const;
     void set(size_t k, int64_t x);
@@ -213,6 +253,7 @@ public:
     int64_t* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -222,15 +263,19 @@ public:
 
 class pmt_f32vector : public pmt_uniform_vector
 {
-    std::vector<float> d_v;
+    std::vector<float, pool_allocator<float>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    float* d_elts;
+    size_t d_len;
 
 public:
     pmt_f32vector(size_t k, float fill);
     pmt_f32vector(size_t k, const float* data);
+    pmt_f32vector(size_t k, float* data, const std::shared_ptr<void>& owner);
     // ~pmt_f32vector();
 
     bool is_f32vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(float); }
     float ref(size_t k) const;
     void set(size_t k, float x);
@@ -238,6 +283,7 @@ public:
     float* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -247,15 +293,19 @@ public:
 
 class pmt_f64vector : public pmt_uniform_vector
 {
-    std::vector<double> d_v;
+    std::vector<double, pool_allocator<double>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    double* d_elts;
+    size_t d_len;
 
 public:
     pmt_f64vector(size_t k, double fill);
     pmt_f64vector(size_t k, const double* data);
+    pmt_f64vector(size_t k, double* data, const std::shared_ptr<void>& owner);
     // ~pmt_f64vector();
 
     bool is_f64vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(double); }
     double ref(size_t k) const;
     void set(size_t k, double x);
@@ -263,6 +313,7 @@ public:
     double* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -272,15 +323,21 @@ public:
 
 class pmt_c32vector : public pmt_uniform_vector
 {
-    std::vector<std::complex<float>> d_v;
+    std::vector<std::complex<float>, pool_allocator<std::complex<float>>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    std::complex<float>* d_elts;
+    size_t d_len;
 
 public:
     pmt_c32vector(size_t k, std::complex<float> fill);
     pmt_c32vector(size_t k, const std::complex<float>* data);
+    pmt_c32vector(size_t k,
+                  std::complex<float>* data,
+                  const std::shared_ptr<void>& owner);
     // ~pmt_c32vector();
 
     bool is_c32vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(std::complex<float>); }
     std::complex<float> ref(size_t k) const;
     void set(size_t k, std::complex<float> x);
@@ -288,6 +345,7 @@ public:
     std::complex<float>* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 
@@ -297,15 +355,21 @@ public:
 
 class pmt_c64vector : public pmt_uniform_vector
 {
-    std::vector<std::complex<double>> d_v;
+    std::vector<std::complex<double>, pool_allocator<std::complex<double>>> d_v;
+    std::shared_ptr<void> d_owner; // keeps d_elts alive when it isn't d_v
+    std::complex<double>* d_elts;
+    size_t d_len;
 
 public:
     pmt_c64vector(size_t k, std::complex<double> fill);
     pmt_c64vector(size_t k, const std::complex<double>* data);
+    pmt_c64vector(size_t k,
+                  std::complex<double>* data,
+                  const std::shared_ptr<void>& owner);
     // ~pmt_c64vector();
 
     bool is_c64vector() const override { return true; }
-    size_t length() const override { return d_v.size(); }
+    size_t length() const override { return d_len; }
     size_t itemsize() const override { return sizeof(std::complex<double>); }
     std::complex<double> ref(size_t k) const;
     void set(size_t k, std::complex<double> x);
@@ -313,6 +377,7 @@ public:
     std::complex<double>* writable_elements(size_t& len);
     const void* uniform_elements(size_t& len) override;
     void* uniform_writable_elements(size_t& len) override;
+    pmt_t slice(const pmt_t& self, size_t start, size_t k) const override;
     const std::string string_ref(size_t k) const override;
 };
 } /* namespace pmt */
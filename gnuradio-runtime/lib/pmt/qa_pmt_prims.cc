@@ -10,8 +10,10 @@
 
 #include <gnuradio/messages/msg_passing.h>
 #include <pmt/api.h> //reason: suppress warnings
+#include <pmt/pmt_pool.h>
 #include <boost/format.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
@@ -60,6 +62,46 @@ BOOST_AUTO_TEST_CASE(test_symbols)
         BOOST_CHECK(v1[i] == v2[i]);
 }
 
+BOOST_AUTO_TEST_CASE(test_symbols_threaded)
+{
+    // Several threads interning overlapping names, enough to grow the
+    // table a few times, must all end up with the same symbols.
+    static const int NTHREADS = 4;
+    static const int N = 5000;
+    std::vector<std::vector<pmt::pmt_t>> got(NTHREADS, std::vector<pmt::pmt_t>(N));
+
+    std::vector<boost::thread> threads;
+    for (int t = 0; t < NTHREADS; t++) {
+        threads.emplace_back([t, &got]() {
+            for (int i = 0; i < N; i++) {
+                int k = (i + t * N / NTHREADS) % N; // start at different places
+                got[t][k] = pmt::mp(str(boost::format("threaded-%d") % k));
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    for (int i = 0; i < N; i++) {
+        BOOST_CHECK_EQUAL(str(boost::format("threaded-%d") % i),
+                          pmt::symbol_to_string(got[0][i]));
+        for (int t = 1; t < NTHREADS; t++)
+            BOOST_CHECK(got[t][i] == got[0][i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_symbol_macro)
+{
+    const pmt::pmt_t* first = nullptr;
+    for (int i = 0; i < 3; i++) {
+        const pmt::pmt_t& key = PMT_SYMBOL("packet_len");
+        BOOST_CHECK(key == pmt::mp("packet_len"));
+        if (!first)
+            first = &key;
+        BOOST_CHECK_EQUAL(first, &key); // cached at this call site
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_booleans)
 {
     pmt::pmt_t sym = pmt::mp("test");
@@ -393,6 +435,60 @@ BOOST_AUTO_TEST_CASE(test_dict)
     BOOST_CHECK(pmt::is_dict(dict));
 }
 
+BOOST_AUTO_TEST_CASE(test_dict_large)
+{
+    const long n = 1000;
+    pmt::pmt_t not_found = pmt::PMT_F;
+
+    std::vector<pmt::pmt_t> keys;
+    for (long i = 0; i < n; i++)
+        keys.push_back(pmt::mp(boost::str(boost::format("k%d") % i)));
+
+    pmt::pmt_t dict = pmt::make_dict();
+    pmt::pmt_t half;
+    for (long i = 0; i < n; i++) {
+        if (i == n / 2)
+            half = dict;
+        dict = pmt::dict_add(dict, keys[i], pmt::from_long(i));
+        dict = pmt::dict_add(dict, pmt::from_long(i), pmt::from_long(-i));
+    }
+    BOOST_CHECK_EQUAL(size_t(2 * n), pmt::length(dict));
+    BOOST_CHECK_EQUAL(size_t(n), pmt::length(half));
+
+    for (long i = 0; i < n; i++) {
+        pmt::pmt_t k = pmt::from_long(i);
+        BOOST_CHECK_EQUAL(i, pmt::to_long(pmt::dict_ref(dict, keys[i], not_found)));
+        BOOST_CHECK_EQUAL(-i, pmt::to_long(pmt::dict_ref(dict, k, not_found)));
+        // older versions don't see later additions
+        BOOST_CHECK_EQUAL(i < n / 2, pmt::dict_has_key(half, keys[i]));
+    }
+    BOOST_CHECK(!pmt::dict_has_key(dict, pmt::from_uint64(0)));
+    BOOST_CHECK(!pmt::dict_has_key(dict, pmt::from_double(0)));
+
+    // most recently added first, as with an a-list
+    pmt::pmt_t d = pmt::dict_add(dict, keys[7], pmt::PMT_T);
+    pmt::pmt_t items = pmt::dict_items(d);
+    BOOST_CHECK(pmt::eqv(keys[7], pmt::car(pmt::nth(0, items))));
+    BOOST_CHECK(pmt::eqv(pmt::from_long(n - 1), pmt::car(pmt::nth(1, items))));
+    BOOST_CHECK_EQUAL(size_t(2 * n), pmt::length(pmt::dict_keys(d)));
+    BOOST_CHECK_EQUAL(7, pmt::to_long(pmt::dict_ref(dict, keys[7], not_found)));
+
+    for (long i = 0; i < n; i++) {
+        d = pmt::dict_delete(d, keys[i]);
+        d = pmt::dict_delete(d, pmt::from_long(i));
+    }
+    BOOST_CHECK(pmt::is_null(d));
+    BOOST_CHECK_EQUAL(size_t(2 * n), pmt::length(dict));
+
+    // a-lists read back from the wire become hashed once added to
+    pmt::pmt_t alist = pmt::deserialize_str(pmt::serialize_str(half));
+    BOOST_CHECK(pmt::equal(alist, half));
+    alist = pmt::dict_add(alist, pmt::mp("k0"), pmt::PMT_T);
+    BOOST_CHECK_EQUAL(size_t(n), pmt::length(alist));
+    BOOST_CHECK(pmt::eqv(pmt::PMT_T, pmt::dict_ref(alist, pmt::mp("k0"), not_found)));
+    BOOST_CHECK_EQUAL(1, pmt::to_long(pmt::dict_ref(alist, pmt::mp("k1"), not_found)));
+}
+
 BOOST_AUTO_TEST_CASE(test_pdu)
 {
     pmt::pmt_t dict = pmt::dict_add(pmt::make_dict(), pmt::mp("k0"), pmt::mp("v0"));
@@ -406,6 +502,98 @@ BOOST_AUTO_TEST_CASE(test_pdu)
     BOOST_CHECK(pmt::is_pdu(pmt::cons(dict, vec)));
 }
 
+BOOST_AUTO_TEST_CASE(test_slab_pool)
+{
+    pmt::slab_pool pool(1500, 0, 4);
+    std::vector<std::shared_ptr<uint8_t>> slabs;
+    for (int i = 0; i < 10; i++) {
+        slabs.push_back(pool.get());
+        BOOST_CHECK_EQUAL(uintptr_t(0), uintptr_t(slabs.back().get()) % 64);
+    }
+    BOOST_CHECK_EQUAL(size_t(0), pool.nidle());
+
+    // Only max_idle of the slabs returned are kept, and reused.
+    slabs.clear();
+    BOOST_CHECK_EQUAL(size_t(4), pool.nidle());
+    std::shared_ptr<uint8_t> slab = pool.get();
+    BOOST_CHECK_EQUAL(size_t(3), pool.nidle());
+
+    // Short reads are copied and the slab kept; long ones keep it.
+    slab = pool.get();
+    uint8_t* p = slab.get();
+    p[0] = 42;
+    pmt::pmt_t v = pool.make_u8vector(749, slab);
+    BOOST_CHECK_EQUAL(p, slab.get());
+    size_t len;
+    BOOST_CHECK(p != pmt::u8vector_elements(v, len));
+    BOOST_CHECK_EQUAL(size_t(749), len);
+    BOOST_CHECK_EQUAL(42, pmt::u8vector_ref(v, 0));
+    v = pool.make_u8vector(750, slab);
+    BOOST_CHECK(p != slab.get());
+    BOOST_CHECK_EQUAL(p, pmt::u8vector_elements(v, len));
+    BOOST_CHECK_EQUAL(size_t(750), len);
+
+    // Slabs outlive the pool.
+    {
+        pmt::slab_pool gone(64);
+        slab = gone.get();
+    }
+    memset(slab.get(), 0, 64);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_payloads)
+{
+    pmt::slab_pool pool(1500);
+    std::shared_ptr<uint8_t> slab = pool.get();
+    for (size_t i = 0; i < 100; i++)
+        slab.get()[i] = i;
+
+    pmt::pmt_t v = pmt::make_u8vector_view(100, slab);
+    BOOST_CHECK(pmt::is_u8vector(v));
+    BOOST_CHECK_EQUAL(size_t(100), pmt::length(v));
+    size_t len;
+    BOOST_CHECK_EQUAL(slab.get(), pmt::u8vector_elements(v, len));
+    BOOST_CHECK_EQUAL(size_t(100), len);
+
+    // Slices share the slab, and keep it alive
+    pmt::pmt_t s = pmt::uniform_vector_slice(v, 10, 20);
+    std::weak_ptr<uint8_t> weak = slab;
+    slab.reset();
+    v.reset();
+    BOOST_CHECK(!weak.expired());
+    BOOST_CHECK(pmt::is_u8vector(s));
+    BOOST_CHECK_EQUAL(size_t(20), pmt::length(s));
+    BOOST_CHECK_EQUAL(10, pmt::u8vector_ref(s, 0));
+    BOOST_CHECK_EQUAL(29, pmt::u8vector_ref(s, 19));
+    BOOST_CHECK_THROW(pmt::u8vector_ref(s, 20), pmt::out_of_range);
+    pmt::pmt_t ss = pmt::uniform_vector_slice(s, 5, 0);
+    BOOST_CHECK_EQUAL(size_t(0), pmt::length(ss));
+    BOOST_CHECK_THROW(pmt::uniform_vector_slice(s, 15, 6), pmt::out_of_range);
+    s.reset();
+    BOOST_CHECK(!weak.expired());
+    ss.reset();
+    BOOST_CHECK(weak.expired());
+
+    // Slices of vectors that own their elements
+    pmt::pmt_t f = pmt::make_f32vector(8, 1.5);
+    pmt::f32vector_set(f, 3, 2.5);
+    pmt::pmt_t fs = pmt::uniform_vector_slice(f, 2, 4);
+    f.reset();
+    BOOST_CHECK(pmt::is_f32vector(fs));
+    BOOST_CHECK_EQUAL(2.5, pmt::f32vector_ref(fs, 1));
+    pmt::f32vector_set(fs, 0, 4.0);
+    std::vector<float> expected{ 4, 2.5, 1.5, 1.5 };
+    BOOST_CHECK(pmt::equal(fs, pmt::init_f32vector(4, expected)));
+    BOOST_CHECK_THROW(pmt::uniform_vector_slice(pmt::PMT_NIL, 0, 0), pmt::wrong_type);
+
+    // Views survive serialization as ordinary u8vectors
+    slab = pool.get();
+    memcpy(slab.get(), "payload", 7);
+    v = pmt::make_u8vector_view(7, slab);
+    std::string str = pmt::serialize_str(v);
+    BOOST_CHECK(pmt::equal(v, pmt::deserialize_str(str)));
+}
+
 BOOST_AUTO_TEST_CASE(test_io)
 {
     pmt::pmt_t k0 = pmt::mp("k0");
@@ -560,6 +748,167 @@ BOOST_AUTO_TEST_CASE(test_serialize)
     // FIXME add tests for malformed input too.
 }
 
+BOOST_AUTO_TEST_CASE(test_serialize_buffer)
+{
+    std::vector<pmt::pmt_t> objs;
+    objs.push_back(pmt::list3(pmt::mp("a"), pmt::from_long(-(1L << 40)), pmt::PMT_T));
+    objs.push_back(pmt::make_rectangular(1.5, -2.5));
+    objs.push_back(pmt::make_tuple(pmt::from_uint64(7), pmt::from_double(0.25)));
+    objs.push_back(pmt::dict_add(pmt::make_dict(), pmt::mp("k"), pmt::mp("v")));
+    pmt::pmt_t vec = pmt::make_vector(2, pmt::PMT_NIL);
+    pmt::vector_set(vec, 0, pmt::make_s16vector(3, -300));
+    objs.push_back(vec);
+    objs.push_back(pmt::make_u8vector(100, 0x5a));
+    objs.push_back(pmt::make_u32vector(5, 0x01020304));
+    objs.push_back(pmt::make_f64vector(4, -1.5));
+    objs.push_back(pmt::make_c32vector(3, std::complex<float>(1, -2)));
+    objs.push_back(pmt::make_c64vector(2, std::complex<double>(3, 4)));
+
+    std::string buf, frames;
+    for (const auto& obj : objs) {
+        std::stringbuf sb;
+        pmt::serialize(obj, sb);
+        size_t start = buf.size();
+        pmt::serialize_append(obj, buf);
+        BOOST_CHECK_EQUAL(sb.str(), buf.substr(start));
+        pmt::serialize_frame(obj, frames);
+    }
+
+    // All three readers, plain and framed
+    std::stringbuf sb(buf + frames);
+    size_t offset = 0, used;
+    for (int pass = 0; pass < 2; pass++) {
+        const std::string& s = pass ? frames : buf;
+        offset = 0;
+        for (const auto& obj : objs) {
+            BOOST_CHECK(pmt::equal(obj, pmt::deserialize(sb)));
+            BOOST_CHECK(pmt::equal(
+                obj, pmt::deserialize_buffer(&s[offset], s.size() - offset, used)));
+            offset += used;
+        }
+        BOOST_CHECK_EQUAL(s.size(), offset);
+    }
+    BOOST_CHECK(pmt::eq(pmt::PMT_EOF, pmt::deserialize(sb)));
+    BOOST_CHECK(pmt::eq(pmt::PMT_EOF, pmt::deserialize_buffer(buf.data(), 0, used)));
+    BOOST_CHECK_EQUAL(size_t(0), used);
+
+    // u8vectors read out of a shared buffer refer to it
+    std::string frame;
+    pmt::serialize_frame(pmt::cons(pmt::make_dict(), pmt::make_u8vector(64, 1)), frame);
+    std::shared_ptr<uint8_t> shared(new uint8_t[frame.size()],
+                                    std::default_delete<uint8_t[]>());
+    memcpy(shared.get(), frame.data(), frame.size());
+    pmt::pmt_t pdu = pmt::deserialize_buffer(shared, frame.size(), used);
+    BOOST_CHECK_EQUAL(frame.size(), used);
+    size_t len;
+    const uint8_t* payload = pmt::u8vector_elements(pmt::cdr(pdu), len);
+    BOOST_CHECK_EQUAL(size_t(64), len);
+    BOOST_CHECK(payload > shared.get() && payload + len <= shared.get() + frame.size());
+    BOOST_CHECK_EQUAL(2, shared.use_count());
+
+    // Truncated input
+    for (size_t n = 1; n < frame.size(); n += 7)
+        BOOST_CHECK_THROW(pmt::deserialize_buffer(frame.data(), n, used),
+                          pmt::exception);
+    BOOST_CHECK_THROW(pmt::deserialize_buffer(buf.data(), 10, used), pmt::exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_serialize_buffer_golden)
+{
+    // Hex of what serialize() wrote for each object before it was
+    // rewritten; the in-memory writers must not change the format.
+    const uint8_t u8[] = { 1, 2, 3, 4, 250 };
+    const int8_t s8[] = { -1, 2, -3 };
+    const uint16_t u16[] = { 1, 0x1234, 0xfffe };
+    const int16_t s16[] = { -2, 300 };
+    const uint32_t u32[] = { 0xdeadbeef, 5 };
+    const int32_t s32[] = { -7, 8 };
+    const uint64_t u64[] = { 0x0102030405060708ULL, 9 };
+    const int64_t s64[] = { -9, 10 };
+    const float f32[] = { 1.5f, -2.25f, 1e10f };
+    const double f64[] = { 1.5, -1e-300 };
+    const std::complex<float> c32[] = { { 1, 2 }, { -3, 4.5f } };
+    const std::complex<double> c64[] = { { 1, 2 }, { -3, 4.5 } };
+    pmt::pmt_t dict = pmt::make_dict();
+    dict = pmt::dict_add(dict, pmt::mp("k1"), pmt::from_long(1));
+    dict = pmt::dict_add(dict, pmt::mp("k2"), pmt::mp("v"));
+    pmt::pmt_t vec = pmt::make_vector(3, pmt::PMT_NIL);
+    pmt::vector_set(vec, 1, pmt::from_double(2));
+
+    const std::vector<std::pair<pmt::pmt_t, std::string>> golden = {
+        { pmt::PMT_T, "00" },
+        { pmt::PMT_F, "01" },
+        { pmt::PMT_NIL, "06" },
+        { pmt::mp("foobarvia"), "020009666f6f626172766961" },
+        { pmt::from_long(123456789), "03075bcd15" },
+        { pmt::from_long(-5), "03fffffffb" },
+        { pmt::from_long(1L << 40), "0d0000010000000000" },
+        { pmt::from_uint64(0x1122334455667788ULL), "0b1122334455667788" },
+        { pmt::from_double(3.25), "04400a000000000000" },
+        { pmt::make_rectangular(1.5, -2.5), "053ff8000000000000c004000000000000" },
+        { pmt::cons(pmt::mp("a"), pmt::mp("b")), "070200016102000162" },
+        { pmt::list3(pmt::mp("a"),
+                     pmt::list2(pmt::from_long(1), pmt::PMT_T),
+                     pmt::mp("c")),
+          "070200016107070300000001070006070200016306" },
+        { pmt::make_tuple(pmt::mp("x"), pmt::from_long(7)),
+          "0c00000002020001780300000007" },
+        { dict, "09070200026b320200017609070200026b31030000000106" },
+        { vec, "08000000030604400000000000000006" },
+        { pmt::init_u8vector(5, u8), "0a0000000005010001020304fa" },
+        { pmt::init_s8vector(3, s8), "0a01000000030100ff02fd" },
+        { pmt::init_u16vector(3, u16), "0a0200000003010000011234fffe" },
+        { pmt::init_s16vector(2, s16), "0a03000000020100fffe012c" },
+        { pmt::init_u32vector(2, u32), "0a04000000020100deadbeef00000005" },
+        { pmt::init_s32vector(2, s32), "0a05000000020100fffffff900000008" },
+        { pmt::init_u64vector(2, u64),
+          "0a0600000002010001020304050607080000000000000009" },
+        { pmt::init_s64vector(2, s64),
+          "0a07000000020100fffffffffffffff7000000000000000a" },
+        { pmt::init_f32vector(3, f32), "0a080000000301003fc00000c0100000501502f9" },
+        { pmt::init_f64vector(2, f64),
+          "0a090000000201003ff800000000000081a56e1fc2f8f359" },
+        { pmt::init_c32vector(2, c32),
+          "0a0a000000020100400000003f80000040900000c0400000" },
+        { pmt::init_c64vector(2, c64),
+          "0a0b0000000201003ff00000000000004000000000000000"
+          "c0080000000000004012000000000000" },
+        { pmt::make_f32vector(0, 0), "0a08000000000100" },
+        { pmt::make_blob("blob", 4), "0a00000000040100626c6f62" },
+        { pmt::cons(pmt::make_dict(), pmt::init_u8vector(5, u8)),
+          "07060a0000000005010001020304fa" },
+    };
+
+    for (const auto& g : golden) {
+        std::string bytes;
+        for (size_t i = 0; i < g.second.size(); i += 2)
+            bytes.push_back((char)std::stoul(g.second.substr(i, 2), nullptr, 16));
+
+        std::string buf;
+        pmt::serialize_append(g.first, buf);
+        BOOST_CHECK_EQUAL(bytes, buf);
+        std::stringbuf sb;
+        pmt::serialize(g.first, sb);
+        BOOST_CHECK_EQUAL(bytes, sb.str());
+
+        // A frame is PST_FRAME, version 1 and the big-endian length.
+        std::string frame;
+        pmt::serialize_frame(g.first, frame);
+        std::string header = { '\x0e', '\x01' };
+        for (int shift = 24; shift >= 0; shift -= 8)
+            header.push_back((char)(bytes.size() >> shift));
+        BOOST_CHECK_EQUAL(header + bytes, frame);
+
+        size_t used;
+        pmt::pmt_t obj = pmt::deserialize_buffer(bytes.data(), bytes.size(), used);
+        BOOST_CHECK(pmt::equal(g.first, obj));
+        BOOST_CHECK_EQUAL(bytes.size(), used);
+        obj = pmt::deserialize_buffer(frame.data(), frame.size(), used);
+        BOOST_CHECK(pmt::equal(g.first, obj));
+        BOOST_CHECK_EQUAL(frame.size(), used);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_sets)
 {
     pmt::pmt_t s1 = pmt::mp("s1");
@@ -595,3 +944,45 @@ BOOST_AUTO_TEST_CASE(test_sugar)
     BOOST_CHECK_EQUAL(sizeof(buf), nbytes);
     BOOST_CHECK(memcmp(buf, data, nbytes) == 0);
 }
+
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+    // pmts made by one thread and dropped by another, some of them
+    // only after the thread that made them is gone
+    static const long n = 100000;
+    std::vector<pmt::pmt_t> made(n);
+    boost::thread maker([&made]() {
+        for (long i = 0; i < n; i++) {
+            if (i % 3 == 0)
+                made[i] = pmt::from_long(i);
+            else if (i % 3 == 1)
+                made[i] = pmt::cons(pmt::from_long(i), pmt::PMT_NIL);
+            else
+                made[i] = pmt::make_s32vector(i % 300, i);
+        }
+    });
+    maker.join();
+
+    boost::thread dropper([&made]() {
+        for (long i = 0; i < n; i += 2)
+            made[i].reset();
+    });
+    dropper.join();
+
+    for (long i = 1; i < n; i += 2) {
+        if (i % 3 == 0)
+            BOOST_REQUIRE_EQUAL(i, pmt::to_long(made[i]));
+        else if (i % 3 == 1)
+            BOOST_REQUIRE_EQUAL(i, pmt::to_long(pmt::car(made[i])));
+        else
+            BOOST_REQUIRE_EQUAL(size_t(i % 300), pmt::length(made[i]));
+    }
+    made.clear();
+
+    // what went back to the first thread's pools gets used again
+    boost::thread reuser([]() {
+        for (long i = 0; i < n; i++)
+            BOOST_REQUIRE_EQUAL(i, pmt::to_long(pmt::from_long(i)));
+    });
+    reuser.join();
+}
@@ -14,9 +14,14 @@
 
 
 #include <gnuradio/buffer.h>
+#include <gnuradio/high_res_timer.h>
 #include <gnuradio/random.h>
+#include <gnuradio/thread/thread_group.h>
+#include <pmt/pmt.h>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <sstream>
 
 
 static void leak_check(void f())
@@ -249,6 +254,234 @@ static void t3_body()
     }
 }
 
+// ----------------------------------------------------------------------------
+// single writer, N readers, each in its own thread
+//
+// The indices are handed between threads without the mutex, so push a
+// lot of small chunks through and check that every reader sees every
+// item in order. Also report what a chunk costs, which is mostly index
+// traffic; that's the per-iteration overhead of a low latency chain.
+// ----------------------------------------------------------------------------
+
+static void t4_body()
+{
+    int nitems = 4096 / sizeof(int);
+    static const int N = 3;
+    static const int CHUNK = 16;
+    static const int TOTAL = 1 << 20;
+
+    gr::buffer_sptr buf(gr::make_buffer(nitems, sizeof(int), gr::block_sptr()));
+    gr::buffer_reader_sptr reader[N];
+    int nerrors[N];
+
+    for (int i = 0; i < N; i++) {
+        nerrors[i] = 0;
+        reader[i] = buffer_add_reader(buf, 0, gr::block_sptr());
+    }
+
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+
+    gr::thread::thread_group threads;
+    for (int r = 0; r < N; r++) {
+        threads.create_thread([&, r]() {
+            int read_counter = 0;
+            while (read_counter < TOTAL) {
+                int m = std::min(reader[r]->items_available(), CHUNK);
+                if (m == 0) {
+                    boost::this_thread::yield();
+                    continue;
+                }
+                const int* rp = (const int*)reader[r]->read_pointer();
+                for (int i = 0; i < m; i++) {
+                    if (*rp++ != read_counter++)
+                        nerrors[r]++;
+                }
+                reader[r]->update_read_pointer(m);
+            }
+        });
+    }
+
+    int write_counter = 0;
+    while (write_counter < TOTAL) {
+        int n = std::min(buf->space_available(), CHUNK);
+        n = std::min(n, TOTAL - write_counter);
+        if (n == 0) {
+            boost::this_thread::yield();
+            continue;
+        }
+        int* wp = (int*)buf->write_pointer();
+        for (int i = 0; i < n; i++)
+            *wp++ = write_counter++;
+        buf->update_write_pointer(n);
+    }
+    threads.join_all();
+
+    double secs = (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+    std::ostringstream msg;
+    msg << "t4: " << TOTAL << " items in chunks of " << CHUNK << " to " << N
+        << " readers, " << 1e9 * secs / (TOTAL / CHUNK) << " ns per chunk";
+    BOOST_TEST_MESSAGE(msg.str());
+
+    for (int r = 0; r < N; r++) {
+        BOOST_CHECK_EQUAL(0, nerrors[r]);
+        BOOST_CHECK_EQUAL(TOTAL, (int)reader[r]->nitems_read());
+    }
+    BOOST_CHECK_EQUAL(TOTAL, (int)buf->nitems_written());
+}
+
+// ----------------------------------------------------------------------------
+// tags: out of order adds, removal by one block, pruning
+// ----------------------------------------------------------------------------
+
+static gr::tag_t make_tag(uint64_t offset, long value)
+{
+    gr::tag_t t;
+    t.offset = offset;
+    t.key = pmt::mp("key");
+    t.value = pmt::from_long(value);
+    return t;
+}
+
+static void t5_body()
+{
+    int nitems = 4096 / sizeof(int);
+    gr::buffer_sptr buf(gr::make_buffer(nitems, sizeof(int), gr::block_sptr()));
+    gr::buffer_reader_sptr r1(gr::buffer_add_reader(buf, 0, gr::block_sptr()));
+    std::vector<gr::tag_t> v;
+
+    buf->add_item_tag(make_tag(10, 0));
+    buf->add_item_tag(make_tag(30, 1));
+    buf->add_item_tag(make_tag(20, 2)); // goes in the middle
+    buf->add_item_tag(make_tag(20, 3)); // after the other 20
+    buf->add_item_tag(make_tag(0, 4));  // goes in front
+
+    r1->get_tags_in_range(v, 0, 100, 0);
+    BOOST_REQUIRE_EQUAL(5, (int)v.size());
+    long expected[] = { 4, 0, 2, 3, 1 };
+    for (int i = 0; i < 5; i++)
+        BOOST_CHECK_EQUAL(expected[i], pmt::to_long(v[i].value));
+    gr::tag_t first_20 = v[2];
+
+    r1->get_tags_in_range(v, 10, 30, 0);
+    BOOST_CHECK_EQUAL(3, (int)v.size());
+
+    // Removed only as far as block 7 is concerned, even after the
+    // store has shuffled things around.
+    buf->remove_item_tag(first_20, 7);
+    buf->add_item_tag(make_tag(15, 5));
+    r1->get_tags_in_range(v, 20, 21, 7);
+    BOOST_REQUIRE_EQUAL(1, (int)v.size());
+    BOOST_CHECK_EQUAL(3, pmt::to_long(v[0].value));
+    r1->get_tags_in_range(v, 20, 21, 0);
+    BOOST_CHECK_EQUAL(2, (int)v.size());
+
+    // Tags are kept until they're a buffer's worth behind.
+    buf->prune_tags(buf->bufsize() + 20);
+    r1->get_tags_in_range(v, 0, 100, 0);
+    BOOST_REQUIRE_EQUAL(3, (int)v.size());
+    BOOST_CHECK_EQUAL(20, (int)v[0].offset);
+    buf->prune_tags(2 * buf->bufsize());
+    r1->get_tags_in_range(v, 0, 100, 0);
+    BOOST_CHECK_EQUAL(0, (int)v.size());
+}
+
+// ----------------------------------------------------------------------------
+// in-place: the alias shares memory, and its readers hold back the writer
+// ----------------------------------------------------------------------------
+
+static void t6_body()
+{
+    int nitems = 4000 / sizeof(int);
+    int counter = 0;
+
+    gr::buffer_sptr buf(gr::make_buffer(nitems, sizeof(int), gr::block_sptr()));
+    gr::buffer_reader_sptr r1(gr::buffer_add_reader(buf, 0, gr::block_sptr()));
+    gr::buffer_sptr alias(gr::make_buffer_inplace(buf, gr::block_sptr()));
+    gr::buffer_reader_sptr r2(gr::buffer_add_reader(alias, 0, gr::block_sptr()));
+
+    BOOST_CHECK(alias->inplace_of() == buf);
+    BOOST_CHECK_EQUAL(buf->bufsize(), alias->bufsize());
+    BOOST_CHECK_EQUAL(buf->write_pointer(), alias->write_pointer());
+
+    int sa = buf->space_available();
+    BOOST_REQUIRE(sa > 0);
+    int* p = (int*)buf->write_pointer();
+    for (int i = 0; i < sa; i++)
+        *p++ = counter++;
+    buf->update_write_pointer(sa);
+
+    // Reading the items doesn't free them up: they're now the alias's.
+    BOOST_REQUIRE_EQUAL(sa, r1->items_available());
+    int* q = (int*)r1->read_pointer();
+    r1->update_read_pointer(sa);
+    BOOST_CHECK_EQUAL(0, buf->space_available());
+
+    // Work in place, then hand the items on.
+    BOOST_CHECK_EQUAL((void*)q, alias->write_pointer());
+    for (int i = 0; i < sa; i++)
+        q[i] = -q[i];
+    alias->update_write_pointer(sa);
+
+    BOOST_REQUIRE_EQUAL(sa, r2->items_available());
+    const int* rp = (const int*)r2->read_pointer();
+    for (int i = 0; i < sa; i++)
+        BOOST_CHECK_EQUAL(-i, rp[i]);
+    r2->update_read_pointer(sa);
+    BOOST_CHECK_EQUAL(sa, buf->space_available());
+}
+
+// ----------------------------------------------------------------------------
+// holds: held items are kept from the writer until the last reference goes
+// ----------------------------------------------------------------------------
+
+static void t7_body()
+{
+    int nitems = 4000 / sizeof(int);
+
+    gr::buffer_sptr buf(gr::make_buffer(nitems, sizeof(int), gr::block_sptr()));
+    gr::buffer_reader_sptr r1(gr::buffer_add_reader(buf, 0, gr::block_sptr()));
+    int half = buf->bufsize() / 2;
+
+    int* p = (int*)buf->write_pointer();
+    for (int i = 0; i < 100; i++)
+        *p++ = i;
+    buf->update_write_pointer(100);
+
+    std::shared_ptr<uint8_t> h1 = r1->hold(10, 10);
+    BOOST_REQUIRE(h1);
+    BOOST_CHECK_EQUAL((const void*)h1.get(), (const int*)r1->read_pointer() + 10);
+    r1->update_read_pointer(100);
+    BOOST_CHECK_EQUAL(buf->bufsize() - 90 - 1, buf->space_available());
+
+    // A pmt sharing the hold keeps it after the pointer is gone.
+    pmt::pmt_t v = pmt::make_u8vector_view(10 * sizeof(int), h1);
+    h1.reset();
+    BOOST_CHECK_EQUAL(buf->bufsize() - 90 - 1, buf->space_available());
+    v.reset();
+    BOOST_CHECK_EQUAL(buf->bufsize() - 1, buf->space_available());
+
+    // Holds may not span more than half the buffer between them.
+    BOOST_CHECK(!r1->hold(0, half + 1));
+    h1 = r1->hold(0, 10);
+    std::shared_ptr<uint8_t> h2 = r1->hold(half - 10, 10);
+    BOOST_CHECK(h2);
+    BOOST_CHECK(!r1->hold(half - 9, 10));
+    h1.reset();
+    BOOST_CHECK(r1->hold(half - 9, 10));
+
+    // The writer's side: hold what it is about to produce.
+    std::shared_ptr<uint8_t> h3 = gr::buffer_hold_output(buf, 0, 10);
+    BOOST_CHECK(!h3); // spans too much with h2 still held
+    h2.reset();
+    h3 = gr::buffer_hold_output(buf, 0, 10);
+    BOOST_REQUIRE(h3);
+    BOOST_CHECK_EQUAL((void*)h3.get(), buf->write_pointer());
+    buf->update_write_pointer(10);
+    r1->update_read_pointer(10);
+    BOOST_CHECK_EQUAL(buf->bufsize() - 10 - 1, buf->space_available());
+}
+
+
 
 // ----------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(t0) { leak_check(t0_body); }
@@ -258,3 +491,11 @@ BOOST_AUTO_TEST_CASE(t1) { leak_check(t1_body); }
 BOOST_AUTO_TEST_CASE(t2) { leak_check(t2_body); }
 
 BOOST_AUTO_TEST_CASE(t3) { leak_check(t3_body); }
+
+BOOST_AUTO_TEST_CASE(t4) { leak_check(t4_body); }
+
+BOOST_AUTO_TEST_CASE(t5) { leak_check(t5_body); }
+
+BOOST_AUTO_TEST_CASE(t6) { leak_check(t6_body); }
+
+BOOST_AUTO_TEST_CASE(t7) { leak_check(t7_body); }
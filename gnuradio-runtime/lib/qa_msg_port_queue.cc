@@ -0,0 +1,287 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/msg_port_queue.h>
+#include <gnuradio/thread/thread_group.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+using gr::msg_port_queue;
+
+BOOST_AUTO_TEST_CASE(t0_fifo)
+{
+    msg_port_queue q(5, msg_port_queue::DROP_NEWEST);
+    BOOST_CHECK_EQUAL(8u, q.capacity());
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK(!q.pop());
+
+    for (long i = 0; i < 3; i++)
+        BOOST_CHECK(q.push(pmt::from_long(i)));
+    BOOST_CHECK_EQUAL(3u, q.size());
+    for (long i = 0; i < 3; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(q.pop()));
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK_EQUAL(3u, q.npushed());
+}
+
+BOOST_AUTO_TEST_CASE(t1_drop_newest)
+{
+    msg_port_queue q(4, msg_port_queue::DROP_NEWEST);
+    for (long i = 0; i < 6; i++)
+        q.push(pmt::from_long(i));
+
+    BOOST_CHECK_EQUAL(4u, q.size());
+    BOOST_CHECK_EQUAL(6u, q.npushed());
+    BOOST_CHECK_EQUAL(2u, q.ndropped());
+    for (long i = 0; i < 4; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(q.pop()));
+}
+
+BOOST_AUTO_TEST_CASE(t2_drop_oldest)
+{
+    msg_port_queue q(4, msg_port_queue::DROP_OLDEST);
+    for (long i = 0; i < 6; i++)
+        q.push(pmt::from_long(i));
+
+    BOOST_CHECK_EQUAL(4u, q.size());
+    BOOST_CHECK_EQUAL(2u, q.ndropped());
+    for (long i = 2; i < 6; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(q.pop()));
+}
+
+BOOST_AUTO_TEST_CASE(t3_block)
+{
+    const long nmsgs = 10000;
+    msg_port_queue q(16, msg_port_queue::BLOCK);
+
+    // Several producers, each pushing an increasing sequence; nothing
+    // may be lost or reordered within a producer.
+    gr::thread::thread_group producers;
+    for (long p = 0; p < 3; p++) {
+        producers.create_thread([&q, p, nmsgs]() {
+            for (long i = 0; i < nmsgs; i++)
+                q.push(pmt::cons(pmt::from_long(p), pmt::from_long(i)));
+        });
+    }
+
+    std::vector<long> next(3, 0);
+    for (long n = 0; n < 3 * nmsgs;) {
+        pmt::pmt_t msg = q.pop();
+        if (!msg) {
+            gr::thread::thread::yield();
+            continue;
+        }
+        long p = pmt::to_long(pmt::car(msg));
+        BOOST_REQUIRE_EQUAL(next[p], pmt::to_long(pmt::cdr(msg)));
+        next[p]++;
+        n++;
+    }
+    producers.join_all();
+
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK_EQUAL(0u, q.ndropped());
+    BOOST_CHECK_EQUAL(static_cast<uint64_t>(3 * nmsgs), q.npushed());
+}
+
+BOOST_AUTO_TEST_CASE(t4_block_interrupt)
+{
+    msg_port_queue q(2, msg_port_queue::BLOCK);
+    q.push(pmt::PMT_T);
+    q.push(pmt::PMT_T);
+
+    std::atomic<bool> interrupted(false);
+    gr::thread::thread producer([&q, &interrupted]() {
+        try {
+            q.push(pmt::PMT_F);
+        } catch (boost::thread_interrupted&) {
+            interrupted = true;
+        }
+    });
+    while (q.nblocked() == 0)
+        gr::thread::thread::yield();
+    producer.interrupt();
+    producer.join();
+
+    BOOST_CHECK(interrupted);
+    BOOST_CHECK_EQUAL(2u, q.size());
+}
+
+BOOST_AUTO_TEST_CASE(t5_pop_batch)
+{
+    msg_port_queue q(16, msg_port_queue::DROP_NEWEST);
+    std::vector<pmt::pmt_t> msgs;
+    BOOST_CHECK_EQUAL(0u, q.pop(msgs, 8));
+
+    for (long i = 0; i < 10; i++)
+        q.push(pmt::from_long(i));
+    BOOST_CHECK_EQUAL(4u, q.pop(msgs, 4));
+    BOOST_CHECK_EQUAL(6u, q.pop(msgs, 100)); // appends
+    BOOST_REQUIRE_EQUAL(10u, msgs.size());
+    for (long i = 0; i < 10; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(msgs[i]));
+    BOOST_CHECK(q.empty());
+
+    // Wraps around the ring.
+    msgs.clear();
+    for (long i = 0; i < 16; i++)
+        q.push(pmt::from_long(i));
+    BOOST_CHECK_EQUAL(16u, q.pop(msgs, q.capacity()));
+    BOOST_CHECK_EQUAL(15, pmt::to_long(msgs.back()));
+}
+
+BOOST_AUTO_TEST_CASE(t6_pop_batch_block)
+{
+    const long nmsgs = 10000;
+    msg_port_queue q(16, msg_port_queue::BLOCK);
+
+    gr::thread::thread_group producers;
+    for (long p = 0; p < 3; p++) {
+        producers.create_thread([&q, p, nmsgs]() {
+            for (long i = 0; i < nmsgs; i++)
+                q.push(pmt::cons(pmt::from_long(p), pmt::from_long(i)));
+        });
+    }
+
+    std::vector<long> next(3, 0);
+    std::vector<pmt::pmt_t> msgs;
+    for (long n = 0; n < 3 * nmsgs;) {
+        msgs.clear();
+        if (!q.pop(msgs, 5)) {
+            gr::thread::thread::yield();
+            continue;
+        }
+        for (const pmt::pmt_t& msg : msgs) {
+            long p = pmt::to_long(pmt::car(msg));
+            BOOST_REQUIRE_EQUAL(next[p], pmt::to_long(pmt::cdr(msg)));
+            next[p]++;
+        }
+        n += msgs.size();
+    }
+    producers.join_all();
+
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK_EQUAL(0u, q.ndropped());
+}
+
+BOOST_AUTO_TEST_CASE(t7_policy_names)
+{
+    BOOST_CHECK_EQUAL(msg_port_queue::BLOCK, msg_port_queue::policy_from_string("block"));
+    BOOST_CHECK_EQUAL(msg_port_queue::DROP_OLDEST,
+                      msg_port_queue::policy_from_string("drop_oldest"));
+    BOOST_CHECK_EQUAL(msg_port_queue::DROP_NEWEST,
+                      msg_port_queue::policy_from_string("drop_newest"));
+    BOOST_CHECK_EQUAL(msg_port_queue::GROW, msg_port_queue::policy_from_string("grow"));
+    BOOST_CHECK_THROW(msg_port_queue::policy_from_string("drop_all"),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(t8_grow)
+{
+    msg_port_queue q(4, msg_port_queue::GROW);
+    for (long i = 0; i < 10; i++)
+        BOOST_CHECK(q.push(pmt::from_long(i)));
+    BOOST_CHECK_EQUAL(10u, q.size());
+    BOOST_CHECK_EQUAL(0u, q.ndropped());
+
+    // Pushes after a pop still go behind the overflow.
+    BOOST_CHECK_EQUAL(0, pmt::to_long(q.pop()));
+    q.push(pmt::from_long(10));
+
+    std::vector<pmt::pmt_t> msgs;
+    BOOST_CHECK_EQUAL(6u, q.pop(msgs, 6));
+    BOOST_CHECK_EQUAL(4u, q.pop(msgs, 100));
+    BOOST_REQUIRE_EQUAL(10u, msgs.size());
+    for (long i = 0; i < 10; i++)
+        BOOST_CHECK_EQUAL(i + 1, pmt::to_long(msgs[i]));
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(t9_grow_threads)
+{
+    const long nmsgs = 10000;
+    msg_port_queue q(16, msg_port_queue::GROW);
+
+    gr::thread::thread_group producers;
+    for (long p = 0; p < 3; p++) {
+        producers.create_thread([&q, p, nmsgs]() {
+            for (long i = 0; i < nmsgs; i++)
+                q.push(pmt::cons(pmt::from_long(p), pmt::from_long(i)));
+        });
+    }
+
+    std::vector<long> next(3, 0);
+    for (long n = 0; n < 3 * nmsgs;) {
+        pmt::pmt_t msg = q.pop();
+        if (!msg) {
+            gr::thread::thread::yield();
+            continue;
+        }
+        long p = pmt::to_long(pmt::car(msg));
+        BOOST_REQUIRE_EQUAL(next[p], pmt::to_long(pmt::cdr(msg)));
+        next[p]++;
+        n++;
+    }
+    producers.join_all();
+
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK_EQUAL(0u, q.ndropped());
+}
+
+BOOST_AUTO_TEST_CASE(t10_set_capacity)
+{
+    msg_port_queue q(4, msg_port_queue::DROP_NEWEST);
+    for (long i = 0; i < 4; i++)
+        q.push(pmt::from_long(i));
+
+    // Beyond the ring, and back down below what is queued.
+    q.set_capacity(7);
+    BOOST_CHECK_EQUAL(8u, q.capacity());
+    for (long i = 4; i < 10; i++)
+        q.push(pmt::from_long(i));
+    BOOST_CHECK_EQUAL(8u, q.size());
+    BOOST_CHECK_EQUAL(2u, q.ndropped());
+
+    q.set_capacity(2);
+    BOOST_CHECK(!q.push(pmt::from_long(10)));
+    BOOST_CHECK_EQUAL(8u, q.size());
+    for (long i = 0; i < 8; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(q.pop()));
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(t11_hold_all)
+{
+    msg_port_queue q(4, msg_port_queue::GROW);
+    for (long i = 0; i < 6; i++)
+        q.push(pmt::from_long(i));
+
+    // The ring's four, then the two behind it.
+    std::deque<pmt::pmt_t>& held = q.hold_all();
+    BOOST_CHECK_EQUAL(6u, held.size());
+    BOOST_CHECK_EQUAL(6u, q.size());
+
+    q.erase_held(held.begin() + 1);
+    q.push(pmt::from_long(6));
+    BOOST_CHECK_EQUAL(6u, q.size());
+
+    std::vector<pmt::pmt_t> msgs;
+    BOOST_CHECK_EQUAL(2u, q.pop(msgs, 2));
+    BOOST_CHECK_EQUAL(0, pmt::to_long(msgs[0]));
+    BOOST_CHECK_EQUAL(2, pmt::to_long(msgs[1]));
+    for (long i = 3; i < 7; i++)
+        BOOST_CHECK_EQUAL(i, pmt::to_long(q.pop()));
+    BOOST_CHECK(q.empty());
+}
@@ -14,6 +14,7 @@
 
 #include "vmcircbuf.h"
 #include <boost/test/unit_test.hpp>
+#include <memory>
 
 BOOST_AUTO_TEST_CASE(test_all)
 {
@@ -21,3 +22,26 @@ BOOST_AUTO_TEST_CASE(test_all)
 
     BOOST_REQUIRE(gr::vmcircbuf_sysconfig::test_all_factories(verbose));
 }
+
+#ifdef HAVE_MEMFD_CREATE
+#include "vmcircbuf_memfd.h"
+
+BOOST_AUTO_TEST_CASE(test_memfd_huge_near)
+{
+    // A whole number of huge pages, so the huge page path gets tried.
+    const int size = 4 << 20;
+    std::unique_ptr<gr::vmcircbuf> c(
+        gr::vmcircbuf_memfd_factory::singleton()->make_near(size, { 0 }));
+    BOOST_REQUIRE(c);
+
+    int* p = (int*)c->pointer_to_first_copy();
+    int* q = (int*)c->pointer_to_second_copy();
+    BOOST_CHECK_EQUAL((char*)q - (char*)p, size);
+
+    const int n = size / sizeof(int);
+    for (int i = 0; i < n; i += 1024)
+        p[i] = i;
+    for (int i = 0; i < n; i += 1024)
+        BOOST_CHECK_EQUAL(q[i], i);
+}
+#endif
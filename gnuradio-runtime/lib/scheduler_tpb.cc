@@ -16,6 +16,7 @@
 #include "tpb_thread_body.h"
 #include <gnuradio/thread/thread_body_wrapper.h>
 #include <boost/make_shared.hpp>
+#include <set>
 #include <sstream>
 
 namespace gr {
@@ -40,6 +41,28 @@ public:
     }
 };
 
+class tpb_fused_container
+{
+    block_vector_t d_blocks;
+    int d_max_noutput_items;
+    thread::barrier_sptr d_start_sync;
+
+public:
+    tpb_fused_container(const block_vector_t& blocks,
+                        int max_noutput_items,
+                        thread::barrier_sptr start_sync)
+        : d_blocks(blocks),
+          d_max_noutput_items(max_noutput_items),
+          d_start_sync(start_sync)
+    {
+    }
+
+    void operator()()
+    {
+        tpb_fused_thread_body body(d_blocks, d_start_sync, d_max_noutput_items);
+    }
+};
+
 scheduler_sptr
 scheduler_tpb::make(flat_flowgraph_sptr ffg, int max_noutput_items, bool catch_exceptions)
 {
@@ -67,12 +90,36 @@ scheduler_tpb::scheduler_tpb(flat_flowgraph_sptr ffg,
         blocks[i]->detail()->set_done(false);
     }
 
-    thread::barrier_sptr start_sync =
-        std::make_shared<thread::barrier>(blocks.size() + 1);
+    // Blocks in a fused chain share a thread.
+    std::vector<block_vector_t> chains = ffg->fused_chains();
+    std::set<block_sptr> fused;
+    size_t nthreads = blocks.size();
+    for (const block_vector_t& chain : chains) {
+        fused.insert(chain.begin(), chain.end());
+        nthreads -= chain.size() - 1;
+    }
+
+    thread::barrier_sptr start_sync = std::make_shared<thread::barrier>(nthreads + 1);
 
-    // Fire off a thead for each block
+    // Fire off a thead for each chain...
+
+    for (size_t i = 0; i < chains.size(); i++) {
+        std::stringstream name;
+        name << "thread-per-block[fused " << i << "]: " << chains[i].front() << " + "
+             << chains[i].size() - 1;
+
+        d_threads.create_thread(thread::thread_body_wrapper<tpb_fused_container>(
+            tpb_fused_container(chains[i], max_noutput_items, start_sync),
+            name.str(),
+            catch_exceptions));
+    }
+
+    // ...and for each block not in one
 
     for (size_t i = 0; i < blocks.size(); i++) {
+        if (fused.count(blocks[i]))
+            continue;
+
         std::stringstream name;
         name << "thread-per-block[" << i << "]: " << blocks[i];
 
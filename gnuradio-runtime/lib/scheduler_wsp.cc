@@ -0,0 +1,408 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "scheduler_wsp.h"
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <gnuradio/prefs.h>
+#include <gnuradio/thread/thread_body_wrapper.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <sstream>
+
+namespace gr {
+
+scheduler_sptr
+scheduler_wsp::make(flat_flowgraph_sptr ffg, int max_noutput_items, bool catch_exceptions)
+{
+    return scheduler_sptr(new scheduler_wsp(ffg, max_noutput_items, catch_exceptions));
+}
+
+scheduler_wsp::scheduler_wsp(flat_flowgraph_sptr ffg,
+                             int max_noutput_items,
+                             bool catch_exceptions)
+    : scheduler(ffg, max_noutput_items, catch_exceptions),
+      d_catch_exceptions(catch_exceptions),
+      d_nqueued(0),
+      d_nrunning(0),
+      d_stop(false),
+      d_nidle(0),
+      d_cleaned_up(false)
+{
+    gr::configure_default_loggers(d_logger, d_debug_logger, "scheduler_wsp");
+
+    int block_max_noutput_items;
+
+    basic_block_vector_t used_blocks = ffg->calc_used_blocks();
+    used_blocks = ffg->topological_sort(used_blocks);
+    block_vector_t blocks = flat_flowgraph::make_block_vector(used_blocks);
+
+    std::vector<block_vector_t> chains = ffg->fused_chains();
+    std::map<block*, const block_vector_t*> chain_of;
+    for (const block_vector_t& chain : chains) {
+        for (const block_sptr& b : chain)
+            chain_of[b.get()] = &chain;
+    }
+    size_t ntasks = blocks.size() - chain_of.size() + chains.size();
+
+    // Size the pool; there's no point in having more workers than tasks.
+    prefs* p = prefs::singleton();
+    long nthreads = p->get_long("Scheduler", "nthreads", 0);
+    if (nthreads <= 0)
+        nthreads = std::max(1u, boost::thread::hardware_concurrency());
+    nthreads = std::min(nthreads, static_cast<long>(ntasks));
+
+    for (long i = 0; i < nthreads; i++)
+        d_workers.emplace_back(new worker);
+
+    // Make a task per block. Constructing the executor starts the block.
+    std::map<block*, task*> task_of;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        blocks[i]->detail()->set_done(false);
+    }
+    for (size_t i = 0; i < blocks.size(); i++) {
+        // A chain gets one task, made when we come across its head.
+        auto c = chain_of.find(blocks[i].get());
+        if (c != chain_of.end()) {
+            const block_vector_t& chain = *c->second;
+            if (blocks[i] != chain.front())
+                continue;
+
+            std::unique_ptr<task> t(new task);
+            t->block = chain.front();
+            t->fused.reset(new fused_executor(chain, max_noutput_items));
+            t->state = IDLE;
+            t->home = d_tasks.size() % d_workers.size();
+
+            for (const block_sptr& b : chain)
+                task_of[b.get()] = t.get();
+            d_tasks.push_back(std::move(t));
+            continue;
+        }
+
+        // If set, use internal value instead of global value
+        if (blocks[i]->is_set_max_noutput_items()) {
+            block_max_noutput_items = blocks[i]->max_noutput_items();
+        } else {
+            block_max_noutput_items = max_noutput_items;
+        }
+
+        std::unique_ptr<task> t(new task);
+        t->block = blocks[i];
+        t->exec.reset(new block_executor(blocks[i], block_max_noutput_items));
+        t->state = IDLE;
+        t->home = d_tasks.size() % d_workers.size();
+
+        // make sure our block isn't finished
+        blocks[i]->clear_finished();
+
+        task_of[blocks[i].get()] = t.get();
+        d_tasks.push_back(std::move(t));
+    }
+
+    // Resolve stream neighbors once, so notifying them is cheap. A
+    // chain's upstream is its head's, its downstream its tail's.
+    for (const auto& t : d_tasks) {
+        block_detail* d = t->block->detail().get();
+
+        // Reading from an in-place buffer also frees space in the
+        // buffers it aliases.
+        for (int i = 0; i < d->ninputs(); i++) {
+            for (buffer_sptr buf = d->input(i)->buffer(); buf; buf = buf->inplace_of()) {
+                task* up = task_of[buf->link().get()];
+                if (up != t.get() && std::find(t->upstream.begin(),
+                                               t->upstream.end(),
+                                               up) == t->upstream.end())
+                    t->upstream.push_back(up);
+            }
+        }
+
+        if (t->fused)
+            d = t->fused->tail()->detail().get();
+        for (int i = 0; i < d->noutputs(); i++) {
+            buffer_sptr buf = d->output(i);
+            for (size_t j = 0; j < buf->nreaders(); j++) {
+                task* down = task_of[buf->reader(j)->link().get()];
+                if (std::find(t->downstream.begin(), t->downstream.end(), down) ==
+                    t->downstream.end())
+                    t->downstream.push_back(down);
+            }
+        }
+    }
+
+    // Get told about messages, and give every block a first look.
+    d_nrunning = d_tasks.size();
+    for (const auto& t : d_tasks) {
+        task* tp = t.get();
+        for (const block_sptr& b : task_blocks(tp)) {
+            b->detail()->d_tpb.set_msg_notify(
+                [this, tp]() { schedule(tp, tp->home, false); });
+        }
+        tp->state = QUEUED;
+        push(tp, tp->home, false);
+    }
+
+    for (size_t i = 0; i < d_workers.size(); i++) {
+        std::stringstream name;
+        name << "work-stealing-pool[" << i << "]";
+
+        d_threads.create_thread(thread::thread_body_wrapper<std::function<void()>>(
+            [this, i]() { run_worker(i); }, name.str(), catch_exceptions));
+    }
+}
+
+scheduler_wsp::~scheduler_wsp()
+{
+    stop();
+    wait();
+}
+
+void scheduler_wsp::stop()
+{
+    d_stop = true;
+    {
+        gr::thread::scoped_lock guard(d_idle_mutex);
+        d_idle_cond.notify_all();
+    }
+    d_threads.interrupt_all();
+}
+
+void scheduler_wsp::wait()
+{
+    d_threads.join_all();
+
+    // With the workers gone, stop whatever blocks didn't finish.
+    gr::thread::scoped_lock guard(d_idle_mutex);
+    if (d_cleaned_up)
+        return;
+    for (const auto& t : d_tasks) {
+        for (const block_sptr& b : task_blocks(t.get()))
+            b->detail()->d_tpb.set_msg_notify(std::function<void()>());
+        t->exec.reset();
+        t->fused.reset();
+    }
+    d_cleaned_up = true;
+}
+
+void scheduler_wsp::run_worker(size_t which)
+{
+    while (!d_stop && d_nrunning > 0) {
+        boost::this_thread::interruption_point();
+
+        task* t = pop_task(which);
+        if (t) {
+            run_task(t, which);
+            continue;
+        }
+
+        // Nothing to do. Announce that we're idle before looking at
+        // the queued count one more time; push() does the reverse,
+        // so one of us is sure to see the other.
+        gr::thread::scoped_lock guard(d_idle_mutex);
+        d_nidle++;
+        if (d_nqueued == 0 && !d_stop && d_nrunning > 0) {
+            d_idle_cond.wait(guard);
+        }
+        d_nidle--;
+    }
+}
+
+void scheduler_wsp::run_task(task* t, size_t which)
+{
+    block* m = t->block.get();
+    block_detail* d = m->detail().get();
+    block_executor::state s;
+
+    try {
+        if (t->fused) {
+            t->fused->dispatch_msgs();
+            s = t->fused->run_one_iteration();
+        } else {
+            // handle any queued up messages
+            t->exec->dispatch_msgs();
+
+            // run one iteration if we are a connected stream block
+            if (d->noutputs() > 0 || d->ninputs() > 0) {
+                s = t->exec->run_one_iteration();
+            } else {
+                s = block_executor::BLKD_IN;
+                // a msg port only block wants to shutdown
+                if (m->finished()) {
+                    s = block_executor::DONE;
+                }
+            }
+        }
+    } catch (std::exception const& e) {
+        if (!d_catch_exceptions)
+            throw;
+
+        // Take the failing block out of the graph rather than the worker.
+        GR_LOG_ERROR(d_logger,
+                     boost::format("ERROR block %s: %s") % m->identifier() % e.what());
+        for (const block_sptr& b : task_blocks(t))
+            b->detail()->set_done(true);
+        s = block_executor::DONE;
+    }
+
+    if (m->finished() && s == block_executor::READY_NO_OUTPUT) {
+        s = block_executor::DONE;
+        d->set_done(true);
+    }
+
+    switch (s) {
+    case block_executor::READY: // Tell neighbors we made progress.
+        for (task* n : t->downstream)
+            schedule(n, which, true);
+        for (task* n : t->upstream)
+            schedule(n, which, true);
+        t->state = QUEUED;
+        push(t, which, false);
+        break;
+
+    case block_executor::READY_NO_OUTPUT: // Notify upstream only
+        // A source that came up empty has nobody upstream to wake it,
+        // so it goes to the back of the line and tries again.
+        for (task* n : t->upstream)
+            schedule(n, which, true);
+        t->state = QUEUED;
+        push(t, which, false);
+        break;
+
+    case block_executor::DONE: // Game over.
+        finish(t, which);
+        break;
+
+    case block_executor::BLKD_IN:  // Wait for input.
+    case block_executor::BLKD_OUT: // Wait for output buffer space.
+    {
+        // Go idle, unless somebody notified us while we were running.
+        int running = RUNNING;
+        if (!t->state.compare_exchange_strong(running, IDLE)) {
+            t->state = QUEUED;
+            push(t, which, false);
+        }
+    } break;
+
+    default:
+        throw std::runtime_error("possible memory corruption in scheduler");
+    }
+}
+
+scheduler_wsp::task* scheduler_wsp::pop_task(size_t which)
+{
+    task* t = nullptr;
+
+    // Our own queue first, newest task first...
+    {
+        worker* w = d_workers[which].get();
+        gr::thread::scoped_lock guard(w->mutex);
+        if (!w->queue.empty()) {
+            t = w->queue.back();
+            w->queue.pop_back();
+        }
+    }
+
+    // ...then steal the oldest task from somebody else.
+    for (size_t i = 1; !t && i < d_workers.size(); i++) {
+        worker* w = d_workers[(which + i) % d_workers.size()].get();
+        gr::thread::scoped_lock guard(w->mutex);
+        if (!w->queue.empty()) {
+            t = w->queue.front();
+            w->queue.pop_front();
+        }
+    }
+
+    if (t) {
+        d_nqueued--;
+        t->state = RUNNING;
+    }
+    return t;
+}
+
+void scheduler_wsp::schedule(task* t, size_t which, bool hot)
+{
+    int s = t->state;
+    while (true) {
+        switch (s) {
+        case IDLE:
+            if (t->state.compare_exchange_weak(s, QUEUED)) {
+                push(t, which, hot);
+                return;
+            }
+            break;
+
+        case RUNNING:
+            // The worker running it will queue it again when it's done.
+            if (t->state.compare_exchange_weak(s, RUNNING_NOTIFIED))
+                return;
+            break;
+
+        default: // already queued, already notified or finished
+            return;
+        }
+    }
+}
+
+void scheduler_wsp::push(task* t, size_t which, bool hot)
+{
+    // Hot tasks go where the owner pops next: the data they need was
+    // just touched by this worker. Everything else waits its turn at
+    // the front, which is also where thieves look first.
+    {
+        worker* w = d_workers[which].get();
+        gr::thread::scoped_lock guard(w->mutex);
+        if (hot)
+            w->queue.push_back(t);
+        else
+            w->queue.push_front(t);
+    }
+
+    d_nqueued++;
+    if (d_nidle > 0) {
+        gr::thread::scoped_lock guard(d_idle_mutex);
+        d_idle_cond.notify_one();
+    }
+}
+
+block_vector_t scheduler_wsp::task_blocks(task* t)
+{
+    if (t->fused)
+        return t->fused->blocks();
+    return block_vector_t(1, t->block);
+}
+
+void scheduler_wsp::finish(task* t, size_t which)
+{
+    // A chain tells its blocks' message neighbors as each one finishes.
+    if (!t->fused)
+        t->block->notify_msg_neighbors();
+    t->state = FINISHED;
+
+    for (task* n : t->downstream)
+        schedule(n, which, true);
+    for (task* n : t->upstream)
+        schedule(n, which, true);
+
+    t->exec.reset(); // stop any drivers, etc.
+    t->fused.reset();
+
+    if (--d_nrunning == 0) {
+        gr::thread::scoped_lock guard(d_idle_mutex);
+        d_idle_cond.notify_all();
+    }
+}
+
+} /* namespace gr */
@@ -0,0 +1,126 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_GR_SCHEDULER_WSP_H
+#define INCLUDED_GR_SCHEDULER_WSP_H
+
+#include "block_executor.h"
+#include "fused_executor.h"
+#include "scheduler.h"
+#include <gnuradio/api.h>
+#include <gnuradio/logger.h>
+#include <gnuradio/thread/thread_group.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace gr {
+
+/*!
+ * \brief Concrete scheduler that runs all blocks on a fixed pool of
+ * work-stealing worker threads.
+ *
+ * Instead of giving each block its own kernel thread, each block
+ * becomes a task that is queued whenever one of its neighbors (or a
+ * message poster) says it may be able to make progress. Workers pop
+ * tasks from their own deque and steal from the others when it runs
+ * dry. A task is only ever run by one worker at a time, so blocks
+ * still see their work() and message handlers called from a single
+ * thread at any given moment.
+ *
+ * The pool size is set by the [Scheduler] nthreads preference; 0
+ * (the default) uses one worker per hardware thread. Per-block
+ * processor affinity and thread priority are not applied, since a
+ * block has no thread of its own.
+ *
+ * A chain from flat_flowgraph::fused_chains() becomes a single task.
+ */
+class GR_RUNTIME_API scheduler_wsp : public scheduler
+{
+public:
+    static scheduler_sptr make(flat_flowgraph_sptr ffg,
+                               int max_noutput_items = 100000,
+                               bool catch_exceptions = true);
+
+    ~scheduler_wsp() override;
+
+    /*!
+     * \brief Tell the scheduler to stop executing.
+     */
+    void stop() override;
+
+    /*!
+     * \brief Block until the graph is done.
+     */
+    void wait() override;
+
+protected:
+    /*!
+     * \brief Construct a scheduler and begin evaluating the graph.
+     *
+     * The scheduler will continue running until all blocks
+     * report that they are done or the stop method is called.
+     */
+    scheduler_wsp(flat_flowgraph_sptr ffg, int max_noutput_items, bool catch_exceptions);
+
+private:
+    enum task_state {
+        IDLE,             // waiting for a neighbor to notify us
+        QUEUED,           // sitting in a worker's deque
+        RUNNING,          // a worker is running an iteration
+        RUNNING_NOTIFIED, // running, and notified while doing so
+        FINISHED,         // block is done; never queued again
+    };
+
+    struct task {
+        block_sptr block; // or the first block of a fused chain
+        std::unique_ptr<block_executor> exec;
+        std::unique_ptr<fused_executor> fused; // instead of exec for a chain
+        std::atomic<int> state;
+        size_t home; // worker that message notifications go to
+        std::vector<task*> upstream;
+        std::vector<task*> downstream;
+    };
+
+    struct worker {
+        gr::thread::mutex mutex; // protects queue
+        std::deque<task*> queue; // owner pops at the back, thieves at the front
+    };
+
+    std::vector<std::unique_ptr<task>> d_tasks;
+    std::vector<std::unique_ptr<worker>> d_workers;
+    gr::thread::thread_group d_threads;
+    bool d_catch_exceptions;
+
+    std::atomic<int> d_nqueued;  // tasks sitting in some worker's deque
+    std::atomic<int> d_nrunning; // tasks that are not FINISHED
+    std::atomic<bool> d_stop;
+
+    gr::thread::mutex d_idle_mutex; // protects d_cleaned_up
+    gr::thread::condition_variable d_idle_cond;
+    std::atomic<int> d_nidle; // workers waiting on d_idle_cond
+    bool d_cleaned_up;
+
+    gr::logger_ptr d_logger;
+    gr::logger_ptr d_debug_logger;
+
+    void run_worker(size_t which);
+    void run_task(task* t, size_t which);
+    task* pop_task(size_t which);
+    void schedule(task* t, size_t which, bool hot);
+    void push(task* t, size_t which, bool hot);
+    void finish(task* t, size_t which);
+    static block_vector_t task_blocks(task* t);
+};
+
+} /* namespace gr */
+
+#endif /* INCLUDED_GR_SCHEDULER_WSP_H */
@@ -14,6 +14,7 @@
 
 #include "flat_flowgraph.h"
 #include "scheduler_tpb.h"
+#include "scheduler_wsp.h"
 #include "terminate_handler.h"
 #include "top_block_impl.h"
 #include <gnuradio/logger.h>
@@ -38,7 +39,8 @@ static struct scheduler_table {
     const char* name;
     scheduler_maker f;
 } scheduler_table[] = {
-    { "TPB", scheduler_tpb::make } // first entry is default
+    { "TPB", scheduler_tpb::make }, // first entry is default
+    { "WSP", scheduler_wsp::make }
 };
 
 static scheduler_sptr
@@ -47,7 +49,11 @@ make_scheduler(flat_flowgraph_sptr ffg, int max_noutput_items, bool catch_except
     static scheduler_maker factory = 0;
 
     if (factory == 0) {
-        char* v = getenv("GR_SCHEDULER");
+        // The environment overrides the [Scheduler] type preference.
+        std::string pref = prefs::singleton()->get_string("Scheduler", "type", "");
+        const char* v = getenv("GR_SCHEDULER");
+        if (!v && !pref.empty())
+            v = pref.c_str();
         if (!v)
             factory = scheduler_table[0].f; // use default
         else {
@@ -62,7 +68,7 @@ make_scheduler(flat_flowgraph_sptr ffg, int max_noutput_items, bool catch_except
                 gr::logger_ptr logger, debug_logger;
                 gr::configure_default_loggers(logger, debug_logger, "top_block_impl");
                 std::ostringstream msg;
-                msg << "Invalid GR_SCHEDULER environment variable value \"" << v
+                msg << "Invalid GR_SCHEDULER or [Scheduler] type value \"" << v
                     << "\".  Using \"" << scheduler_table[0].name << "\"";
                 GR_LOG_WARN(logger, msg.str());
                 factory = scheduler_table[0].f;
@@ -32,7 +32,12 @@ void tpb_detail::notify_upstream(block_detail* d)
 
     for (size_t i = 0; i < d->d_input.size(); i++) {
         // Can you say, "pointer chasing?"
-        d->d_input[i]->buffer()->link()->detail()->d_tpb.set_output_changed();
+        buffer_sptr buf = d->d_input[i]->buffer();
+        buf->link()->detail()->d_tpb.set_output_changed();
+
+        // An in-place buffer shares its space with the ones it aliases.
+        for (buffer_sptr b = buf->inplace_of(); b; b = b->inplace_of())
+            b->link()->detail()->d_tpb.set_output_changed();
     }
 }
 
@@ -42,7 +47,7 @@ void tpb_detail::notify_downstream(block_detail* d)
     // have new input available.
 
     for (size_t i = 0; i < d->d_output.size(); i++) {
-        buffer_sptr buf = d->d_output[i];
+        const buffer_sptr& buf = d->d_output[i];
         for (size_t j = 0, k = buf->nreaders(); j < k; j++)
             buf->reader(j)->link()->detail()->d_tpb.set_input_changed();
     }
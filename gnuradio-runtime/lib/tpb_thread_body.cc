@@ -40,13 +40,11 @@ tpb_thread_body::tpb_thread_body(block_sptr block,
 
     block_detail* d = block->detail().get();
     block_executor::state s;
-    pmt::pmt_t msg;
 
     d->threaded = true;
     d->thread = gr::thread::get_current_thread_id();
 
     prefs* p = prefs::singleton();
-    size_t max_nmsgs = static_cast<size_t>(p->get_long("DEFAULT", "max_messages", 100));
 
 // Setup the logger for the scheduler
 #undef LOG
@@ -86,24 +84,7 @@ tpb_thread_body::tpb_thread_body(block_sptr block,
         d->d_tpb.clear_changed();
 
         // handle any queued up messages
-        for (const auto& i : block->msg_queue) {
-            // Check if we have a message handler attached before getting
-            // any messages. This is mostly a protection for the unknown
-            // startup sequence of the threads.
-            if (block->has_msg_handler(i.first)) {
-                while ((msg = block->delete_head_nowait(i.first))) {
-                    block->dispatch_msg(i.first, msg);
-                }
-            } else {
-                // If we don't have a handler but are building up messages,
-                // prune the queue from the front to keep memory in check.
-                if (block->nmsgs(i.first) > max_nmsgs) {
-                    GR_LOG_WARN(
-                        LOG, "asynchronous message buffer overflowing, dropping message");
-                    msg = block->delete_head_nowait(i.first);
-                }
-            }
-        }
+        d_exec.dispatch_msgs();
 
         // run one iteration if we are a connected stream block
         if (d->noutputs() > 0 || d->ninputs() > 0) {
@@ -121,16 +102,15 @@ tpb_thread_body::tpb_thread_body(block_sptr block,
             d->set_done(true);
         }
 
-        if (!d->ninputs() && s == block_executor::READY_NO_OUTPUT) {
-            s = block_executor::BLKD_IN;
-        }
-
         switch (s) {
         case block_executor::READY: // Tell neighbors we made progress.
             d->d_tpb.notify_neighbors(d);
             break;
 
         case block_executor::READY_NO_OUTPUT: // Notify upstream only
+            // A source that came up empty (one that timed out waiting on
+            // a socket in work(), say) has nobody upstream to wake it, so
+            // it just goes round again.
             d->d_tpb.notify_upstream(d);
             break;
 
@@ -141,21 +121,24 @@ tpb_thread_body::tpb_thread_body(block_sptr block,
 
         case block_executor::BLKD_IN: // Wait for input.
         {
+            // Upstream blocks and message posters (notify_msg) both
+            // signal input_cond, so there is nothing to poll for.
             gr::thread::scoped_lock guard(d->d_tpb.mutex);
-
-            if (!d->d_tpb.input_changed) {
-                boost::system_time const timeout =
-                    boost::get_system_time() + boost::posix_time::milliseconds(250);
-                d->d_tpb.input_cond.timed_wait(guard, timeout);
+            d->d_tpb.input_waiting = true;
+            while (!d->d_tpb.input_changed) {
+                d->d_tpb.input_cond.wait(guard);
             }
+            d->d_tpb.input_waiting = false;
         } break;
 
         case block_executor::BLKD_OUT: // Wait for output buffer space.
         {
             gr::thread::scoped_lock guard(d->d_tpb.mutex);
+            d->d_tpb.output_waiting = true;
             while (!d->d_tpb.output_changed) {
                 d->d_tpb.output_cond.wait(guard);
             }
+            d->d_tpb.output_waiting = false;
         } break;
 
         default:
@@ -166,4 +149,104 @@ tpb_thread_body::tpb_thread_body(block_sptr block,
 
 tpb_thread_body::~tpb_thread_body() {}
 
+namespace {
+
+// Points the chain's notifications at the head while the thread runs,
+// and puts them back however it ends.
+class fused_notify_guard
+{
+    const block_vector_t& d_blocks;
+
+public:
+    fused_notify_guard(const block_vector_t& blocks) : d_blocks(blocks)
+    {
+        tpb_detail* head = &d_blocks.front()->detail()->d_tpb;
+
+        // The head's own messages already signal the condition we
+        // sleep on.
+        for (size_t i = 1; i < d_blocks.size(); i++) {
+            d_blocks[i]->detail()->d_tpb.set_msg_notify(
+                [head]() { head->notify_msg(); });
+        }
+        d_blocks.back()->detail()->d_tpb.set_output_relay(head);
+    }
+
+    ~fused_notify_guard()
+    {
+        d_blocks.back()->detail()->d_tpb.set_output_relay(nullptr);
+        for (size_t i = 1; i < d_blocks.size(); i++)
+            d_blocks[i]->detail()->d_tpb.set_msg_notify(std::function<void()>());
+    }
+};
+
+} // namespace
+
+tpb_fused_thread_body::tpb_fused_thread_body(const block_vector_t& blocks,
+                                             gr::thread::barrier_sptr start_sync,
+                                             int max_noutput_items)
+    : d_exec(blocks, max_noutput_items)
+{
+    block_sptr head = d_exec.head();
+
+    thread::set_thread_name(
+        gr::thread::get_current_thread_id(),
+        boost::str(boost::format("%s%d+%d") % head->name() % head->unique_id() %
+                   (blocks.size() - 1)));
+
+    block_detail* d = head->detail().get();
+    block_detail* t = d_exec.tail()->detail().get();
+    block_executor::state s;
+
+    for (const block_sptr& b : blocks) {
+        b->detail()->threaded = true;
+        b->detail()->thread = gr::thread::get_current_thread_id();
+    }
+
+    // All blocks in a chain share affinity and priority.
+    if (!head->processor_affinity().empty()) {
+        gr::thread::thread_bind_to_processor(d->thread, head->processor_affinity());
+    }
+    if (head->thread_priority() > 0) {
+        gr::thread::set_thread_priority(d->thread, head->thread_priority());
+    }
+
+    fused_notify_guard guard(blocks);
+
+    start_sync->wait();
+    while (1) {
+        boost::this_thread::interruption_point();
+
+        d->d_tpb.clear_changed();
+
+        // handle any queued up messages
+        d_exec.dispatch_msgs();
+
+        s = d_exec.run_one_iteration();
+
+        switch (s) {
+        case block_executor::READY: // Tell neighbors we made progress.
+            d->d_tpb.notify_upstream(d);
+            t->d_tpb.notify_downstream(t);
+            break;
+
+        case block_executor::DONE: // Game over.
+            d->d_tpb.notify_upstream(d);
+            t->d_tpb.notify_downstream(t);
+            return;
+
+        default: // Wait for input, output space or messages.
+        {
+            gr::thread::scoped_lock guard(d->d_tpb.mutex);
+            d->d_tpb.input_waiting = true;
+            while (!d->d_tpb.input_changed) {
+                d->d_tpb.input_cond.wait(guard);
+            }
+            d->d_tpb.input_waiting = false;
+        } break;
+        }
+    }
+}
+
+tpb_fused_thread_body::~tpb_fused_thread_body() {}
+
 } /* namespace gr */
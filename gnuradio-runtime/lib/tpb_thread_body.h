@@ -11,6 +11,7 @@
 #define INCLUDED_GR_TPB_THREAD_BODY_H
 
 #include "block_executor.h"
+#include "fused_executor.h"
 #include <gnuradio/api.h>
 #include <gnuradio/block.h>
 #include <gnuradio/block_detail.h>
@@ -36,6 +37,26 @@ public:
     ~tpb_thread_body();
 };
 
+/*!
+ * \brief The body of a thread-per-block thread that runs a fused
+ * chain of blocks.
+ *
+ * Like tpb_thread_body, but for a chain from
+ * flat_flowgraph::fused_chains(). The thread sleeps on the first
+ * block's input condition; output notifications to the last block
+ * and message notifications to any block are passed on to it.
+ */
+class GR_RUNTIME_API tpb_fused_thread_body
+{
+    fused_executor d_exec;
+
+public:
+    tpb_fused_thread_body(const block_vector_t& blocks,
+                          thread::barrier_sptr start_sync,
+                          int max_noutput_items = 100000);
+    ~tpb_fused_thread_body();
+};
+
 } /* namespace gr */
 
 #endif /* INCLUDED_GR_TPB_THREAD_BODY_H */
@@ -0,0 +1,234 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/prefs.h>
+#include <gnuradio/thread/thread.h>
+#include <gnuradio/tracer.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace gr {
+
+namespace {
+
+// One thread writes a ring; anyone may copy it. The writer never
+// waits: if a reader is slow, it throws away what got overwritten
+// while it was copying.
+struct ring {
+    std::vector<tracer::event> events; // size is a power of 2
+    std::atomic<uint64_t> head;        // number of events ever recorded
+    std::atomic<uint64_t> tail;        // where the last clear() left head
+    int tid;
+    std::string name;
+
+    ring(size_t size, int tid) : events(size), head(0), tail(0), tid(tid) {}
+};
+
+gr::thread::mutex s_mutex; // guards the containers below
+std::vector<std::shared_ptr<ring>> s_rings;
+std::map<long, std::string> s_block_names;
+
+thread_local std::shared_ptr<ring> t_ring;
+
+ring* thread_ring()
+{
+    if (!t_ring) {
+        long size =
+            prefs::singleton()->get_long("PerfCounters", "trace_events", 16384);
+        size_t n = 1;
+        while (n < static_cast<size_t>(std::max(size, 1L)))
+            n *= 2;
+
+        gr::thread::scoped_lock guard(s_mutex);
+        t_ring = std::make_shared<ring>(n, s_rings.size());
+#ifdef __linux__
+        char name[17] = { 0 };
+        if (prctl(PR_GET_NAME, name, 0, 0, 0) == 0)
+            t_ring->name = name;
+#endif
+        if (t_ring->name.empty())
+            t_ring->name = str(boost::format("thread %d") % t_ring->tid);
+        s_rings.push_back(t_ring);
+    }
+    return t_ring.get();
+}
+
+// Copy what's still in r, oldest first.
+void copy_ring(const ring& r, std::vector<tracer::event>& out)
+{
+    const uint64_t size = r.events.size();
+    uint64_t end = r.head.load(std::memory_order_acquire);
+    uint64_t begin = std::max(end > size ? end - size : 0,
+                              r.tail.load(std::memory_order_relaxed));
+
+    size_t first = out.size();
+    for (uint64_t i = begin; i < end; i++)
+        out.push_back(r.events[i & (size - 1)]);
+
+    // Anything the writer got to meanwhile may be torn, including the
+    // slot it's writing now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t now = r.head.load(std::memory_order_relaxed) + 1;
+    if (now > begin + size) {
+        size_t stale = std::min<uint64_t>(now - (begin + size), end - begin);
+        out.erase(out.begin() + first, out.begin() + first + stale);
+    }
+}
+
+const char* state_name(tracer::state s)
+{
+    switch (s) {
+    case tracer::READY:
+        return "ready";
+    case tracer::READY_NO_OUTPUT:
+        return "ready_no_output";
+    case tracer::BLKD_IN:
+        return "blocked_input";
+    case tracer::BLKD_OUT:
+        return "blocked_output";
+    case tracer::DONE:
+        return "done";
+    }
+    return "unknown";
+}
+
+std::string quote(const std::string& s)
+{
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            q += '\\';
+        if (static_cast<unsigned char>(c) < 0x20)
+            q += str(boost::format("\\u%04x") % static_cast<int>(c));
+        else
+            q += c;
+    }
+    return q + "\"";
+}
+
+} // namespace
+
+std::atomic<bool> tracer::s_enabled(false);
+
+void tracer::enable(bool on) { s_enabled.store(on, std::memory_order_relaxed); }
+
+void tracer::record(const event& e)
+{
+    ring* r = thread_ring();
+    uint64_t head = r->head.load(std::memory_order_relaxed);
+    r->events[head & (r->events.size() - 1)] = e;
+    r->head.store(head + 1, std::memory_order_release);
+}
+
+void tracer::name_block(long block_id, const std::string& name)
+{
+    gr::thread::scoped_lock guard(s_mutex);
+    s_block_names[block_id] = name;
+}
+
+void tracer::clear()
+{
+    gr::thread::scoped_lock guard(s_mutex);
+
+    // Rings of threads that are gone have nothing more to say. The
+    // others are still written to, so only mark where we cleared.
+    std::vector<std::shared_ptr<ring>> live;
+    for (const auto& r : s_rings) {
+        if (r.use_count() > 1) {
+            r->tail.store(r->head.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+            live.push_back(r);
+        }
+    }
+    s_rings.swap(live);
+}
+
+std::vector<tracer::event> tracer::events()
+{
+    gr::thread::scoped_lock guard(s_mutex);
+
+    std::vector<event> out;
+    for (const auto& r : s_rings)
+        copy_ring(*r, out);
+    return out;
+}
+
+void tracer::write_chrome_trace(std::ostream& os)
+{
+    gr::thread::scoped_lock guard(s_mutex);
+
+    // Timestamps are in microseconds, from the first event on.
+    const double us = 1e6 / high_res_timer_tps();
+    std::vector<std::vector<event>> events(s_rings.size());
+    high_res_timer_type t0 = 0;
+    for (size_t i = 0; i < s_rings.size(); i++) {
+        copy_ring(*s_rings[i], events[i]);
+        if (!events[i].empty() && (t0 == 0 || events[i].front().start < t0))
+            t0 = events[i].front().start;
+    }
+
+    std::ios::fmtflags flags = os.flags(std::ios::fixed);
+    std::streamsize precision = os.precision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char* sep = "\n";
+    for (size_t i = 0; i < s_rings.size(); i++) {
+        const ring& r = *s_rings[i];
+        os << sep << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << r.tid
+           << ",\"args\":{\"name\":" << quote(r.name) << "}}";
+        sep = ",\n";
+
+        for (const event& e : events[i]) {
+            std::map<long, std::string>::const_iterator name =
+                s_block_names.find(e.block_id);
+            os << sep << "{\"name\":"
+               << quote(name != s_block_names.end()
+                            ? name->second
+                            : str(boost::format("block %d") % e.block_id))
+               << ",\"pid\":0,\"tid\":" << r.tid << ",\"ts\":" << (e.start - t0) * us;
+
+            // Work calls take time; being blocked is a moment.
+            if (e.result == BLKD_IN || e.result == BLKD_OUT) {
+                os << ",\"ph\":\"i\",\"s\":\"t\",\"cat\":\"blocked\"";
+            } else {
+                os << ",\"ph\":\"X\",\"dur\":" << (e.end - e.start) * us
+                   << ",\"cat\":\"work\"";
+            }
+
+            os << ",\"args\":{\"state\":\"" << state_name(e.result)
+               << "\",\"noutput_items\":" << e.noutput_items
+               << ",\"nproduced\":" << e.nproduced << ",\"input_full\":" << e.input_full
+               << ",\"output_full\":" << e.output_full << "}}";
+        }
+    }
+    os << "\n]}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void tracer::write_chrome_trace(const std::string& filename)
+{
+    std::ofstream os(filename.c_str());
+    if (!os)
+        throw std::runtime_error("tracer: can't open " + filename);
+    write_chrome_trace(os);
+}
+
+} /* namespace gr */
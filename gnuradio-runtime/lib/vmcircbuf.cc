@@ -23,6 +23,7 @@
 
 // all the factories we know about
 #include "vmcircbuf_createfilemapping.h"
+#include "vmcircbuf_memfd.h"
 #include "vmcircbuf_mmap_shm_open.h"
 #include "vmcircbuf_mmap_tmpfile.h"
 #include "vmcircbuf_sysv_shm.h"
@@ -86,6 +87,9 @@ std::vector<vmcircbuf_factory*> vmcircbuf_sysconfig::all_factories()
 {
     std::vector<vmcircbuf_factory*> result;
 
+#ifdef HAVE_MEMFD_CREATE
+    result.push_back(gr::vmcircbuf_memfd_factory::singleton());
+#endif
     result.push_back(gr::vmcircbuf_createfilemapping_factory::singleton());
 #ifdef TRY_SHM_VMCIRCBUF
     result.push_back(gr::vmcircbuf_sysv_shm_factory::singleton());
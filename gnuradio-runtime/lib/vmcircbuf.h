@@ -73,6 +73,17 @@ public:
      * Call this to create a doubly mapped circular buffer.
      */
     virtual vmcircbuf* make(int size) = 0;
+
+    /*!
+     * \brief return a gr::vmcircbuf, or 0 if unable, with its memory
+     * close to \p cpus (typically the writer's processor affinity).
+     *
+     * Factories that can't place memory just call make().
+     */
+    virtual vmcircbuf* make_near(int size, const std::vector<int>& cpus)
+    {
+        return make(size);
+    }
 };
 
 /*
@@ -91,6 +102,10 @@ public:
 
     static int granularity() { return get_default_factory()->granularity(); }
     static vmcircbuf* make(int size) { return get_default_factory()->make(size); }
+    static vmcircbuf* make_near(int size, const std::vector<int>& cpus)
+    {
+        return get_default_factory()->make_near(size, cpus);
+    }
 
     // N.B. not all factories are guaranteed to work.
     // It's too hard to check everything at config time, so we check at runtime
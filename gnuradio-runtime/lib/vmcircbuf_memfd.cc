@@ -0,0 +1,246 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "vmcircbuf_memfd.h"
+#include <unistd.h>
+#include <stdexcept>
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#include "pagesize.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+
+namespace gr {
+
+#if defined(HAVE_MMAP) && defined(HAVE_MEMFD_CREATE)
+
+// The size of the huge pages MFD_HUGETLB hands out by default.
+static size_t huge_page_size()
+{
+    static size_t s_size = 0;
+
+    if (s_size == 0) {
+        s_size = 2 * (1 << 20);
+
+        std::ifstream meminfo("/proc/meminfo");
+        std::string key;
+        size_t kb;
+        while (meminfo >> key) {
+            if (key == "Hugepagesize:" && meminfo >> kb) {
+                s_size = kb * 1024;
+                break;
+            }
+            meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+    return s_size;
+}
+
+// Map size bytes of fd twice, back to back, starting at a multiple of
+// align. Returns the start of the first copy, or 0.
+static char* map_twice(int fd, size_t size, size_t align)
+{
+    if (ftruncate(fd, (off_t)size) == -1)
+        return 0;
+
+    // Grab enough address space to line the buffer up, then trim it.
+    size_t reserved = 2 * size + align - gr::pagesize();
+    char* reservation = (char*)mmap(
+        0, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reservation == MAP_FAILED)
+        return 0;
+
+    char* base = (char*)(((uintptr_t)reservation + align - 1) & ~(uintptr_t)(align - 1));
+    if (base > reservation)
+        munmap(reservation, base - reservation);
+    if (reservation + reserved > base + 2 * size)
+        munmap(base + 2 * size, reservation + reserved - (base + 2 * size));
+
+    if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+            MAP_FAILED ||
+        mmap(base + size,
+             size,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_FIXED,
+             fd,
+             0) == MAP_FAILED) {
+        munmap(base, 2 * size);
+        return 0;
+    }
+
+    return base;
+}
+
+#endif
+
+vmcircbuf_memfd::vmcircbuf_memfd(int size, int numa_node) : gr::vmcircbuf(size)
+{
+#if !defined(HAVE_MMAP) || !defined(HAVE_MEMFD_CREATE)
+    GR_LOG_ERROR(d_logger, "mmap or memfd_create is not available");
+    throw std::runtime_error("gr::vmcircbuf_memfd");
+#else
+    gr::thread::scoped_lock guard(s_vm_mutex);
+
+    if (size <= 0 || (size % gr::pagesize()) != 0) {
+        GR_LOG_ERROR(d_logger, "invalid size = " + std::to_string(size));
+        throw std::runtime_error("gr::vmcircbuf_memfd");
+    }
+
+    // Huge pages only come whole, so only buffers that are a multiple
+    // of one get them. If none are reserved, mapping fails and we go
+    // on with regular pages.
+    size_t huge_size = huge_page_size();
+    bool huge = (size % huge_size) == 0;
+    char* base = 0;
+
+    if (huge) {
+        int fd = memfd_create("gnuradio", MFD_CLOEXEC | MFD_HUGETLB);
+        if (fd != -1) {
+            base = map_twice(fd, size, huge_size);
+            close(fd); // the mappings keep the memory alive
+        }
+        if (base) {
+            GR_LOG_DEBUG(d_debug_logger,
+                         boost::format("%d bytes in huge pages") % size);
+        }
+    }
+
+    if (!base) {
+        int fd = memfd_create("gnuradio", MFD_CLOEXEC);
+        if (fd == -1) {
+            GR_LOG_ERROR(d_logger, "memfd_create failed");
+            throw std::runtime_error("gr::vmcircbuf_memfd");
+        }
+        base = map_twice(fd, size, huge ? huge_size : gr::pagesize());
+        close(fd);
+        if (!base) {
+            GR_LOG_ERROR(d_logger, "mmap failed");
+            throw std::runtime_error("gr::vmcircbuf_memfd");
+        }
+
+#ifdef MADV_HUGEPAGE
+        // Let transparent huge pages back it, where shmem allows them.
+        if (huge)
+            madvise(base, 2 * size, MADV_HUGEPAGE);
+#endif
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    // Ask for the pages on the writer's node. This is only a
+    // preference: if that node is out of memory we take what we get.
+    if (numa_node >= 0) {
+        const size_t bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask(numa_node / bits + 1, 0);
+        mask[numa_node / bits] = 1UL << (numa_node % bits);
+
+        // The kernel ignores the last bit of maxnode.
+        if (syscall(SYS_mbind,
+                    base,
+                    (unsigned long)2 * size,
+                    MPOL_PREFERRED,
+                    mask.data(),
+                    (unsigned long)(mask.size() * bits + 1),
+                    0) == -1) {
+            GR_LOG_DEBUG(d_debug_logger,
+                         boost::format("mbind to node %d failed") % numa_node);
+        }
+    }
+#endif
+
+    d_base = base;
+    d_size = size;
+#endif
+}
+
+vmcircbuf_memfd::~vmcircbuf_memfd()
+{
+#if defined(HAVE_MMAP) && defined(HAVE_MEMFD_CREATE)
+    gr::thread::scoped_lock guard(s_vm_mutex);
+
+    if (munmap(d_base, 2 * d_size) == -1) {
+        GR_LOG_ERROR(d_logger, "munmap failed");
+    }
+#endif
+}
+
+// ----------------------------------------------------------------
+//			The factory interface
+// ----------------------------------------------------------------
+
+gr::vmcircbuf_factory* vmcircbuf_memfd_factory::s_the_factory = 0;
+
+gr::vmcircbuf_factory* vmcircbuf_memfd_factory::singleton()
+{
+    if (s_the_factory)
+        return s_the_factory;
+
+    s_the_factory = new gr::vmcircbuf_memfd_factory();
+    return s_the_factory;
+}
+
+int vmcircbuf_memfd_factory::granularity() { return gr::pagesize(); }
+
+gr::vmcircbuf* vmcircbuf_memfd_factory::make(int size)
+{
+    try {
+        return new vmcircbuf_memfd(size);
+    } catch (...) {
+        return 0;
+    }
+}
+
+gr::vmcircbuf* vmcircbuf_memfd_factory::make_near(int size, const std::vector<int>& cpus)
+{
+    try {
+        return new vmcircbuf_memfd(size, numa_node(cpus));
+    } catch (...) {
+        return 0;
+    }
+}
+
+int vmcircbuf_memfd_factory::numa_node(const std::vector<int>& cpus)
+{
+    int node = -1;
+
+    // Each cpuN directory in sysfs has a nodeM link to its node.
+    for (int cpu : cpus) {
+        int cpu_node = -1;
+        boost::system::error_code ec;
+        boost::filesystem::directory_iterator it(
+            str(boost::format("/sys/devices/system/cpu/cpu%d") % cpu), ec);
+        for (; !ec && it != boost::filesystem::directory_iterator(); it.increment(ec)) {
+            std::string name = it->path().filename().string();
+            if (name.compare(0, 4, "node") == 0) {
+                cpu_node = atoi(name.c_str() + 4);
+                break;
+            }
+        }
+
+        if (cpu_node < 0 || (node >= 0 && cpu_node != node))
+            return -1;
+        node = cpu_node;
+    }
+    return node;
+}
+
+} /* namespace gr */
@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef GR_VMCIRCBUF_MEMFD_H
+#define GR_VMCIRCBUF_MEMFD_H
+
+#include "vmcircbuf.h"
+#include <gnuradio/api.h>
+
+namespace gr {
+
+/*!
+ * \brief concrete class to implement circular buffers with mmap and memfd_create
+ * \ingroup internal
+ *
+ * Buffers whose size is a multiple of the huge page size are backed
+ * by huge pages if the system has any reserved, and are otherwise
+ * offered to transparent huge pages. If \p numa_node is not negative,
+ * the pages are preferably allocated on that NUMA node.
+ */
+class GR_RUNTIME_API vmcircbuf_memfd : public gr::vmcircbuf
+{
+public:
+    vmcircbuf_memfd(int size, int numa_node = -1);
+    ~vmcircbuf_memfd() override;
+};
+
+/*!
+ * \brief concrete factory for circular buffers built using mmap and memfd_create
+ */
+class GR_RUNTIME_API vmcircbuf_memfd_factory : public gr::vmcircbuf_factory
+{
+private:
+    static gr::vmcircbuf_factory* s_the_factory;
+
+public:
+    static gr::vmcircbuf_factory* singleton();
+
+    const char* name() const override { return "gr::vmcircbuf_memfd_factory"; }
+
+    /*!
+     * \brief return granularity of mapping, typically equal to page size
+     */
+    int granularity() override;
+
+    /*!
+     * \brief return a gr::vmcircbuf, or 0 if unable.
+     *
+     * Call this to create a doubly mapped circular buffer.
+     */
+    gr::vmcircbuf* make(int size) override;
+
+    /*!
+     * \brief return a gr::vmcircbuf on the NUMA node \p cpus are on,
+     * or 0 if unable.
+     */
+    gr::vmcircbuf* make_near(int size, const std::vector<int>& cpus) override;
+
+    /*!
+     * \brief return the NUMA node all of \p cpus are on, or -1 if
+     * they're spread over several nodes or we can't tell.
+     */
+    static int numa_node(const std::vector<int>& cpus);
+};
+
+} /* namespace gr */
+
+#endif /* GR_VMCIRCBUF_MEMFD_H */
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(basic_block.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(26ded167bb79b740fd37685f86fd553e)                     */
+/* BINDTOOL_HEADER_FILE_HASH(824773a57c028b997a02d3f13f07e6d1)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -101,7 +101,8 @@ void bind_basic_block(py::module& m)
 
 
         .def("message_port_pub",
-             &basic_block::message_port_pub,
+             (void (basic_block::*)(pmt::pmt_t, pmt::pmt_t)) &
+                 basic_block::message_port_pub,
              py::arg("port_id"),
              py::arg("msg"),
              D(basic_block, message_port_pub))
@@ -150,7 +151,7 @@ void bind_basic_block(py::module& m)
 
 
         .def("_post",
-             &basic_block::_post,
+             (void (basic_block::*)(pmt::pmt_t, pmt::pmt_t)) & basic_block::_post,
              py::arg("which_port"),
              py::arg("msg"),
              D(basic_block, _post))
@@ -182,7 +183,7 @@ void bind_basic_block(py::module& m)
 
 
         .def("insert_tail",
-             &basic_block::insert_tail,
+             (void (basic_block::*)(pmt::pmt_t, pmt::pmt_t)) & basic_block::insert_tail,
              py::arg("which_port"),
              py::arg("msg"),
              D(basic_block, insert_tail))
@@ -194,6 +195,21 @@ void bind_basic_block(py::module& m)
              D(basic_block, delete_head_nowait))
 
 
+        .def("set_msg_queue_policy",
+             &basic_block::set_msg_queue_policy,
+             py::arg("which_port"),
+             py::arg("capacity"),
+             py::arg("policy"),
+             D(basic_block, set_msg_queue_policy))
+
+
+        .def("port_queue",
+             &basic_block::port_queue,
+             py::arg("which_port"),
+             py::return_value_policy::reference_internal,
+             D(basic_block, port_queue))
+
+
         .def("get_iterator",
              &basic_block::get_iterator,
              py::arg("which_port"),
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(block.h)                                                   */
-/* BINDTOOL_HEADER_FILE_HASH(5df7331a717fb7c436eac2fc20991858)                     */
+/* BINDTOOL_HEADER_FILE_HASH(bbe557ec4dc0f69013e28720221c0c3d)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -66,6 +66,9 @@ void bind_block(py::module& m)
         .def("fixed_rate", &block::fixed_rate, D(block, fixed_rate))
 
 
+        .def("inplace", &block::inplace, D(block, inplace))
+
+
         .def("forecast",
              &block::forecast,
              py::arg("noutput_items"),
@@ -255,6 +258,12 @@ void bind_block(py::module& m)
              D(block, max_output_buffer))
 
 
+        .def("requested_max_output_buffer",
+             &block::requested_max_output_buffer,
+             py::arg("i"),
+             D(block, requested_max_output_buffer))
+
+
         .def("set_max_output_buffer",
              (void (block::*)(long int)) & block::set_max_output_buffer,
              py::arg("max_output_buffer"),
@@ -398,6 +407,15 @@ void bind_block(py::module& m)
         .def("pc_throughput_avg", &block::pc_throughput_avg, D(block, pc_throughput_avg))
 
 
+        .def("pc_msgs_received", &block::pc_msgs_received, D(block, pc_msgs_received))
+
+
+        .def("pc_msgs_dropped", &block::pc_msgs_dropped, D(block, pc_msgs_dropped))
+
+
+        .def("pc_msgs_blocked", &block::pc_msgs_blocked, D(block, pc_msgs_blocked))
+
+
         .def("reset_perf_counters",
              &block::reset_perf_counters,
              D(block, reset_perf_counters))
@@ -469,6 +487,13 @@ void bind_block(py::module& m)
         .def("set_detail", &block::set_detail, py::arg("detail"), D(block, set_detail))
 
 
+        .def("set_allocated_output_buffer",
+             &block::set_allocated_output_buffer,
+             py::arg("port"),
+             py::arg("nitems"),
+             D(block, set_allocated_output_buffer))
+
+
         .def("notify_msg_neighbors",
              &block::notify_msg_neighbors,
              D(block, notify_msg_neighbors))
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(buffer.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(825bd18ddcab10552de6f9162a6aae3e)                     */
+/* BINDTOOL_HEADER_FILE_HASH(887a8284fe62b77eae7c83daa0bc1f04)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -111,6 +111,12 @@ static const char* __doc_gr_basic_block_insert_tail = R"doc()doc";
 static const char* __doc_gr_basic_block_delete_head_nowait = R"doc()doc";
 
 
+static const char* __doc_gr_basic_block_set_msg_queue_policy = R"doc()doc";
+
+
+static const char* __doc_gr_basic_block_port_queue = R"doc()doc";
+
+
 static const char* __doc_gr_basic_block_get_iterator = R"doc()doc";
 
 
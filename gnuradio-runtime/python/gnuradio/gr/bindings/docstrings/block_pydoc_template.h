@@ -36,6 +36,9 @@ static const char* __doc_gr_block_sample_delay = R"doc()doc";
 static const char* __doc_gr_block_fixed_rate = R"doc()doc";
 
 
+static const char* __doc_gr_block_inplace = R"doc()doc";
+
+
 static const char* __doc_gr_block_forecast = R"doc()doc";
 
 
@@ -147,6 +150,9 @@ static const char* __doc_gr_block_expand_minmax_buffer = R"doc()doc";
 static const char* __doc_gr_block_max_output_buffer = R"doc()doc";
 
 
+static const char* __doc_gr_block_requested_max_output_buffer = R"doc()doc";
+
+
 static const char* __doc_gr_block_set_max_output_buffer_0 = R"doc()doc";
 
 
@@ -231,6 +237,15 @@ static const char* __doc_gr_block_pc_work_time_total = R"doc()doc";
 static const char* __doc_gr_block_pc_throughput_avg = R"doc()doc";
 
 
+static const char* __doc_gr_block_pc_msgs_received = R"doc()doc";
+
+
+static const char* __doc_gr_block_pc_msgs_dropped = R"doc()doc";
+
+
+static const char* __doc_gr_block_pc_msgs_blocked = R"doc()doc";
+
+
 static const char* __doc_gr_block_reset_perf_counters = R"doc()doc";
 
 
@@ -282,6 +297,9 @@ static const char* __doc_gr_block_detail = R"doc()doc";
 static const char* __doc_gr_block_set_detail = R"doc()doc";
 
 
+static const char* __doc_gr_block_set_allocated_output_buffer = R"doc()doc";
+
+
 static const char* __doc_gr_block_notify_msg_neighbors = R"doc()doc";
 
 
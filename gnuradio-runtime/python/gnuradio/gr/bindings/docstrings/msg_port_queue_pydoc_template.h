@@ -0,0 +1,61 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+
+static const char* __doc_gr_msg_port_queue = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_overflow_policy = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_msg_port_queue = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_push = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_pop = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_size = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_empty = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_capacity = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_set_capacity = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_policy = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_set_policy = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_npushed = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_ndropped = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_nblocked = R"doc()doc";
+
+
+static const char* __doc_gr_msg_port_queue_policy_from_string = R"doc()doc";
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_tracer = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_event = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_enable = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_enabled = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_record = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_name_block = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_clear = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_events = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_write_chrome_trace_0 = R"doc()doc";
+
+
+static const char* __doc_gr_tracer_write_chrome_trace_1 = R"doc()doc";
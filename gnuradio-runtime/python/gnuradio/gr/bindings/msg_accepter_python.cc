@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(msg_accepter.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(8236457e5087b5cf4583374a01306c3a)                     */
+/* BINDTOOL_HEADER_FILE_HASH(a30c76d30b49cc63ad5719c2593e59a5)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -43,7 +43,7 @@ void bind_msg_accepter(py::module& m)
 
 
         .def("post",
-             &msg_accepter::post,
+             (void (msg_accepter::*)(pmt::pmt_t, pmt::pmt_t)) & msg_accepter::post,
              py::arg("which_port"),
              py::arg("msg"),
              D(msg_accepter, post))
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(msg_port_queue.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(90a3fc72b3e66a107d2fd7f4f28a1333)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/msg_port_queue.h>
+// pydoc.h is automatically generated in the build directory
+#include <msg_port_queue_pydoc.h>
+
+void bind_msg_port_queue(py::module& m)
+{
+
+    using msg_port_queue = ::gr::msg_port_queue;
+
+
+    py::class_<msg_port_queue> msg_port_queue_class(
+        m, "msg_port_queue", D(msg_port_queue));
+
+    msg_port_queue_class
+
+        .def(py::init<size_t, msg_port_queue::overflow_policy>(),
+             py::arg("capacity"),
+             py::arg("policy"),
+             D(msg_port_queue, msg_port_queue))
+
+
+        .def("push",
+             &msg_port_queue::push,
+             py::arg("msg"),
+             py::call_guard<py::gil_scoped_release>(),
+             D(msg_port_queue, push))
+
+
+        .def("pop",
+             (pmt::pmt_t(msg_port_queue::*)()) & msg_port_queue::pop,
+             D(msg_port_queue, pop))
+
+
+        .def("size", &msg_port_queue::size, D(msg_port_queue, size))
+
+
+        .def("empty", &msg_port_queue::empty, D(msg_port_queue, empty))
+
+
+        .def("capacity", &msg_port_queue::capacity, D(msg_port_queue, capacity))
+
+
+        .def("set_capacity",
+             &msg_port_queue::set_capacity,
+             py::arg("capacity"),
+             D(msg_port_queue, set_capacity))
+
+
+        .def("policy", &msg_port_queue::policy, D(msg_port_queue, policy))
+
+
+        .def("set_policy",
+             &msg_port_queue::set_policy,
+             py::arg("policy"),
+             D(msg_port_queue, set_policy))
+
+
+        .def("npushed", &msg_port_queue::npushed, D(msg_port_queue, npushed))
+
+
+        .def("ndropped", &msg_port_queue::ndropped, D(msg_port_queue, ndropped))
+
+
+        .def("nblocked", &msg_port_queue::nblocked, D(msg_port_queue, nblocked))
+
+
+        .def_static("policy_from_string",
+                    &msg_port_queue::policy_from_string,
+                    py::arg("name"),
+                    D(msg_port_queue, policy_from_string));
+
+
+    py::enum_<::gr::msg_port_queue::overflow_policy>(msg_port_queue_class,
+                                                     "overflow_policy")
+        .value("BLOCK", ::gr::msg_port_queue::BLOCK)
+        .value("DROP_OLDEST", ::gr::msg_port_queue::DROP_OLDEST)
+        .value("DROP_NEWEST", ::gr::msg_port_queue::DROP_NEWEST)
+        .value("GROW", ::gr::msg_port_queue::GROW)
+        .export_values();
+}
@@ -50,6 +50,7 @@ void bind_msg_accepter(py::module&);
 void bind_msg_queue(py::module&);
 // void bind_misc(py::module&);;
 void bind_msg_handler(py::module&);
+void bind_msg_port_queue(py::module&);
 void bind_msg_queue(py::module&);
 void bind_nco(py::module&);
 void bind_prefs(py::module&);
@@ -87,6 +88,7 @@ void bind_tags(py::module&);
 // void bind_thrift_server_template(py::module&);
 void bind_top_block(py::module&);
 void bind_tpb_detail(py::module&);
+void bind_tracer(py::module&);
 // void bind_types(py::module&);
 // void bind_unittests(py::module&);
 // void bind_xoroshiro128p(py::module&);
@@ -120,6 +122,7 @@ PYBIND11_MODULE(gr_python, m)
 
     bind_msg_accepter(m);
     bind_msg_handler(m);
+    bind_msg_port_queue(m);
     bind_msg_queue(m);
 
     bind_io_signature(m);
@@ -188,6 +191,7 @@ PYBIND11_MODULE(gr_python, m)
     // // bind_thrift_server_template(m);
     bind_top_block(m);
     bind_tpb_detail(m);
+    bind_tracer(m);
     // // bind_types(m);
     // // bind_unittests(m);
     // // bind_xoroshiro128p(m);
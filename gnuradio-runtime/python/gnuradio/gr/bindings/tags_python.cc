@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(tags.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(73eb73e445943e224cdbae24b0b0ab76)                     */
+/* BINDTOOL_HEADER_FILE_HASH(aaeec2e1143078ef5e38f987b67bc545)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
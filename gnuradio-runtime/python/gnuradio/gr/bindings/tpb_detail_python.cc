@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(tpb_detail.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(e08c6f246b04f1719d3377c5e3992f53)                     */
+/* BINDTOOL_HEADER_FILE_HASH(8d8ea6aa35a1ca1aea381759167ad8b0)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
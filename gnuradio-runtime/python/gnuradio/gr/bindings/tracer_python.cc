@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(tracer.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(b694a8573243e2391a725ba2f0ff048d)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/tracer.h>
+// pydoc.h is automatically generated in the build directory
+#include <tracer_pydoc.h>
+
+void bind_tracer(py::module& m)
+{
+
+    using tracer = ::gr::tracer;
+
+
+    py::class_<tracer, std::shared_ptr<tracer>> tracer_class(m, "tracer", D(tracer));
+
+    tracer_class
+
+        .def_static("enable", &tracer::enable, py::arg("on") = true, D(tracer, enable))
+        .def_static("enabled", &tracer::enabled, D(tracer, enabled))
+        .def_static("clear", &tracer::clear, D(tracer, clear))
+        .def_static("events", &tracer::events, D(tracer, events))
+        .def_static("write_chrome_trace",
+                    py::overload_cast<const std::string&>(&tracer::write_chrome_trace),
+                    py::arg("filename"),
+                    D(tracer, write_chrome_trace, 1));
+
+
+    py::enum_<::gr::tracer::state>(tracer_class, "state")
+        .value("READY", ::gr::tracer::READY)
+        .value("READY_NO_OUTPUT", ::gr::tracer::READY_NO_OUTPUT)
+        .value("BLKD_IN", ::gr::tracer::BLKD_IN)
+        .value("BLKD_OUT", ::gr::tracer::BLKD_OUT)
+        .value("DONE", ::gr::tracer::DONE)
+        .export_values();
+
+
+    py::class_<tracer::event>(tracer_class, "event", D(tracer, event))
+        .def_readonly("block_id", &tracer::event::block_id)
+        .def_readonly("start", &tracer::event::start)
+        .def_readonly("end", &tracer::event::end)
+        .def_readonly("noutput_items", &tracer::event::noutput_items)
+        .def_readonly("nproduced", &tracer::event::nproduced)
+        .def_readonly("input_full", &tracer::event::input_full)
+        .def_readonly("output_full", &tracer::event::output_full)
+        .def_readonly("result", &tracer::event::result);
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+#
+# Copyright 2026 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+#
+
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+
+
+class test_block_fusion(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.prefs = gr.prefs.singleton()
+        self.fuse = self.prefs.get_bool("Scheduler", "fuse_sync_blocks", False)
+        self.inplace = self.prefs.get_bool("Scheduler", "inplace_buffers", False)
+
+    def tearDown(self):
+        self.prefs.set_bool("Scheduler", "fuse_sync_blocks", self.fuse)
+        self.prefs.set_bool("Scheduler", "inplace_buffers", self.inplace)
+
+    def run_chain(self, fuse):
+        self.prefs.set_bool("Scheduler", "fuse_sync_blocks", fuse)
+        tb = gr.top_block()
+
+        data = [float(x % 100) for x in range(100000)]
+        tags = [gr.tag_utils.python_to_tag(
+            (n, pmt.intern("n"), pmt.from_long(n), pmt.PMT_F))
+            for n in range(0, len(data), 1000)]
+        src = blocks.vector_source_f(data, False, 1, tags)
+        mult = blocks.multiply_const_ff(2)
+        add = blocks.add_const_ff(1)
+        neg = blocks.multiply_const_ff(-1)
+        snk = blocks.vector_sink_f()
+        tb.connect(src, mult, add, neg, snk)
+        tb.run()
+
+        expected = [-(2 * x + 1) for x in data]
+        self.assertFloatTuplesAlmostEqual(expected, snk.data())
+        offsets = [t.offset for t in snk.tags()]
+        self.assertEqual([t.offset for t in tags], offsets)
+        return mult.max_output_buffer(0)
+
+    def test_001_chain(self):
+        unfused = self.run_chain(False)
+        fused = self.run_chain(True)
+        # the buffers inside the chain only need to hold a tile
+        self.assertLess(fused, unfused)
+
+    def test_002_messages(self):
+        self.prefs.set_bool("Scheduler", "fuse_sync_blocks", True)
+        tb = gr.top_block()
+
+        src = blocks.vector_source_f([1.0] * 100000, False)
+        mult = blocks.multiply_const_ff(2)
+        mute = blocks.mute_ff(False)
+        add = blocks.add_const_ff(1)
+        snk = blocks.vector_sink_f()
+        tb.connect(src, mult, mute, add, snk)
+
+        # handled by the chain's thread before any samples go through
+        mute.to_basic_block()._post(pmt.intern("set_mute"), pmt.PMT_T)
+        tb.run()
+
+        self.assertTrue(mute.mute())
+        self.assertFloatTuplesAlmostEqual([1.0] * 100000, snk.data())
+
+    def run_inplace(self, inplace):
+        self.prefs.set_bool("Scheduler", "fuse_sync_blocks", False)
+        self.prefs.set_bool("Scheduler", "inplace_buffers", inplace)
+        tb = gr.top_block()
+
+        data = [float(x % 100) for x in range(100000)]
+        src = blocks.vector_source_f(data, False)
+        src.set_min_output_buffer(1 << 16)
+        mult = blocks.multiply_const_ff(2)
+        add = blocks.add_const_ff(1)
+        snk = blocks.vector_sink_f()
+        tb.connect(src, mult, add, snk)
+        tb.run()
+
+        self.assertFloatTuplesAlmostEqual([2 * x + 1 for x in data], snk.data())
+        return (src.max_output_buffer(0), mult.max_output_buffer(0),
+                add.max_output_buffer(0))
+
+    def test_003_inplace(self):
+        # Both blocks write over the source's buffer, so they have its size.
+        src, mult, add = self.run_inplace(True)
+        self.assertEqual(mult, src)
+        self.assertEqual(add, src)
+
+        src, mult, add = self.run_inplace(False)
+        self.assertLess(mult, src)
+        self.assertLess(add, src)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_block_fusion)
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+#
+# Copyright 2026 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+#
+
+
+from gnuradio import gr, gr_unittest, blocks
+
+
+class test_buffer_sizing(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.prefs = gr.prefs.singleton()
+        self.sizing = self.prefs.get_string("Buffers", "sizing", "fixed")
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.prefs.set_string("Buffers", "sizing", self.sizing)
+        self.tb = None
+
+    def run_decimating_graph(self):
+        src = blocks.null_source(gr.sizeof_float)
+        head = blocks.head(gr.sizeof_float, 100000)
+        dec = blocks.integrate_ff(100)
+        snk = blocks.null_sink(gr.sizeof_float)
+        self.tb.connect(src, head, dec, snk)
+        self.tb.run()
+        return head.max_output_buffer(0), dec.max_output_buffer(0)
+
+    def test_001_fixed(self):
+        self.prefs.set_string("Buffers", "sizing", "fixed")
+        full_rate, decimated = self.run_decimating_graph()
+        self.assertEqual(full_rate, decimated)
+
+    def test_002_adaptive(self):
+        self.prefs.set_string("Buffers", "sizing", "adaptive")
+        full_rate, decimated = self.run_decimating_graph()
+        self.assertLess(decimated, full_rate)
+        # never below 4 KiB
+        self.assertGreaterEqual(decimated * gr.sizeof_float, 4096)
+
+    def test_003_pinned(self):
+        self.prefs.set_string("Buffers", "sizing", "adaptive")
+        src = blocks.null_source(gr.sizeof_float)
+        head = blocks.head(gr.sizeof_float, 100000)
+        snk = blocks.null_sink(gr.sizeof_float)
+        head.set_max_output_buffer(8192)
+        self.tb.connect(src, head, snk)
+        self.tb.run()
+        self.assertEqual(8192, head.max_output_buffer(0))
+
+    def test_004_restart(self):
+        # What was allocated last time doesn't limit the size next time.
+        self.prefs.set_string("Buffers", "sizing", "adaptive")
+        src = blocks.null_source(gr.sizeof_float)
+        head = blocks.head(gr.sizeof_float, 100000)
+        dec = blocks.integrate_ff(100)
+        copy = blocks.copy(gr.sizeof_float)
+        snk = blocks.null_sink(gr.sizeof_float)
+        self.tb.connect(src, head, dec, copy, snk)
+        self.tb.run()
+        decimated = copy.max_output_buffer(0)
+        self.assertEqual(-1, copy.requested_max_output_buffer(0))
+
+        self.tb.disconnect_all()
+        head.reset()
+        self.tb.connect(src, head, copy, snk)
+        self.tb.run()
+        self.assertLess(decimated, copy.max_output_buffer(0))
+        self.assertEqual(head.max_output_buffer(0), copy.max_output_buffer(0))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_buffer_sizing)
@@ -43,6 +43,31 @@ class test_flowgraph (gr_unittest.TestCase):
         data = pmt.u8vector_elements(pmt.cdr(dbg.get_message(0)))
         self.assertEqual([1, 2, 3], data)
 
+    def test_001_msg_reconnect(self):
+        rem = blocks.pdu_remove(pmt.intern('foo'))
+        dbg1 = blocks.message_debug()
+        dbg2 = blocks.message_debug()
+        self.tb.msg_connect((rem, 'pdus'), (dbg1, 'store'))
+        self.tb.start()
+
+        msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(3, (1, 2, 3)))
+        rem.to_basic_block()._post(pmt.intern('pdus'), msg)
+        time.sleep(0.2)
+
+        # messages only go where the port is subscribed now
+        self.tb.lock()
+        self.tb.msg_disconnect((rem, 'pdus'), (dbg1, 'store'))
+        self.tb.msg_connect((rem, 'pdus'), (dbg2, 'store'))
+        self.tb.unlock()
+
+        rem.to_basic_block()._post(pmt.intern('pdus'), msg)
+        time.sleep(0.2)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(dbg1.num_messages(), 1)
+        self.assertEqual(dbg2.num_messages(), 1)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_flowgraph)
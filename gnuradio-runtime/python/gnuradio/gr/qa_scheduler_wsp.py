@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+#
+# Copyright 2026 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+#
+
+import os
+import time
+import pmt
+from gnuradio import gr, gr_unittest, blocks
+
+
+class test_scheduler_wsp(gr_unittest.TestCase):
+
+    def setUp(self):
+        # The scheduler is picked when the first flowgraph in the
+        # process starts, so all of these run under WSP.
+        os.environ['GR_SCHEDULER'] = 'WSP'
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_run(self):
+        data = [float(x) for x in range(100000)]
+        src = blocks.vector_source_f(data, False)
+        mult = blocks.multiply_const_ff(2)
+        add = blocks.add_const_ff(1)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, mult, add, snk)
+        self.tb.run()
+
+        self.assertFloatTuplesAlmostEqual([2 * x + 1 for x in data],
+                                          snk.data())
+
+    def test_002_fan_out_in(self):
+        data = [float(x % 100) for x in range(100000)]
+        src = blocks.vector_source_f(data, False)
+        mult1 = blocks.multiply_const_ff(2)
+        mult2 = blocks.multiply_const_ff(3)
+        add = blocks.add_ff()
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, mult1, (add, 0))
+        self.tb.connect(src, mult2, (add, 1))
+        self.tb.connect(add, snk)
+        self.tb.run()
+
+        self.assertFloatTuplesAlmostEqual([5 * x for x in data], snk.data())
+
+    def test_003_stop_wait(self):
+        src = blocks.null_source(gr.sizeof_float)
+        copy = blocks.copy(gr.sizeof_float)
+        snk = blocks.null_sink(gr.sizeof_float)
+        self.tb.connect(src, copy, snk)
+
+        self.tb.start()
+        time.sleep(0.1)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertGreater(copy.nitems_written(0), 0)
+
+    def test_004_lock_unlock(self):
+        src = blocks.vector_source_f([1.0] * 1000, True)
+        copy = blocks.copy(gr.sizeof_float)
+        snk1 = blocks.null_sink(gr.sizeof_float)
+        self.tb.connect(src, copy, snk1)
+
+        self.tb.start()
+        time.sleep(0.05)
+
+        # Rewire while it runs; the graph ends once head is done.
+        self.tb.lock()
+        head = blocks.head(gr.sizeof_float, 100000)
+        snk2 = blocks.vector_sink_f()
+        self.tb.disconnect(copy, snk1)
+        self.tb.connect(copy, head, snk2)
+        self.tb.unlock()
+        self.tb.wait()
+
+        self.assertEqual(snk2.data(), (1.0,) * 100000)
+
+    def test_005_msg_only(self):
+        self.tb.start()
+        self.tb.lock()
+
+        rem = blocks.pdu_remove(pmt.intern('foo'))
+        dbg = blocks.message_debug()
+        self.tb.msg_connect((rem, 'pdus'), (dbg, 'store'))
+
+        self.tb.unlock()
+
+        for i in range(10):
+            msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(3, (i, 2, 3)))
+            rem.to_basic_block()._post(pmt.intern('pdus'), msg)
+
+        # No timeouts to fall back on: the posts alone have to wake
+        # the blocks.
+        for _ in range(100):
+            if dbg.num_messages() == 10:
+                break
+            time.sleep(0.01)
+
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(dbg.num_messages(), 10)
+        for i in range(10):
+            data = pmt.u8vector_elements(pmt.cdr(dbg.get_message(i)))
+            self.assertEqual([i, 2, 3], data)
+
+    def test_006_msg_and_stream(self):
+        src = blocks.vector_source_f([1.0] * 100000, False)
+        copy = blocks.copy(gr.sizeof_float)
+        snk = blocks.vector_sink_f()
+        strobe = blocks.message_strobe(pmt.PMT_T, 10)
+        self.tb.connect(src, copy, snk)
+        self.tb.msg_connect((strobe, 'strobe'), (copy, 'en'))
+
+        self.tb.start()
+        for _ in range(100):
+            if len(snk.data()) == 100000:
+                break
+            time.sleep(0.01)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(100000, len(snk.data()))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_scheduler_wsp)
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+#
+# Copyright 2026 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+#
+
+
+import json
+import os
+import tempfile
+
+from gnuradio import gr, gr_unittest, blocks
+
+
+class test_tracer(gr_unittest.TestCase):
+
+    def setUp(self):
+        gr.tracer.clear()
+        gr.tracer.enable(True)
+
+    def tearDown(self):
+        gr.tracer.enable(False)
+        gr.tracer.clear()
+
+    def test_001_events(self):
+        tb = gr.top_block()
+        src = blocks.vector_source_f([1.0] * 10000, False)
+        mult = blocks.multiply_const_ff(2)
+        snk = blocks.vector_sink_f()
+        tb.connect(src, mult, snk)
+        tb.run()
+        gr.tracer.enable(False)
+
+        events = [e for e in gr.tracer.events()
+                  if e.block_id == mult.unique_id()]
+        self.assertTrue(events)
+        self.assertEqual(10000, sum(e.nproduced for e in events
+                                    if e.result == gr.tracer.READY))
+        for e in events:
+            self.assertLessEqual(e.start, e.end)
+            self.assertTrue(0 <= e.output_full <= 1)
+        self.assertEqual(gr.tracer.DONE, events[-1].result)
+
+    def test_002_chrome_trace(self):
+        tb = gr.top_block()
+        src = blocks.vector_source_f([1.0] * 10000, False)
+        snk = blocks.null_sink(gr.sizeof_float)
+        tb.connect(src, snk)
+        tb.run()
+
+        fd, filename = tempfile.mkstemp(suffix=".json")
+        os.close(fd)
+        try:
+            gr.tracer.write_chrome_trace(filename)
+            with open(filename) as f:
+                trace = json.load(f)
+        finally:
+            os.remove(filename)
+
+        names = set(e["name"] for e in trace["traceEvents"]
+                    if e["ph"] == "X")
+        self.assertIn(src.alias(), names)
+        self.assertIn(snk.alias(), names)
+
+    def test_003_clear(self):
+        tb = gr.top_block()
+        tb.connect(blocks.vector_source_f([1.0] * 100, False),
+                   blocks.null_sink(gr.sizeof_float))
+        tb.run()
+        gr.tracer.clear()
+        self.assertEqual(0, len(gr.tracer.events()))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_tracer)
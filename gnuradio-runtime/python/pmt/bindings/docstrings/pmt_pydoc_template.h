@@ -501,6 +501,9 @@ static const char* __doc_pmt_init_c64vector_0 = R"doc()doc";
 static const char* __doc_pmt_init_c64vector_1 = R"doc()doc";
 
 
+static const char* __doc_pmt_uniform_vector_slice = R"doc()doc";
+
+
 static const char* __doc_pmt_u8vector_ref = R"doc()doc";
 
 
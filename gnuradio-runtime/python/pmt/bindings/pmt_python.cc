@@ -860,6 +860,14 @@ void bind_pmt(py::module& m)
           D(init_c64vector, 1));
 
 
+    m.def("uniform_vector_slice",
+          &::pmt::uniform_vector_slice,
+          py::arg("v"),
+          py::arg("start"),
+          py::arg("k"),
+          D(uniform_vector_slice));
+
+
     m.def("u8vector_ref",
           &::pmt::u8vector_ref,
           py::arg("v"),
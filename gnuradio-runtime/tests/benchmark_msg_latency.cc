@@ -0,0 +1,207 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures how long a message takes to turn into a stream item:
+ *
+ *   strobe --msg--> msg_to_stream -> copy -> ... -> copy -> latency_sink
+ *
+ * The strobe publishes its send time every period. msg_to_stream pulls
+ * messages off its port inside work(), the way pdu_to_tagged_stream
+ * does, and writes the time out as one item. The sink compares it
+ * with the time the item arrives.
+ *
+ * usage: benchmark_msg_latency [nmsgs] [period_us] [nstages]
+ * Run with GR_SCHEDULER set to compare schedulers.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/block.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/sync_block.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+class strobe : public gr::block
+{
+    long d_nmsgs;
+    long d_period_us;
+    gr::thread::thread d_thread;
+
+    void run()
+    {
+        for (long i = 0; i < d_nmsgs; i++) {
+            boost::this_thread::sleep(boost::posix_time::microseconds(d_period_us));
+            message_port_pub(pmt::mp("strobe"),
+                             pmt::from_uint64(gr::high_res_timer_now()));
+        }
+
+        // Tell ourselves, and thus our subscribers, that we're done.
+        post(pmt::mp("system"), pmt::cons(pmt::mp("done"), pmt::from_long(1)));
+    }
+
+public:
+    strobe(long nmsgs, long period_us)
+        : gr::block("strobe",
+                    gr::io_signature::make(0, 0, 0),
+                    gr::io_signature::make(0, 0, 0)),
+          d_nmsgs(nmsgs),
+          d_period_us(period_us)
+    {
+        message_port_register_out(pmt::mp("strobe"));
+    }
+
+    bool start() override
+    {
+        d_thread = gr::thread::thread([this]() { run(); });
+        return block::start();
+    }
+
+    bool stop() override
+    {
+        d_thread.interrupt();
+        d_thread.join();
+        return block::stop();
+    }
+};
+
+class msg_to_stream : public gr::sync_block
+{
+public:
+    msg_to_stream()
+        : gr::sync_block("msg_to_stream",
+                         gr::io_signature::make(0, 0, 0),
+                         gr::io_signature::make(1, 1, sizeof(uint64_t)))
+    {
+        message_port_register_in(pmt::mp("in"));
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        uint64_t* out = static_cast<uint64_t*>(output_items[0]);
+
+        int n = 0;
+        pmt::pmt_t msg;
+        while (n < noutput_items && (msg = delete_head_nowait(pmt::mp("in")))) {
+            out[n++] = pmt::to_uint64(msg);
+        }
+        return n;
+    }
+};
+
+class copy : public gr::sync_block
+{
+public:
+    copy()
+        : gr::sync_block("copy",
+                         gr::io_signature::make(1, 1, sizeof(uint64_t)),
+                         gr::io_signature::make(1, 1, sizeof(uint64_t)))
+    {
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        memcpy(output_items[0], input_items[0], noutput_items * sizeof(uint64_t));
+        return noutput_items;
+    }
+};
+
+class latency_sink : public gr::sync_block
+{
+public:
+    std::vector<double> d_latency_us;
+
+    latency_sink()
+        : gr::sync_block("latency_sink",
+                         gr::io_signature::make(1, 1, sizeof(uint64_t)),
+                         gr::io_signature::make(0, 0, 0))
+    {
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        const uint64_t* in = static_cast<const uint64_t*>(input_items[0]);
+        gr::high_res_timer_type now = gr::high_res_timer_now();
+
+        for (int i = 0; i < noutput_items; i++) {
+            d_latency_us.push_back(1e6 * (now - (gr::high_res_timer_type)in[i]) /
+                                   gr::high_res_timer_tps());
+        }
+        return noutput_items;
+    }
+};
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long nmsgs = argc > 1 ? atol(argv[1]) : 2000;
+    long period_us = argc > 2 ? atol(argv[2]) : 1000;
+    int nstages = argc > 3 ? atoi(argv[3]) : 4;
+
+    gr::top_block_sptr tb = gr::make_top_block("benchmark_msg_latency");
+
+    auto src = gnuradio::make_block_sptr<strobe>(nmsgs, period_us);
+    auto m2s = gnuradio::make_block_sptr<msg_to_stream>();
+    auto snk = gnuradio::make_block_sptr<latency_sink>();
+
+    tb->msg_connect(src, "strobe", m2s, "in");
+    gr::basic_block_sptr prev = m2s;
+    for (int i = 0; i < nstages; i++) {
+        auto c = gnuradio::make_block_sptr<copy>();
+        tb->connect(prev, 0, c, 0);
+        prev = c;
+    }
+    tb->connect(prev, 0, snk, 0);
+
+    tb->run();
+
+    std::vector<double> lat = snk->d_latency_us;
+    if (lat.empty()) {
+        printf("no messages made it through\n");
+        return 1;
+    }
+    std::sort(lat.begin(), lat.end());
+
+    const char* sched = getenv("GR_SCHEDULER");
+    printf("%s: %zu/%ld msgs through %d stages, latency us: "
+           "min %.1f  p50 %.1f  p99 %.1f  max %.1f\n",
+           sched ? sched : "default",
+           lat.size(),
+           nmsgs,
+           nstages,
+           lat.front(),
+           percentile(lat, 0.50),
+           percentile(lat, 0.99),
+           lat.back());
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures message passing between blocks: how many messages a second
+ * get through, and how long each takes from message_port_pub() to the
+ * handler at the far end, in four shapes of flowgraph:
+ *
+ *   1->1     source -> sink
+ *   fan-out  source -> width sinks
+ *   fan-in   width sources -> sink
+ *   chain    source -> relay -> ... (length relays) ... -> sink
+ *
+ * each with PDUs of 0, 64, 1500 and 65536 bytes. Sources make a new PDU
+ * for every message, as real ones do, and stamp it with the time it was
+ * published. Input ports block when full, so nothing is dropped and the
+ * sources run at the speed of the slowest consumer.
+ *
+ * usage: benchmark_msg_passing [nmsgs] [width] [length]
+ * Run with GR_SCHEDULER set to compare schedulers.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/block.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const pmt::pmt_t PORT_IN = pmt::mp("in");
+const pmt::pmt_t PORT_OUT = pmt::mp("out");
+const pmt::pmt_t PORT_SYSTEM = pmt::mp("system");
+const size_t QUEUE_DEPTH = 1024;
+
+// Publishes nmsgs (send time . u8vector) pairs as fast as it is let.
+class source : public gr::block
+{
+    long d_nmsgs;
+    size_t d_payload;
+    gr::thread::thread d_thread;
+
+    void run()
+    {
+        d_first = gr::high_res_timer_now();
+        for (long i = 0; i < d_nmsgs; i++) {
+            pmt::pmt_t pdu = pmt::make_u8vector(d_payload, 0);
+            message_port_pub(
+                PORT_OUT, pmt::cons(pmt::from_uint64(gr::high_res_timer_now()), pdu));
+        }
+        post(PORT_SYSTEM, pmt::cons(pmt::mp("done"), pmt::from_long(1)));
+    }
+
+public:
+    gr::high_res_timer_type d_first;
+
+    source(long nmsgs, size_t payload)
+        : gr::block("source",
+                    gr::io_signature::make(0, 0, 0),
+                    gr::io_signature::make(0, 0, 0)),
+          d_nmsgs(nmsgs),
+          d_payload(payload),
+          d_first(0)
+    {
+        message_port_register_out(PORT_OUT);
+    }
+
+    bool start() override
+    {
+        d_thread = gr::thread::thread([this]() { run(); });
+        return block::start();
+    }
+
+    bool stop() override
+    {
+        d_thread.interrupt();
+        d_thread.join();
+        return block::stop();
+    }
+};
+
+// Counts down the messages it expects and finishes when it has seen
+// them all, rather than when upstream does: the "done" from upstream
+// can overtake messages still queued on the input port.
+class counting_block : public gr::block
+{
+    long d_left;
+
+protected:
+    counting_block(const std::string& name, long nmsgs)
+        : gr::block(name,
+                    gr::io_signature::make(0, 0, 0),
+                    gr::io_signature::make(0, 0, 0)),
+          d_left(nmsgs)
+    {
+        message_port_register_in(PORT_IN);
+        set_msg_queue_policy(PORT_IN, QUEUE_DEPTH, gr::msg_port_queue::BLOCK);
+        set_msg_handler(PORT_SYSTEM, [](pmt::pmt_t) {});
+    }
+
+    void count()
+    {
+        if (--d_left == 0)
+            system_handler(pmt::cons(pmt::mp("done"), pmt::from_long(1)));
+    }
+};
+
+class relay : public counting_block
+{
+public:
+    relay(long nmsgs) : counting_block("relay", nmsgs)
+    {
+        message_port_register_out(PORT_OUT);
+        set_msg_handler(PORT_IN, [this](pmt::pmt_t msg) {
+            message_port_pub(PORT_OUT, msg);
+            count();
+        });
+    }
+};
+
+class sink : public counting_block
+{
+public:
+    std::vector<float> d_latency_us;
+    gr::high_res_timer_type d_last;
+
+    sink(long nmsgs) : counting_block("sink", nmsgs), d_last(0)
+    {
+        d_latency_us.reserve(nmsgs);
+        set_msg_handler(PORT_IN, [this](pmt::pmt_t msg) {
+            d_last = gr::high_res_timer_now();
+            gr::high_res_timer_type sent = pmt::to_uint64(pmt::car(msg));
+            d_latency_us.push_back(1e6 * (d_last - sent) / gr::high_res_timer_tps());
+            count();
+        });
+    }
+};
+
+typedef std::shared_ptr<source> source_sptr;
+typedef std::shared_ptr<sink> sink_sptr;
+
+double percentile(const std::vector<float>& sorted, double p)
+{
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+
+void report(const char* shape,
+            size_t payload,
+            const std::vector<source_sptr>& sources,
+            const std::vector<sink_sptr>& sinks)
+{
+    gr::high_res_timer_type first = sources[0]->d_first;
+    for (const auto& src : sources)
+        first = std::min(first, src->d_first);
+
+    gr::high_res_timer_type last = 0;
+    std::vector<float> lat;
+    for (const auto& snk : sinks) {
+        last = std::max(last, snk->d_last);
+        lat.insert(lat.end(), snk->d_latency_us.begin(), snk->d_latency_us.end());
+    }
+    std::sort(lat.begin(), lat.end());
+
+    double secs = (double)(last - first) / gr::high_res_timer_tps();
+    printf("%-8s %6zu B %10.0f msgs/s   latency us: p50 %8.1f  p99 %8.1f  "
+           "p999 %8.1f\n",
+           shape,
+           payload,
+           lat.size() / secs,
+           percentile(lat, 0.50),
+           percentile(lat, 0.99),
+           percentile(lat, 0.999));
+}
+
+void run(const char* shape,
+         size_t payload,
+         long nmsgs,
+         int nsources,
+         int nsinks,
+         int nrelays)
+{
+    gr::top_block_sptr tb = gr::make_top_block("benchmark_msg_passing");
+
+    std::vector<source_sptr> sources;
+    for (int i = 0; i < nsources; i++)
+        sources.push_back(gnuradio::make_block_sptr<source>(nmsgs, payload));
+
+    // Everything downstream of the sources sees all of their messages.
+    long nexpected = nmsgs * nsources;
+    std::vector<gr::basic_block_sptr> heads(sources.begin(), sources.end());
+    for (int i = 0; i < nrelays; i++) {
+        auto r = gnuradio::make_block_sptr<relay>(nexpected);
+        for (const auto& h : heads)
+            tb->msg_connect(h, PORT_OUT, r, PORT_IN);
+        heads.assign(1, r);
+    }
+
+    std::vector<sink_sptr> sinks;
+    for (int i = 0; i < nsinks; i++) {
+        sinks.push_back(gnuradio::make_block_sptr<sink>(nexpected));
+        for (const auto& h : heads)
+            tb->msg_connect(h, PORT_OUT, sinks.back(), PORT_IN);
+    }
+
+    tb->run();
+    report(shape, payload, sources, sinks);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long nmsgs = argc > 1 ? atol(argv[1]) : 100000;
+    int width = argc > 2 ? atoi(argv[2]) : 4;
+    int length = argc > 3 ? atoi(argv[3]) : 8;
+
+    const char* sched = getenv("GR_SCHEDULER");
+    printf("scheduler %s, %ld msgs per source, width %d, length %d\n",
+           sched ? sched : "default",
+           nmsgs,
+           width,
+           length);
+
+    for (size_t payload : { 0, 64, 1500, 65536 }) {
+        // Keep the big ones from taking all day.
+        long n = payload > 4096 ? std::max(nmsgs / 10, 1L) : nmsgs;
+        run("1->1", payload, n, 1, 1, 0);
+        run("fan-out", payload, n, 1, width, 0);
+        run("fan-in", payload, n, width, 1, 0);
+        run("chain", payload, n, 1, 1, length);
+    }
+
+    return 0;
+}
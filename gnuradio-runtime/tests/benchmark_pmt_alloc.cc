@@ -0,0 +1,167 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures how many pmts per second can be made and dropped: integers,
+ * pairs and 64 byte u8vectors, first all in one thread, then made in
+ * one thread and dropped in another, the way messages travel between
+ * blocks.
+ *
+ * For comparison, the same is done with objects of about the same size
+ * allocated the way pmts used to be: with new, wrapped in a shared_ptr.
+ *
+ * usage: benchmark_pmt_alloc [nobjects]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/high_res_timer.h>
+#include <pmt/pmt.h>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Stand-ins for the pmt classes, allocated the way pmts used to be.
+struct heap_base {
+    virtual ~heap_base() {}
+};
+struct heap_integer : heap_base {
+    long v;
+    heap_integer(long v) : v(v) {}
+};
+struct heap_pair : heap_base {
+    std::shared_ptr<heap_base> car, cdr;
+    heap_pair(std::shared_ptr<heap_base> a, std::shared_ptr<heap_base> d)
+        : car(a), cdr(d)
+    {
+    }
+};
+struct heap_u8vector : heap_base {
+    std::vector<uint8_t> v;
+    heap_u8vector(size_t n) : v(n) {}
+};
+
+typedef std::function<void(std::vector<pmt::pmt_t>&, size_t)> pmt_maker;
+typedef std::function<void(std::vector<std::shared_ptr<heap_base>>&, size_t)> heap_maker;
+
+const size_t BATCH = 1024; // objects made before any are dropped
+
+double seconds_since(gr::high_res_timer_type t0)
+{
+    return (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+}
+
+template <typename T, typename Make>
+double run_local(long n, Make make)
+{
+    std::vector<T> v(BATCH);
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+    for (long done = 0; done < n; done += BATCH) {
+        for (size_t i = 0; i < BATCH; i++)
+            make(v, i);
+        for (auto& x : v)
+            x.reset();
+    }
+    return seconds_since(t0);
+}
+
+// One thread fills batches, another empties them.
+template <typename T, typename Make>
+double run_handoff(long n, Make make)
+{
+    const size_t nslots = 8;
+    std::vector<std::vector<T>> slots(nslots, std::vector<T>(BATCH));
+    std::vector<std::atomic<bool>> full(nslots);
+    for (auto& f : full)
+        f = false;
+    long nbatches = n / BATCH;
+
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+    boost::thread consumer([&]() {
+        for (long b = 0; b < nbatches; b++) {
+            size_t s = b % nslots;
+            while (!full[s].load(std::memory_order_acquire))
+                boost::this_thread::yield();
+            for (auto& x : slots[s])
+                x.reset();
+            full[s].store(false, std::memory_order_release);
+        }
+    });
+    for (long b = 0; b < nbatches; b++) {
+        size_t s = b % nslots;
+        while (full[s].load(std::memory_order_acquire))
+            boost::this_thread::yield();
+        for (size_t i = 0; i < BATCH; i++)
+            make(slots[s], i);
+        full[s].store(true, std::memory_order_release);
+    }
+    consumer.join();
+    return seconds_since(t0);
+}
+
+void report(const char* what, const char* how, long n, double secs)
+{
+    printf("%-12s %-18s %8.2f Mallocs/s\n", what, how, 1e-6 * n / secs);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 10000000;
+
+    struct {
+        const char* name;
+        pmt_maker pmt;
+        heap_maker heap;
+    } kinds[] = {
+        { "integer",
+          [](std::vector<pmt::pmt_t>& v, size_t i) { v[i] = pmt::from_long(i); },
+          [](std::vector<std::shared_ptr<heap_base>>& v, size_t i) {
+              v[i] = std::shared_ptr<heap_base>(new heap_integer(i));
+          } },
+        { "pair",
+          [](std::vector<pmt::pmt_t>& v, size_t i) {
+              v[i] = pmt::cons(pmt::from_long(i), pmt::PMT_NIL);
+          },
+          [](std::vector<std::shared_ptr<heap_base>>& v, size_t i) {
+              v[i] = std::shared_ptr<heap_base>(new heap_pair(
+                  std::shared_ptr<heap_base>(new heap_integer(i)), nullptr));
+          } },
+        { "u8vector[64]",
+          [](std::vector<pmt::pmt_t>& v, size_t i) { v[i] = pmt::make_u8vector(64, 0); },
+          [](std::vector<std::shared_ptr<heap_base>>& v, size_t i) {
+              v[i] = std::shared_ptr<heap_base>(new heap_u8vector(64));
+          } },
+    };
+
+    for (auto& k : kinds) {
+        report(k.name, "pmt, 1 thread", n, run_local<pmt::pmt_t>(n, k.pmt));
+        report(k.name,
+               "heap, 1 thread",
+               n,
+               run_local<std::shared_ptr<heap_base>>(n, k.heap));
+        report(k.name, "pmt, handoff", n, run_handoff<pmt::pmt_t>(n, k.pmt));
+        report(k.name,
+               "heap, handoff",
+               n,
+               run_handoff<std::shared_ptr<heap_base>>(n, k.heap));
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures building a pmt dict with dict_add and looking keys up in it
+ * with dict_ref, for dicts of 10, 100 and 1000 symbol keys.
+ *
+ * The same workload is also run through an a-list built the way
+ * dict_add used to, for comparison.
+ *
+ * usage: benchmark_pmt_dict [nops]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/high_res_timer.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The old a-list dict, kept here to compare against.
+pmt::pmt_t alist_delete(const pmt::pmt_t& dict, const pmt::pmt_t& key)
+{
+    if (pmt::is_null(dict))
+        return dict;
+    if (pmt::eqv(pmt::caar(dict), key))
+        return pmt::cdr(dict);
+    return pmt::dcons(pmt::car(dict), alist_delete(pmt::cdr(dict), key));
+}
+
+pmt::pmt_t
+alist_add(const pmt::pmt_t& dict, const pmt::pmt_t& key, const pmt::pmt_t& value)
+{
+    if (pmt::is_pair(pmt::assv(key, dict)))
+        return pmt::acons(key, value, alist_delete(dict, key));
+    return pmt::acons(key, value, dict);
+}
+
+pmt::pmt_t alist_ref(const pmt::pmt_t& dict, const pmt::pmt_t& key)
+{
+    pmt::pmt_t p = pmt::assv(key, dict);
+    return pmt::is_pair(p) ? pmt::cdr(p) : pmt::PMT_NIL;
+}
+
+struct dict_ops {
+    pmt::pmt_t (*add)(const pmt::pmt_t&, const pmt::pmt_t&, const pmt::pmt_t&);
+    pmt::pmt_t (*ref)(const pmt::pmt_t&, const pmt::pmt_t&);
+};
+
+pmt::pmt_t hashed_ref(const pmt::pmt_t& dict, const pmt::pmt_t& key)
+{
+    return pmt::dict_ref(dict, key, pmt::PMT_NIL);
+}
+
+const dict_ops alist_ops = { alist_add, alist_ref };
+const dict_ops hashed_ops = { pmt::dict_add, hashed_ref };
+
+double seconds_since(gr::high_res_timer_type t0)
+{
+    return (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+}
+
+// Build dicts of nkeys keys, rounds times over, then look every key up
+// in the last one rounds times over. Returns seconds spent in each.
+void run(const dict_ops& ops,
+         const std::vector<pmt::pmt_t>& keys,
+         long rounds,
+         double& add_secs,
+         double& ref_secs)
+{
+    pmt::pmt_t value = pmt::from_long(0);
+    pmt::pmt_t dict;
+
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+    for (long r = 0; r < rounds; r++) {
+        dict = pmt::make_dict();
+        for (const auto& k : keys)
+            dict = ops.add(dict, k, value);
+    }
+    add_secs = seconds_since(t0);
+
+    long nfound = 0;
+    t0 = gr::high_res_timer_now();
+    for (long r = 0; r < rounds; r++) {
+        for (const auto& k : keys)
+            nfound += !pmt::is_null(ops.ref(dict, k));
+    }
+    ref_secs = seconds_since(t0);
+
+    if (nfound != rounds * (long)keys.size())
+        fprintf(stderr,
+                "lost keys: %ld of %ld found\n",
+                nfound,
+                rounds * (long)keys.size());
+}
+
+void report(const char* what, size_t nkeys, long nops, double add_secs, double ref_secs)
+{
+    printf("%-8s %5zu keys  add %9.1f ns/op  ref %9.1f ns/op\n",
+           what,
+           nkeys,
+           1e9 * add_secs / nops,
+           1e9 * ref_secs / nops);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long total = argc > 1 ? atol(argv[1]) : 200000;
+
+    for (size_t nkeys : { 10, 100, 1000 }) {
+        std::vector<pmt::pmt_t> keys;
+        for (size_t i = 0; i < nkeys; i++)
+            keys.push_back(pmt::mp("key" + std::to_string(i)));
+
+        long rounds = std::max(1L, total / (long)nkeys);
+        long nops = rounds * nkeys;
+        double add_secs, ref_secs;
+
+        run(alist_ops, keys, rounds, add_secs, ref_secs);
+        report("a-list", nkeys, nops, add_secs, ref_secs);
+
+        run(hashed_ops, keys, rounds, add_secs, ref_secs);
+        report("hashed", nkeys, nops, add_secs, ref_secs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures looking up already interned symbols from 1, 2, 4 and 8
+ * threads at once, the way blocks build tag and PDU keys from strings,
+ * and the same through PMT_SYMBOL.
+ *
+ * usage: benchmark_pmt_intern [nlookups]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/high_res_timer.h>
+#include <pmt/pmt.h>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* keys[] = { "rx_time", "rx_freq", "rx_rate", "packet_len",
+                       "burst",   "tx_sob",  "tx_eob",  "tx_time",
+                       "freq",    "phase",   "strobe",  "snr" };
+const size_t NKEYS = sizeof(keys) / sizeof(keys[0]);
+
+void by_name(long n)
+{
+    std::vector<std::string> names(keys, keys + NKEYS);
+    for (long i = 0; i < n; i++)
+        pmt::intern(names[i % NKEYS]);
+}
+
+void by_macro(long n)
+{
+    for (long i = 0; i < n; i++)
+        if (!pmt::is_symbol(PMT_SYMBOL("packet_len")))
+            abort();
+}
+
+void run(const char* what, void (*f)(long), long n)
+{
+    for (int nthreads = 1; nthreads <= 8; nthreads *= 2) {
+        gr::high_res_timer_type t0 = gr::high_res_timer_now();
+        std::vector<boost::thread> threads;
+        for (int t = 0; t < nthreads; t++)
+            threads.emplace_back(f, n);
+        for (auto& t : threads)
+            t.join();
+        double secs = (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+        printf("%-10s %d threads %8.2f Mlookups/s\n",
+               what,
+               nthreads,
+               1e-6 * n * nthreads / secs);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 2000000;
+
+    for (auto k : keys)
+        pmt::intern(k);
+
+    run("intern", by_name, n);
+    run("PMT_SYMBOL", by_macro, n);
+
+    return 0;
+}
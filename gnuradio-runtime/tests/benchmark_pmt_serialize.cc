@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures serializing and deserializing typical message pmts: a stream
+ * tag, a 1500 byte PDU and a 1024 item f32vector, both through a
+ * std::stringbuf and straight to and from memory.
+ *
+ * usage: benchmark_pmt_serialize [nops]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/high_res_timer.h>
+#include <pmt/pmt.h>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace {
+
+double seconds_since(gr::high_res_timer_type t0)
+{
+    return (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+}
+
+void report(const char* what, const char* how, long n, double secs)
+{
+    printf("%-10s %-18s %9.1f ns/op\n", what, how, 1e9 * secs / n);
+}
+
+void run(const char* what, const pmt::pmt_t& obj, long n)
+{
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+    for (long i = 0; i < n; i++) {
+        std::stringbuf sb;
+        pmt::serialize(obj, sb);
+    }
+    report(what, "serialize sb", n, seconds_since(t0));
+
+    t0 = gr::high_res_timer_now();
+    for (long i = 0; i < n; i++) {
+        std::string buf;
+        pmt::serialize_append(obj, buf);
+    }
+    report(what, "serialize_append", n, seconds_since(t0));
+
+    std::string bytes = pmt::serialize_str(obj);
+    t0 = gr::high_res_timer_now();
+    for (long i = 0; i < n; i++) {
+        std::stringbuf sb(bytes);
+        pmt::deserialize(sb);
+    }
+    report(what, "deserialize sb", n, seconds_since(t0));
+
+    t0 = gr::high_res_timer_now();
+    for (long i = 0; i < n; i++) {
+        size_t used;
+        pmt::deserialize_buffer(bytes.data(), bytes.size(), used);
+    }
+    report(what, "deserialize_buffer", n, seconds_since(t0));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 200000;
+
+    pmt::pmt_t tag = pmt::list3(
+        pmt::mp("rx_time"),
+        pmt::make_tuple(pmt::from_uint64(1234567890), pmt::from_double(0.125)),
+        pmt::mp("usrp_source0"));
+    pmt::pmt_t meta = pmt::dict_add(pmt::make_dict(), pmt::mp("seq"), pmt::from_long(7));
+    pmt::pmt_t pdu = pmt::cons(meta, pmt::make_u8vector(1500, 0x55));
+    pmt::pmt_t samples = pmt::make_f32vector(1024, 0.5);
+
+    run("tag", tag, n);
+    run("pdu[1500]", pdu, n);
+    run("f32[1024]", samples, n / 10);
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures how much a scheduler gets through per core, and how often
+ * it has the kernel switch threads to do so:
+ *
+ *   source -> copy -> ... -> copy -> sink     (nchains of these)
+ *
+ * Each source counts out nitems and quits. Throughput is given both
+ * against the wall clock and against the CPU time the process used,
+ * the latter being the per-core figure. Context switches come from
+ * getrusage() and cover every thread in the process.
+ *
+ * usage: benchmark_scheduler [nitems] [nchains] [nstages]
+ * Run with GR_SCHEDULER set to compare schedulers.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/sync_block.h>
+#include <gnuradio/top_block.h>
+
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+class counter : public gr::sync_block
+{
+    long d_nitems;
+    long d_count;
+
+public:
+    counter(long nitems)
+        : gr::sync_block("counter",
+                         gr::io_signature::make(0, 0, 0),
+                         gr::io_signature::make(1, 1, sizeof(float))),
+          d_nitems(nitems),
+          d_count(0)
+    {
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        if (d_count >= d_nitems)
+            return WORK_DONE;
+
+        float* out = static_cast<float*>(output_items[0]);
+        int n = std::min((long)noutput_items, d_nitems - d_count);
+        for (int i = 0; i < n; i++)
+            out[i] = (float)(d_count + i);
+        d_count += n;
+        return n;
+    }
+};
+
+class copy : public gr::sync_block
+{
+public:
+    copy()
+        : gr::sync_block("copy",
+                         gr::io_signature::make(1, 1, sizeof(float)),
+                         gr::io_signature::make(1, 1, sizeof(float)))
+    {
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        memcpy(output_items[0], input_items[0], noutput_items * sizeof(float));
+        return noutput_items;
+    }
+};
+
+class sink : public gr::sync_block
+{
+public:
+    sink()
+        : gr::sync_block("sink",
+                         gr::io_signature::make(1, 1, sizeof(float)),
+                         gr::io_signature::make(0, 0, 0))
+    {
+    }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override
+    {
+        return noutput_items;
+    }
+};
+
+double timeval_to_double(const struct timeval* tv)
+{
+    return (double)tv->tv_sec + (double)tv->tv_usec * 1e-6;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long nitems = argc > 1 ? atol(argv[1]) : 100000000;
+    int nchains = argc > 2 ? atoi(argv[2]) : 4;
+    int nstages = argc > 3 ? atoi(argv[3]) : 8;
+
+    gr::top_block_sptr tb = gr::make_top_block("benchmark_scheduler");
+
+    for (int i = 0; i < nchains; i++) {
+        gr::basic_block_sptr prev = gnuradio::make_block_sptr<counter>(nitems);
+        for (int j = 0; j < nstages; j++) {
+            auto c = gnuradio::make_block_sptr<copy>();
+            tb->connect(prev, 0, c, 0);
+            prev = c;
+        }
+        tb->connect(prev, 0, gnuradio::make_block_sptr<sink>(), 0);
+    }
+
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage rusage_start;
+    struct rusage rusage_stop;
+    if (getrusage(RUSAGE_SELF, &rusage_start) < 0) {
+        perror("getrusage");
+        exit(1);
+    }
+#endif
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+
+    tb->run();
+
+    double wall = double(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+
+    // Every stage moves every item once.
+    double total = double(nitems) * nchains * nstages;
+    const char* sched = getenv("GR_SCHEDULER");
+    printf("%s: %d chains of %d stages, %ld items each\n",
+           sched ? sched : "default",
+           nchains,
+           nstages,
+           nitems);
+    printf("  wall: %8.3f s  items/s: %10.3e\n", wall, total / wall);
+
+#ifdef HAVE_SYS_RESOURCE_H
+    if (getrusage(RUSAGE_SELF, &rusage_stop) < 0) {
+        perror("getrusage");
+        exit(1);
+    }
+
+    double cpu = timeval_to_double(&rusage_stop.ru_utime) -
+                 timeval_to_double(&rusage_start.ru_utime) +
+                 timeval_to_double(&rusage_stop.ru_stime) -
+                 timeval_to_double(&rusage_start.ru_stime);
+    long nvcsw = rusage_stop.ru_nvcsw - rusage_start.ru_nvcsw;
+    long nivcsw = rusage_stop.ru_nivcsw - rusage_start.ru_nivcsw;
+
+    printf("  cpu:  %8.3f s  items/s per core: %10.3e\n", cpu, total / cpu);
+    printf("  context switches: %ld voluntary, %ld involuntary, %.1f per Mitem\n",
+           nvcsw,
+           nivcsw,
+           1e6 * (nvcsw + nivcsw) / total);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Measures how many tags per second go through a buffer's tag store:
+ * the writer adds tags as it writes, the reader fetches the tags for
+ * each chunk it reads, and old tags get pruned as space frees up.
+ *
+ * The same workload is also run through a std::multimap used the way
+ * gr::buffer used to, for comparison.
+ *
+ * usage: benchmark_tags [ntags] [items_per_tag]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/buffer.h>
+#include <gnuradio/high_res_timer.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+namespace {
+
+const int chunk = 256; // items per work() call
+
+// The old tag store, kept here to compare against.
+class multimap_store
+{
+    std::multimap<uint64_t, gr::tag_t> d_tags;
+    uint64_t d_keep;
+
+public:
+    multimap_store(uint64_t keep) : d_keep(keep) {}
+
+    void add(const gr::tag_t& tag)
+    {
+        d_tags.insert(std::pair<uint64_t, gr::tag_t>(tag.offset, tag));
+    }
+
+    void get(std::vector<gr::tag_t>& v, uint64_t start, uint64_t end, long id)
+    {
+        v.clear();
+        auto itr = d_tags.lower_bound(start);
+        auto itr_end = d_tags.upper_bound(end);
+        for (; itr != itr_end; ++itr) {
+            uint64_t item_time = itr->second.offset;
+            if (item_time >= start && item_time < end) {
+                if (std::find(itr->second.marked_deleted.begin(),
+                              itr->second.marked_deleted.end(),
+                              id) == itr->second.marked_deleted.end()) {
+                    v.push_back(itr->second);
+                }
+            }
+        }
+    }
+
+    void prune(uint64_t max_time)
+    {
+        auto itr = d_tags.begin();
+        while (itr != d_tags.end() && itr->second.offset + d_keep < max_time)
+            itr = d_tags.erase(itr);
+    }
+};
+
+// Key and value are shared, so what's timed is the store itself.
+gr::tag_t make_tag(uint64_t offset)
+{
+    static const pmt::pmt_t key = pmt::mp("rx_time");
+    static const pmt::pmt_t value = pmt::from_uint64(0);
+
+    gr::tag_t t;
+    t.offset = offset;
+    t.key = key;
+    t.value = value;
+    return t;
+}
+
+double seconds_since(gr::high_res_timer_type t0)
+{
+    return (double)(gr::high_res_timer_now() - t0) / gr::high_res_timer_tps();
+}
+
+// Write and read the buffer a chunk at a time, with a tag every
+// items_per_tag items. Returns the number of tags the reader saw.
+template <typename GetTags>
+long run_buffer(long ntags, int items_per_tag, GetTags get_tags)
+{
+    gr::buffer_sptr buf(gr::make_buffer(8192, sizeof(int), gr::block_sptr()));
+    gr::buffer_reader_sptr reader(gr::buffer_add_reader(buf, 0, gr::block_sptr()));
+
+    long nitems = ntags * items_per_tag;
+    long nseen = 0;
+    uint64_t written = 0;
+    while ((long)written < nitems) {
+        buf->space_available(); // prunes
+        for (uint64_t o = written; o < written + chunk; o++) {
+            if (o % items_per_tag == 0)
+                buf->add_item_tag(make_tag(o));
+        }
+        buf->update_write_pointer(chunk);
+
+        nseen += get_tags(reader, written, written + chunk);
+        reader->update_read_pointer(chunk);
+        written += chunk;
+    }
+    return nseen;
+}
+
+long run_multimap(long ntags, int items_per_tag)
+{
+    multimap_store store(8192);
+    std::vector<gr::tag_t> v;
+
+    long nitems = ntags * items_per_tag;
+    long nseen = 0;
+    uint64_t written = 0;
+    while ((long)written < nitems) {
+        store.prune(written);
+        for (uint64_t o = written; o < written + chunk; o++) {
+            if (o % items_per_tag == 0)
+                store.add(make_tag(o));
+        }
+        store.get(v, written, written + chunk, 0);
+        nseen += v.size();
+        written += chunk;
+    }
+    return nseen;
+}
+
+void report(const char* what, long nseen, double secs)
+{
+    printf("%-28s %9ld tags  %8.3f s  %8.2f Mtags/s\n",
+           what,
+           nseen,
+           secs,
+           1e-6 * nseen / secs);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long ntags = argc > 1 ? atol(argv[1]) : 2000000;
+    int items_per_tag = argc > 2 ? atoi(argv[2]) : 4;
+
+    gr::high_res_timer_type t0 = gr::high_res_timer_now();
+    long n = run_multimap(ntags, items_per_tag);
+    report("std::multimap (old)", n, seconds_since(t0));
+
+    std::vector<gr::tag_t> v;
+    t0 = gr::high_res_timer_now();
+    n = run_buffer(ntags,
+                   items_per_tag,
+                   [&v](gr::buffer_reader_sptr& r, uint64_t start, uint64_t end) {
+                       r->get_tags_in_range(v, start, end, 0);
+                       return (long)v.size();
+                   });
+    report("buffer get_tags_in_range", n, seconds_since(t0));
+
+    t0 = gr::high_res_timer_now();
+    n = run_buffer(ntags,
+                   items_per_tag,
+                   [](gr::buffer_reader_sptr& r, uint64_t start, uint64_t end) {
+                       long count = 0;
+                       r->visit_tags_in_range(
+                           start, end, 0, [&count](const gr::tag_t&, uint64_t) {
+                               count++;
+                           });
+                       return count;
+                   });
+    report("buffer visit_tags_in_range", n, seconds_since(t0));
+
+    return 0;
+}
@@ -25,6 +25,10 @@ BLOCKS_API const pmt::pmt_t pdu_port_id();
 BLOCKS_API size_t itemsize(vector_type type);
 BLOCKS_API bool type_matches(vector_type type, pmt::pmt_t v);
 BLOCKS_API pmt::pmt_t make_pdu_vector(vector_type type, const uint8_t* buf, size_t items);
+//! As make_pdu_vector(), but referencing \p buf rather than copying it.
+BLOCKS_API pmt::pmt_t make_pdu_vector_view(vector_type type,
+                                           const std::shared_ptr<uint8_t>& buf,
+                                           size_t items);
 BLOCKS_API vector_type type_from_pmt(pmt::pmt_t vector);
 
 } /* namespace pdu */
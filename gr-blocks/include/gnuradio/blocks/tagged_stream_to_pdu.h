@@ -26,6 +26,11 @@ namespace blocks {
  * The sent message is a PMT-pair (created by pmt::cons()). The
  * first element is a dictionary containing all the tags. The
  * second is a vector containing the actual data.
+ *
+ * With zero copy set, the vector refers to the items in the input
+ * buffer instead of a copy of them where it can, and the block
+ * upstream can't overwrite them until every copy of the PDU is gone.
+ * Only use it if whatever receives the PDUs lets go of them promptly.
  */
 class BLOCKS_API tagged_stream_to_pdu : virtual public tagged_stream_block
 {
@@ -41,6 +46,10 @@ public:
      */
     static sptr make(pdu::vector_type type,
                      const std::string& lengthtagname = "packet_len");
+
+    //! Whether PDUs refer to the input buffer rather than a copy of it.
+    virtual void set_zero_copy(bool zero_copy) = 0;
+    virtual bool zero_copy() const = 0;
 };
 
 } /* namespace blocks */
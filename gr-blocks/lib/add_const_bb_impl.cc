@@ -29,6 +29,7 @@ add_const_bb_impl::add_const_bb_impl(unsigned char k)
                  io_signature::make(1, 1, sizeof(unsigned char))),
       d_k(k)
 {
+    set_inplace(true);
 }
 
 add_const_bb_impl::~add_const_bb_impl() {}
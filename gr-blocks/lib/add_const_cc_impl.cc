@@ -29,6 +29,7 @@ add_const_cc_impl::add_const_cc_impl(gr_complex k)
                  io_signature::make(1, 1, sizeof(gr_complex))),
       d_k(k)
 {
+    set_inplace(true);
 }
 
 void add_const_cc_impl::set_k(gr_complex k)
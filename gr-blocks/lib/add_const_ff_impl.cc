@@ -29,6 +29,7 @@ add_const_ff_impl::add_const_ff_impl(float k)
                  io_signature::make(1, 1, sizeof(float))),
       d_k(k)
 {
+    set_inplace(true);
 }
 
 void add_const_ff_impl::set_k(float k)
@@ -29,6 +29,7 @@ add_const_ii_impl::add_const_ii_impl(int k)
                  io_signature::make(1, 1, sizeof(int))),
       d_k(k)
 {
+    set_inplace(true);
 }
 
 int add_const_ii_impl::work(int noutput_items,
@@ -29,6 +29,7 @@ add_const_ss_impl::add_const_ss_impl(short k)
                  io_signature::make(1, 1, sizeof(short))),
       d_k(k)
 {
+    set_inplace(true);
 }
 
 add_const_ss_impl::~add_const_ss_impl() {}
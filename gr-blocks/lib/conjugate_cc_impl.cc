@@ -31,6 +31,7 @@ conjugate_cc_impl::conjugate_cc_impl()
 {
     const int alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
+    set_inplace(true);
 }
 
 int conjugate_cc_impl::work(int noutput_items,
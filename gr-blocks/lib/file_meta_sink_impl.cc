@@ -261,7 +261,7 @@ void file_meta_sink_impl::update_header(pmt::pmt_t key, pmt::pmt_t value)
 {
     // Special handling caveat to transform rate from radio source into
     // the rate at this sink.
-    if (pmt::eq(key, mp("rx_rate"))) {
+    if (pmt::eq(key, PMT_SYMBOL("rx_rate"))) {
         d_samp_rate = pmt::to_double(value);
         value = pmt::from_double(d_samp_rate * d_relative_rate);
     }
@@ -293,11 +293,13 @@ void file_meta_sink_impl::update_last_header_inline()
     // Update the last header info with the number of samples this
     // block represents.
 
-    size_t hdrlen = pmt::to_uint64(pmt::dict_ref(d_header, mp("strt"), pmt::PMT_NIL));
+    size_t hdrlen =
+        pmt::to_uint64(pmt::dict_ref(d_header, PMT_SYMBOL("strt"), pmt::PMT_NIL));
     size_t seg_size = d_itemsize * d_total_seg_size;
     pmt::pmt_t s = pmt::from_uint64(seg_size);
-    update_header(mp("bytes"), s);
-    update_header(mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size));
+    update_header(PMT_SYMBOL("bytes"), s);
+    update_header(PMT_SYMBOL("strt"),
+                  pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size));
     if (fseek(d_fp, -seg_size - hdrlen, SEEK_CUR) == -1) {
         throw std::runtime_error("fseek() failed.");
     }
@@ -311,11 +313,13 @@ void file_meta_sink_impl::update_last_header_detached()
 {
     // Update the last header info with the number of samples this
     // block represents.
-    size_t hdrlen = pmt::to_uint64(pmt::dict_ref(d_header, mp("strt"), pmt::PMT_NIL));
+    size_t hdrlen =
+        pmt::to_uint64(pmt::dict_ref(d_header, PMT_SYMBOL("strt"), pmt::PMT_NIL));
     size_t seg_size = d_itemsize * d_total_seg_size;
     pmt::pmt_t s = pmt::from_uint64(seg_size);
-    update_header(mp("bytes"), s);
-    update_header(mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size));
+    update_header(PMT_SYMBOL("bytes"), s);
+    update_header(PMT_SYMBOL("strt"),
+                  pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size));
     if (fseek(d_hdr_fp, -hdrlen, SEEK_CUR) == -1) {
         throw std::runtime_error("fseek() failed.");
     }
@@ -328,13 +332,13 @@ void file_meta_sink_impl::write_and_update()
     // based on current index + header size.
     // uint64_t loc = get_last_header_loc();
     pmt::pmt_t s = pmt::from_uint64(0);
-    update_header(mp("bytes"), s);
+    update_header(PMT_SYMBOL("bytes"), s);
 
     // If we have multiple tags on the same offset, this makes
     // sure we just overwrite the same header each time instead
     // of creating a new header per tag.
     s = pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size);
-    update_header(mp("strt"), s);
+    update_header(PMT_SYMBOL("strt"), s);
 
     if (d_state == STATE_DETACHED)
         write_header(d_hdr_fp, d_header, d_extra);
@@ -344,7 +348,7 @@ void file_meta_sink_impl::write_and_update()
 
 void file_meta_sink_impl::update_rx_time()
 {
-    pmt::pmt_t rx_time = pmt::string_to_symbol("rx_time");
+    pmt::pmt_t rx_time = PMT_SYMBOL("rx_time");
     pmt::pmt_t r = pmt::dict_ref(d_header, rx_time, pmt::PMT_NIL);
     uint64_t secs = pmt::to_uint64(pmt::tuple_ref(r, 0));
     double fracs = pmt::to_double(pmt::tuple_ref(r, 1));
@@ -126,8 +126,8 @@ bool file_meta_source_impl::read_header(pmt::pmt_t& hdr, pmt::pmt_t& extras)
 
     uint64_t seg_start, extra_len = 0;
     pmt::pmt_t r, dump;
-    if (pmt::dict_has_key(hdr, pmt::string_to_symbol("strt"))) {
-        r = pmt::dict_ref(hdr, pmt::string_to_symbol("strt"), dump);
+    if (pmt::dict_has_key(hdr, PMT_SYMBOL("strt"))) {
+        r = pmt::dict_ref(hdr, PMT_SYMBOL("strt"), dump);
         seg_start = pmt::to_uint64(r);
         extra_len = seg_start - METADATA_HEADER_SIZE;
     }
@@ -165,7 +165,7 @@ void file_meta_source_impl::parse_header(pmt::pmt_t hdr,
     pmt::pmt_t r, key;
 
     // GET SAMPLE RATE
-    key = pmt::string_to_symbol("rx_rate");
+    key = PMT_SYMBOL("rx_rate");
     if (pmt::dict_has_key(hdr, key)) {
         r = pmt::dict_ref(hdr, key, pmt::PMT_NIL);
         d_samp_rate = pmt::to_double(r);
@@ -181,7 +181,7 @@ void file_meta_source_impl::parse_header(pmt::pmt_t hdr,
     }
 
     // GET TIME STAMP
-    key = pmt::string_to_symbol("rx_time");
+    key = PMT_SYMBOL("rx_time");
     if (pmt::dict_has_key(hdr, key)) {
         d_time_stamp = pmt::dict_ref(hdr, key, pmt::PMT_NIL);
 
@@ -196,17 +196,17 @@ void file_meta_source_impl::parse_header(pmt::pmt_t hdr,
     }
 
     // GET ITEM SIZE OF DATA
-    if (pmt::dict_has_key(hdr, pmt::string_to_symbol("size"))) {
+    if (pmt::dict_has_key(hdr, PMT_SYMBOL("size"))) {
         d_itemsize =
-            pmt::to_long(pmt::dict_ref(hdr, pmt::string_to_symbol("size"), pmt::PMT_NIL));
+            pmt::to_long(pmt::dict_ref(hdr, PMT_SYMBOL("size"), pmt::PMT_NIL));
     } else {
         throw std::runtime_error("file_meta_source: Could not extract item size.");
     }
 
     // GET SEGMENT SIZE
-    if (pmt::dict_has_key(hdr, pmt::string_to_symbol("bytes"))) {
+    if (pmt::dict_has_key(hdr, PMT_SYMBOL("bytes"))) {
         d_seg_size = pmt::to_uint64(
-            pmt::dict_ref(hdr, pmt::string_to_symbol("bytes"), pmt::PMT_NIL));
+            pmt::dict_ref(hdr, PMT_SYMBOL("bytes"), pmt::PMT_NIL));
 
         // Convert from bytes to items
         d_seg_size /= d_itemsize;
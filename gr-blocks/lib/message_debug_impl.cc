@@ -16,6 +16,7 @@
 #include <gnuradio/io_signature.h>
 #include <cstdio>
 #include <iostream>
+#include <iterator>
 
 namespace gr {
 namespace blocks {
@@ -30,43 +31,57 @@ message_debug_impl::message_debug_impl(bool en_uvec)
       d_en_uvec(en_uvec)
 {
     message_port_register_in(pmt::mp("print"));
-    set_msg_handler(pmt::mp("print"), [this](pmt::pmt_t msg) { this->print(msg); });
+    set_msg_batch_handler(pmt::mp("print"),
+                          [this](std::vector<pmt::pmt_t>& msgs) { this->print(msgs); });
 
     message_port_register_in(pmt::mp("store"));
-    set_msg_handler(pmt::mp("store"), [this](pmt::pmt_t msg) { this->store(msg); });
+    set_msg_batch_handler(pmt::mp("store"),
+                          [this](std::vector<pmt::pmt_t>& msgs) { this->store(msgs); });
 
     message_port_register_in(pmt::mp("print_pdu"));
-    set_msg_handler(pmt::mp("print_pdu"),
-                    [this](pmt::pmt_t msg) { this->print_pdu(msg); });
+    set_msg_batch_handler(
+        pmt::mp("print_pdu"),
+        [this](std::vector<pmt::pmt_t>& msgs) { this->print_pdu(msgs); });
 }
 
 message_debug_impl::~message_debug_impl() {}
 
-void message_debug_impl::print(pmt::pmt_t msg)
+void message_debug_impl::print(std::vector<pmt::pmt_t>& msgs)
 {
     std::stringstream sout;
 
-    sout << "******* MESSAGE DEBUG PRINT ********" << std::endl
-         << pmt::write_string(msg) << std::endl
-         << "************************************" << std::endl;
+    for (const pmt::pmt_t& msg : msgs) {
+        sout << "******* MESSAGE DEBUG PRINT ********" << std::endl
+             << pmt::write_string(msg) << std::endl
+             << "************************************" << std::endl;
+    }
     std::cout << sout.str();
 }
 
-void message_debug_impl::store(pmt::pmt_t msg)
+void message_debug_impl::store(std::vector<pmt::pmt_t>& msgs)
 {
     gr::thread::scoped_lock guard(d_mutex);
-    d_messages.push_back(msg);
+    d_messages.insert(d_messages.end(),
+                      std::make_move_iterator(msgs.begin()),
+                      std::make_move_iterator(msgs.end()));
 }
 
-void message_debug_impl::print_pdu(pmt::pmt_t pdu)
+void message_debug_impl::print_pdu(std::vector<pmt::pmt_t>& pdus)
 {
-    if (!pmt::is_pdu(pdu)) {
-        GR_LOG_WARN(d_logger, "Non PDU type message received. Dropping.");
-        return;
-    }
-
     std::stringstream sout;
 
+    for (const pmt::pmt_t& pdu : pdus) {
+        if (!pmt::is_pdu(pdu)) {
+            GR_LOG_WARN(d_logger, "Non PDU type message received. Dropping.");
+            continue;
+        }
+        format_pdu(sout, pdu);
+    }
+    std::cout << sout.str();
+}
+
+void message_debug_impl::format_pdu(std::ostream& sout, const pmt::pmt_t& pdu)
+{
     pmt::pmt_t meta = pmt::car(pdu);
     pmt::pmt_t vector = pmt::cdr(pdu);
 
@@ -90,6 +105,8 @@ void message_debug_impl::print_pdu(pmt::pmt_t pdu)
                 }
                 sout << std::endl;
             }
+            // The stream goes on to the next PDU of a burst.
+            sout << std::dec << std::setfill(' ');
         } else {
             sout << "pdu length = " << len << " bytes (printing disabled)" << std::endl;
         }
@@ -98,7 +115,6 @@ void message_debug_impl::print_pdu(pmt::pmt_t pdu)
     }
 
     sout << "************************************" << std::endl;
-    std::cout << sout.str();
 }
 
 int message_debug_impl::num_messages() { return (int)d_messages.size(); }
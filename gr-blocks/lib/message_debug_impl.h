@@ -32,9 +32,9 @@ private:
      * handler function is only meant to be used by the scheduler to
      * handle messages posted to port 'print'.
      *
-     * \param msg A pmt message passed from the scheduler's message handling.
+     * \param msgs The pmt messages waiting on the port, printed in one go.
      */
-    void print(pmt::pmt_t msg);
+    void print(std::vector<pmt::pmt_t>& msgs);
 
     /*!
      * \brief PDU formatted messages received in this port are printed to stdout.
@@ -44,9 +44,10 @@ private:
      * handler function is only meant to be used by the scheduler to
      * handle messages posted to port 'print'.
      *
-     * \param pdu A PDU message passed from the scheduler's message handling.
+     * \param pdus The PDU messages waiting on the port, printed in one go.
      */
-    void print_pdu(pmt::pmt_t pdu);
+    void print_pdu(std::vector<pmt::pmt_t>& pdus);
+    void format_pdu(std::ostream& sout, const pmt::pmt_t& pdu);
 
     /*!
      * \brief Messages received in this port are stored in a vector.
@@ -57,9 +58,9 @@ private:
      * message handler function is only meant to be used by the
      * scheduler to handle messages posted to port 'store'.
      *
-     * \param msg A pmt message passed from the scheduler's message handling.
+     * \param msgs The pmt messages waiting on the port, stored under one lock.
      */
-    void store(pmt::pmt_t msg);
+    void store(std::vector<pmt::pmt_t>& msgs);
 
     gr::thread::mutex d_mutex;
     std::vector<pmt::pmt_t> d_messages;
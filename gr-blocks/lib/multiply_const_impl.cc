@@ -36,6 +36,7 @@ multiply_const_impl<float>::multiply_const_impl(float k, size_t vlen)
 {
     const int alignment_multiple = volk_get_alignment() / sizeof(float);
     set_alignment(std::max(1, alignment_multiple));
+    set_inplace(true);
 }
 
 template <>
@@ -62,6 +63,7 @@ multiply_const_impl<gr_complex>::multiply_const_impl(gr_complex k, size_t vlen)
 {
     const int alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
+    set_inplace(true);
 }
 
 template <>
@@ -87,6 +89,7 @@ multiply_const_impl<T>::multiply_const_impl(T k, size_t vlen)
       d_k(k),
       d_vlen(vlen)
 {
+    this->set_inplace(true);
 }
 
 template <class T>
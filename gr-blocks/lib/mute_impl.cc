@@ -34,6 +34,7 @@ mute_impl<T>::mute_impl(bool mute)
                  io_signature::make(1, 1, sizeof(T))),
       d_mute(mute)
 {
+    this->set_inplace(true);
     this->message_port_register_in(pmt::intern("set_mute"));
     this->set_msg_handler(pmt::intern("set_mute"),
                           [this](pmt::pmt_t msg) { this->set_mute_pmt(msg); });
@@ -56,7 +57,7 @@ int mute_impl<T>::work(int noutput_items,
 
     if (d_mute) {
         std::fill_n(optr, noutput_items, 0);
-    } else {
+    } else if (optr != iptr) { // nothing to copy when running in place
         while (size >= 8) {
             *optr++ = *iptr++;
             *optr++ = *iptr++;
@@ -66,6 +66,24 @@ pmt::pmt_t make_pdu_vector(vector_type type, const uint8_t* buf, size_t items)
     }
 }
 
+pmt::pmt_t make_pdu_vector_view(vector_type type,
+                                const std::shared_ptr<uint8_t>& buf,
+                                size_t items)
+{
+    switch (type) {
+    case byte_t:
+        return pmt::make_u8vector_view(items, buf);
+    case float_t:
+        return pmt::make_f32vector_view(
+            items, std::shared_ptr<float>(buf, (float*)buf.get()));
+    case complex_t:
+        return pmt::make_c32vector_view(
+            items, std::shared_ptr<gr_complex>(buf, (gr_complex*)buf.get()));
+    default:
+        throw std::runtime_error("bad PDU type");
+    }
+}
+
 vector_type type_from_pmt(pmt::pmt_t vector)
 {
     if (pmt::is_u8vector(vector))
@@ -15,6 +15,7 @@
 #include "pdu_filter_impl.h"
 #include <gnuradio/blocks/pdu.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 
 namespace gr {
 namespace blocks {
@@ -32,27 +33,33 @@ pdu_filter_impl::pdu_filter_impl(pmt::pmt_t k, pmt::pmt_t v, bool invert)
 {
     message_port_register_out(pdu::pdu_port_id());
     message_port_register_in(pdu::pdu_port_id());
-    set_msg_handler(pdu::pdu_port_id(),
-                    [this](pmt::pmt_t msg) { this->handle_msg(msg); });
+    set_msg_batch_handler(
+        pdu::pdu_port_id(),
+        [this](std::vector<pmt::pmt_t>& pdus) { this->handle_msgs(pdus); });
 }
 
-void pdu_filter_impl::handle_msg(pmt::pmt_t pdu)
+bool pdu_filter_impl::passes(const pmt::pmt_t& pdu) const
 {
     pmt::pmt_t meta = pmt::car(pdu);
-    bool output = d_invert;
 
     // check base type
     // key exists
     // value matches
     if (pmt::is_dict(meta) && dict_has_key(meta, d_k) &&
         pmt::eqv(pmt::dict_ref(meta, d_k, pmt::PMT_NIL), d_v)) {
-        output = !d_invert;
+        return !d_invert;
     }
+    return d_invert;
+}
 
-    // if all tests pass, propagate the pdu
-    if (output) {
-        message_port_pub(pdu::pdu_port_id(), pdu);
-    }
+void pdu_filter_impl::handle_msgs(std::vector<pmt::pmt_t>& pdus)
+{
+    // propagate the pdus that pass, all at once
+    pdus.erase(std::remove_if(pdus.begin(),
+                              pdus.end(),
+                              [this](const pmt::pmt_t& pdu) { return !passes(pdu); }),
+               pdus.end());
+    message_port_pub(pdu::pdu_port_id(), pdus);
 }
 
 } /* namespace blocks */
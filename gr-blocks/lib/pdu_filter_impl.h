@@ -25,7 +25,8 @@ private:
 
 public:
     pdu_filter_impl(pmt::pmt_t k, pmt::pmt_t v, bool invert);
-    void handle_msg(pmt::pmt_t msg);
+    bool passes(const pmt::pmt_t& pdu) const;
+    void handle_msgs(std::vector<pmt::pmt_t>& pdus);
     void set_key(pmt::pmt_t key) override { d_k = key; };
     void set_val(pmt::pmt_t val) override { d_v = val; };
     void set_inversion(bool invert) override { d_invert = invert; };
@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/block.h>
+#include <gnuradio/blocks/message_debug.h>
+#include <gnuradio/blocks/pdu_filter.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+/*
+ * Passes messages from its "in" port to its "out" port a batch at a
+ * time, counting the batches.
+ */
+class batch_relay : public gr::block
+{
+public:
+    std::atomic<int> d_nbatches;
+    std::atomic<int> d_nmsgs;
+
+    batch_relay()
+        : gr::block("batch_relay",
+                    gr::io_signature::make(0, 0, 0),
+                    gr::io_signature::make(0, 0, 0)),
+          d_nbatches(0),
+          d_nmsgs(0)
+    {
+        message_port_register_in(pmt::mp("in"));
+        message_port_register_out(pmt::mp("out"));
+        set_msg_batch_handler(pmt::mp("in"), [this](std::vector<pmt::pmt_t>& msgs) {
+            d_nbatches++;
+            d_nmsgs += msgs.size();
+            message_port_pub(pmt::mp("out"), msgs);
+        });
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(t0_pub_vector)
+{
+    static const int NMSGS = 1000;
+    static const size_t NPOST = 50;
+
+    gr::top_block_sptr tb = gr::make_top_block("top");
+    auto relay = gnuradio::make_block_sptr<batch_relay>();
+    pmt::pmt_t keep = pmt::mp("keep");
+    gr::blocks::pdu_filter::sptr filter = gr::blocks::pdu_filter::make(keep, pmt::PMT_T);
+    gr::blocks::message_debug::sptr all = gr::blocks::message_debug::make();
+    gr::blocks::message_debug::sptr kept = gr::blocks::message_debug::make();
+
+    tb->msg_connect(relay, "out", all, "store");
+    tb->msg_connect(relay, "out", filter, "pdus");
+    tb->msg_connect(filter, "pdus", kept, "store");
+
+    tb->start();
+
+    // Every third PDU passes the filter.
+    std::vector<pmt::pmt_t> msgs;
+    for (int i = 0; i < NMSGS; i++) {
+        pmt::pmt_t meta = pmt::make_dict();
+        meta = pmt::dict_add(meta, keep, pmt::from_bool(i % 3 == 0));
+        meta = pmt::dict_add(meta, pmt::mp("n"), pmt::from_long(i));
+        msgs.push_back(pmt::cons(meta, pmt::make_u8vector(1, i % 256)));
+        if (msgs.size() == NPOST) {
+            relay->post(pmt::mp("in"), msgs);
+            msgs.clear();
+        }
+    }
+
+    const int nkept = (NMSGS + 2) / 3;
+    for (int i = 0; i < 500; i++) {
+        if (all->num_messages() == NMSGS && kept->num_messages() == nkept)
+            break;
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+    tb->stop();
+    tb->wait();
+
+    // The batch handler saw every message, some batches at a time.
+    BOOST_CHECK_EQUAL(NMSGS, relay->d_nmsgs);
+    BOOST_CHECK(relay->d_nbatches > 0);
+    BOOST_CHECK(relay->d_nbatches <= NMSGS);
+
+    // Everything came out, in the order it went in.
+    BOOST_REQUIRE_EQUAL(NMSGS, all->num_messages());
+    for (int i = 0; i < NMSGS; i++) {
+        pmt::pmt_t meta = pmt::car(all->get_message(i));
+        BOOST_CHECK_EQUAL(i,
+                          pmt::to_long(pmt::dict_ref(meta, pmt::mp("n"), pmt::PMT_NIL)));
+    }
+
+    BOOST_REQUIRE_EQUAL(nkept, kept->num_messages());
+    for (int i = 0; i < nkept; i++) {
+        pmt::pmt_t meta = pmt::car(kept->get_message(i));
+        BOOST_CHECK_EQUAL(3 * i,
+                          pmt::to_long(pmt::dict_ref(meta, pmt::mp("n"), pmt::PMT_NIL)));
+    }
+}
@@ -31,6 +31,7 @@ rotator_cc_impl::rotator_cc_impl(double phase_inc)
                  io_signature::make(1, 1, sizeof(gr_complex)))
 {
     set_phase_inc(phase_inc);
+    set_inplace(true);
 }
 
 rotator_cc_impl::~rotator_cc_impl() {}
@@ -36,10 +36,10 @@ socket_pdu_impl::socket_pdu_impl(std::string type,
                                  int MTU /*= 10000*/,
                                  bool tcp_no_delay /*= false*/)
     : block("socket_pdu", io_signature::make(0, 0, 0), io_signature::make(0, 0, 0)),
+      d_rxpool(MTU),
+      d_rxbuf(d_rxpool.get()),
       d_tcp_no_delay(tcp_no_delay)
 {
-    d_rxbuf.resize(MTU);
-
     message_port_register_in(pdu::pdu_port_id());
     message_port_register_out(pdu::pdu_port_id());
 
@@ -102,7 +102,7 @@ socket_pdu_impl::socket_pdu_impl(std::string type,
                         [this](pmt::pmt_t msg) { this->tcp_client_send(msg); });
 
         d_tcp_socket->async_read_some(
-            boost::asio::buffer(d_rxbuf),
+            rxbuf(),
             boost::bind(&socket_pdu_impl::handle_tcp_read,
                         this,
                         boost::asio::placeholders::error,
@@ -111,7 +111,7 @@ socket_pdu_impl::socket_pdu_impl(std::string type,
         d_udp_socket =
             std::make_shared<boost::asio::ip::udp::socket>(d_io_service, d_udp_endpoint);
         d_udp_socket->async_receive_from(
-            boost::asio::buffer(d_rxbuf),
+            rxbuf(),
             d_udp_endpoint_other,
             boost::bind(&socket_pdu_impl::handle_udp_read,
                         this,
@@ -124,7 +124,7 @@ socket_pdu_impl::socket_pdu_impl(std::string type,
         d_udp_socket =
             std::make_shared<boost::asio::ip::udp::socket>(d_io_service, d_udp_endpoint);
         d_udp_socket->async_receive_from(
-            boost::asio::buffer(d_rxbuf),
+            rxbuf(),
             d_udp_endpoint_other,
             boost::bind(&socket_pdu_impl::handle_udp_read,
                         this,
@@ -157,13 +157,12 @@ void socket_pdu_impl::handle_tcp_read(const boost::system::error_code& error,
                                       size_t bytes_transferred)
 {
     if (!error) {
-        pmt::pmt_t vector =
-            pmt::init_u8vector(bytes_transferred, (const uint8_t*)&d_rxbuf[0]);
+        pmt::pmt_t vector = d_rxpool.make_u8vector(bytes_transferred, d_rxbuf);
         pmt::pmt_t pdu = pmt::cons(pmt::PMT_NIL, vector);
         message_port_pub(pdu::pdu_port_id(), pdu);
 
         d_tcp_socket->async_read_some(
-            boost::asio::buffer(d_rxbuf),
+            rxbuf(),
             boost::bind(&socket_pdu_impl::handle_tcp_read,
                         this,
                         boost::asio::placeholders::error,
@@ -176,10 +175,10 @@ void socket_pdu_impl::start_tcp_accept()
 {
 #if (BOOST_VERSION >= 107000)
     tcp_connection::sptr new_connection =
-        tcp_connection::make(d_io_service, d_rxbuf.size(), d_tcp_no_delay);
+        tcp_connection::make(d_io_service, d_rxpool.slab_size(), d_tcp_no_delay);
 #else
     tcp_connection::sptr new_connection = tcp_connection::make(
-        d_acceptor_tcp->get_io_service(), d_rxbuf.size(), d_tcp_no_delay);
+        d_acceptor_tcp->get_io_service(), d_rxpool.slab_size(), d_tcp_no_delay);
 #endif
 
     d_acceptor_tcp->async_accept(new_connection->socket(),
@@ -219,14 +218,13 @@ void socket_pdu_impl::handle_tcp_accept(tcp_connection::sptr new_connection,
 void socket_pdu_impl::tcp_client_send(pmt::pmt_t msg)
 {
     pmt::pmt_t vector = pmt::cdr(msg);
-    size_t len = pmt::blob_length(vector);
+    size_t len = 0;
+    const char* data = (const char*)pmt::uniform_vector_elements(vector, len);
     size_t offset = 0;
-    std::vector<char> txbuf(std::min(len, d_rxbuf.size()));
     while (offset < len) {
-        size_t send_len = std::min((len - offset), txbuf.size());
-        memcpy(&txbuf[0], pmt::uniform_vector_elements(vector, offset), send_len);
+        size_t send_len = std::min((len - offset), d_rxpool.slab_size());
+        d_tcp_socket->send(boost::asio::buffer(data + offset, send_len));
         offset += send_len;
-        d_tcp_socket->send(boost::asio::buffer(txbuf, send_len));
     }
 }
 
@@ -236,14 +234,14 @@ void socket_pdu_impl::udp_send(pmt::pmt_t msg)
         return;
 
     pmt::pmt_t vector = pmt::cdr(msg);
-    size_t len = pmt::blob_length(vector);
+    size_t len = 0;
+    const char* data = (const char*)pmt::uniform_vector_elements(vector, len);
     size_t offset = 0;
-    std::vector<char> txbuf(std::min(len, d_rxbuf.size()));
     while (offset < len) {
-        size_t send_len = std::min((len - offset), txbuf.size());
-        memcpy(&txbuf[0], pmt::uniform_vector_elements(vector, offset), send_len);
+        size_t send_len = std::min((len - offset), d_rxpool.slab_size());
+        d_udp_socket->send_to(boost::asio::buffer(data + offset, send_len),
+                              d_udp_endpoint_other);
         offset += send_len;
-        d_udp_socket->send_to(boost::asio::buffer(txbuf, send_len), d_udp_endpoint_other);
     }
 }
 
@@ -251,14 +249,13 @@ void socket_pdu_impl::handle_udp_read(const boost::system::error_code& error,
                                       size_t bytes_transferred)
 {
     if (!error) {
-        pmt::pmt_t vector =
-            pmt::init_u8vector(bytes_transferred, (const uint8_t*)&d_rxbuf[0]);
+        pmt::pmt_t vector = d_rxpool.make_u8vector(bytes_transferred, d_rxbuf);
         pmt::pmt_t pdu = pmt::cons(pmt::PMT_NIL, vector);
 
         message_port_pub(pdu::pdu_port_id(), pdu);
 
         d_udp_socket->async_receive_from(
-            boost::asio::buffer(d_rxbuf),
+            rxbuf(),
             d_udp_endpoint_other,
             boost::bind(&socket_pdu_impl::handle_udp_read,
                         this,
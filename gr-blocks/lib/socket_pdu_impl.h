@@ -13,6 +13,7 @@
 
 #include "tcp_connection.h"
 #include <gnuradio/blocks/socket_pdu.h>
+#include <pmt/pmt_pool.h>
 
 namespace gr {
 namespace blocks {
@@ -21,7 +22,12 @@ class socket_pdu_impl : public socket_pdu
 {
 private:
     boost::asio::io_service d_io_service;
-    std::vector<char> d_rxbuf;
+    pmt::slab_pool d_rxpool;
+    std::shared_ptr<uint8_t> d_rxbuf; // long reads go out in it, see make_u8vector
+    boost::asio::mutable_buffers_1 rxbuf()
+    {
+        return boost::asio::buffer(d_rxbuf.get(), d_rxpool.slab_size());
+    }
     void run_io_service() { d_io_service.run(); }
     gr::thread::thread d_thread;
     bool d_started;
@@ -31,11 +31,10 @@ static const long timeout_us = 100 * 1000; // 100ms
 namespace gr {
 namespace blocks {
 
-stream_pdu_base::stream_pdu_base(int MTU) : d_fd(-1), d_started(false), d_finished(false)
+stream_pdu_base::stream_pdu_base(int MTU)
+    : d_fd(-1), d_started(false), d_finished(false), d_rxpool(MTU)
 {
     gr::configure_default_loggers(d_pdu_logger, d_pdu_debug_logger, "stream_pdu_base");
-    // reserve space for rx buffer
-    d_rxbuf.resize(MTU, 0);
 }
 
 stream_pdu_base::~stream_pdu_base() { stop_rxthread(); }
@@ -60,15 +59,16 @@ void stream_pdu_base::stop_rxthread()
 
 void stream_pdu_base::run()
 {
+    std::shared_ptr<uint8_t> rxbuf = d_rxpool.get();
     while (!d_finished) {
         if (!wait_ready())
             continue;
 
-        const int result = read(d_fd, &d_rxbuf[0], d_rxbuf.size());
+        const int result = read(d_fd, rxbuf.get(), d_rxpool.slab_size());
         if (result <= 0)
             throw std::runtime_error("stream_pdu_base, bad socket read!");
 
-        pmt::pmt_t vector = pmt::init_u8vector(result, &d_rxbuf[0]);
+        pmt::pmt_t vector = d_rxpool.make_u8vector(result, rxbuf);
         pmt::pmt_t pdu = pmt::cons(pmt::PMT_NIL, vector);
 
         d_blk->message_port_pub(d_port, pdu);
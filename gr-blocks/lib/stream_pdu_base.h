@@ -15,6 +15,7 @@
 #include <gnuradio/logger.h>
 #include <gnuradio/thread/thread.h>
 #include <pmt/pmt.h>
+#include <pmt/pmt_pool.h>
 
 class basic_block;
 
@@ -31,7 +32,7 @@ protected:
     int d_fd;
     bool d_started;
     bool d_finished;
-    std::vector<uint8_t> d_rxbuf;
+    pmt::slab_pool d_rxpool; // reads land here; long ones go out as they are
     gr::thread::thread d_thread;
 
     pmt::pmt_t d_port;
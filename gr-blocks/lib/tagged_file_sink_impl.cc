@@ -70,8 +70,8 @@ int tagged_file_sink_impl::work(int noutput_items,
 
     uint64_t start_N = nitems_read(0);
     uint64_t end_N = start_N + (uint64_t)(noutput_items);
-    pmt::pmt_t bkey = pmt::string_to_symbol("burst");
-    pmt::pmt_t tkey = pmt::string_to_symbol("rx_time"); // use gr_tags::key_time
+    pmt::pmt_t bkey = PMT_SYMBOL("burst");
+    pmt::pmt_t tkey = PMT_SYMBOL("rx_time"); // use gr_tags::key_time
 
     std::vector<tag_t> all_tags;
     get_tags_in_range(all_tags, 0, start_N, end_N);
@@ -32,6 +32,7 @@ tagged_stream_to_pdu_impl::tagged_stream_to_pdu_impl(pdu::vector_type type,
                           io_signature::make(0, 0, 0),
                           lengthtagname),
       d_type(type),
+      d_zero_copy(false),
       d_pdu_meta(pmt::PMT_NIL),
       d_pdu_vector(pmt::PMT_NIL)
 {
@@ -52,8 +53,15 @@ int tagged_stream_to_pdu_impl::work(int noutput_items,
         d_pdu_meta = dict_add(d_pdu_meta, tag.key, tag.value);
     }
 
-    // Grab data, throw into vector
-    d_pdu_vector = pdu::make_pdu_vector(d_type, in, ninput_items[0]);
+    // Grab data, throw into vector; held in place if we may and the
+    // buffer can spare it
+    std::shared_ptr<uint8_t> held;
+    if (d_zero_copy)
+        held = hold_input_items(0, 0, ninput_items[0]);
+    if (held)
+        d_pdu_vector = pdu::make_pdu_vector_view(d_type, held, ninput_items[0]);
+    else
+        d_pdu_vector = pdu::make_pdu_vector(d_type, in, ninput_items[0]);
 
     // Send msg
     pmt::pmt_t msg = pmt::cons(d_pdu_meta, d_pdu_vector);
@@ -19,6 +19,7 @@ namespace blocks {
 class BLOCKS_API tagged_stream_to_pdu_impl : public tagged_stream_to_pdu
 {
     const pdu::vector_type d_type;
+    bool d_zero_copy;
     pmt::pmt_t d_pdu_meta;
     pmt::pmt_t d_pdu_vector;
     std::vector<tag_t> d_tags;
@@ -26,6 +27,9 @@ class BLOCKS_API tagged_stream_to_pdu_impl : public tagged_stream_to_pdu
 public:
     tagged_stream_to_pdu_impl(pdu::vector_type type, const std::string& lengthtagname);
 
+    void set_zero_copy(bool zero_copy) override { d_zero_copy = zero_copy; }
+    bool zero_copy() const override { return d_zero_copy; }
+
     int work(int noutput_items,
              gr_vector_int& ninput_items,
              gr_vector_const_void_star& input_items,
@@ -29,7 +29,7 @@ tcp_connection::sptr tcp_connection::make(boost::asio::io_service& io_service,
 tcp_connection::tcp_connection(boost::asio::io_service& io_service,
                                int MTU /*= 10000*/,
                                bool no_delay /*=false*/)
-    : d_socket(io_service), d_buf(MTU), d_block(NULL), d_no_delay(no_delay)
+    : d_socket(io_service), d_pool(MTU), d_block(NULL), d_no_delay(no_delay)
 {
     try {
         d_socket.set_option(boost::asio::ip::tcp::no_delay(no_delay));
@@ -41,24 +41,21 @@ tcp_connection::tcp_connection(boost::asio::io_service& io_service,
 
 void tcp_connection::send(pmt::pmt_t vector)
 {
-    size_t len = pmt::blob_length(vector);
-
-    // Asio async_write() requires the buffer to remain valid until the handler is called.
-    auto txbuf = std::make_shared<std::vector<char>>(len);
-
-    size_t temp = 0;
-    memcpy(txbuf->data(), pmt::uniform_vector_elements(vector, temp), len);
+    size_t len = 0;
+    const char* data = (const char*)pmt::uniform_vector_elements(vector, len);
 
     size_t offset = 0;
     while (offset < len) {
         // Limit the size of each write() to the MTU.
         // FIXME: Note that this has the effect of breaking a large PDU into several
         // smaller PDUs, each containing <= MTU bytes. Is this the desired behavior?
-        size_t send_len = std::min((len - offset), d_buf.size());
+        size_t send_len = std::min((len - offset), d_pool.slab_size());
+        // Asio async_write() requires the buffer to remain valid until the handler is
+        // called, so the handler holds on to the vector.
         boost::asio::async_write(
             d_socket,
-            boost::asio::buffer(txbuf->data() + offset, send_len),
-            [txbuf](const boost::system::error_code& error, size_t bytes_transferred) {});
+            boost::asio::buffer(data + offset, send_len),
+            [vector](const boost::system::error_code& error, size_t bytes_transferred) {});
         offset += send_len;
     }
 }
@@ -67,7 +64,14 @@ void tcp_connection::start(gr::basic_block* block)
 {
     d_block = block;
     d_socket.set_option(boost::asio::ip::tcp::no_delay(d_no_delay));
-    d_socket.async_read_some(boost::asio::buffer(d_buf),
+    start_read();
+}
+
+void tcp_connection::start_read()
+{
+    if (!d_buf)
+        d_buf = d_pool.get();
+    d_socket.async_read_some(boost::asio::buffer(d_buf.get(), d_pool.slab_size()),
                              boost::bind(&tcp_connection::handle_read,
                                          this,
                                          boost::asio::placeholders::error,
@@ -79,19 +83,13 @@ void tcp_connection::handle_read(const boost::system::error_code& error,
 {
     if (!error) {
         if (d_block) {
-            pmt::pmt_t vector =
-                pmt::init_u8vector(bytes_transferred, (const uint8_t*)&d_buf[0]);
+            pmt::pmt_t vector = d_pool.make_u8vector(bytes_transferred, d_buf);
             pmt::pmt_t pdu = pmt::cons(pmt::PMT_NIL, vector);
 
             d_block->message_port_pub(pdu::pdu_port_id(), pdu);
         }
 
-        d_socket.async_read_some(
-            boost::asio::buffer(d_buf),
-            boost::bind(&tcp_connection::handle_read,
-                        this,
-                        boost::asio::placeholders::error,
-                        boost::asio::placeholders::bytes_transferred));
+        start_read();
     } else {
         d_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both);
         d_socket.close();
@@ -12,6 +12,7 @@
 #define INCLUDED_TCP_CONNECTION_H
 
 #include <pmt/pmt.h>
+#include <pmt/pmt_pool.h>
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
 #include <memory>
@@ -26,7 +27,8 @@ class tcp_connection
 {
 private:
     boost::asio::ip::tcp::socket d_socket;
-    std::vector<char> d_buf;
+    pmt::slab_pool d_pool;
+    std::shared_ptr<uint8_t> d_buf; // long reads go out in it, see make_u8vector
     basic_block* d_block;
     bool d_no_delay;
 
@@ -34,6 +36,7 @@ private:
                    int MTU = 10000,
                    bool no_delay = false);
 
+    void start_read();
     void handle_read(const boost::system::error_code& error, size_t bytes_transferred);
 
 public:
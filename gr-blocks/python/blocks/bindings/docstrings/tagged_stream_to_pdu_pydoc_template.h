@@ -23,3 +23,9 @@ static const char* __doc_gr_blocks_tagged_stream_to_pdu_tagged_stream_to_pdu =
 
 
 static const char* __doc_gr_blocks_tagged_stream_to_pdu_make = R"doc()doc";
+
+
+static const char* __doc_gr_blocks_tagged_stream_to_pdu_set_zero_copy = R"doc()doc";
+
+
+static const char* __doc_gr_blocks_tagged_stream_to_pdu_zero_copy = R"doc()doc";
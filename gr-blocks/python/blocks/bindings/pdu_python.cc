@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(pdu.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(8c678dd50c4df86cbc74dc58b1b5010d)                     */
+/* BINDTOOL_HEADER_FILE_HASH(7d1a3ffb52b412cb4bdaf0f86e31ad4d)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(tagged_stream_to_pdu.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(b521afb9e6e75ef2df0909cebf85166e)                     */
+/* BINDTOOL_HEADER_FILE_HASH(40b2b952186d60ff8739e37a90373e7e)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -46,6 +46,16 @@ void bind_tagged_stream_to_pdu(py::module& m)
              D(tagged_stream_to_pdu, make))
 
 
+        .def("set_zero_copy",
+             &tagged_stream_to_pdu::set_zero_copy,
+             py::arg("zero_copy"),
+             D(tagged_stream_to_pdu, set_zero_copy))
+
+
+        .def("zero_copy",
+             &tagged_stream_to_pdu::zero_copy,
+             D(tagged_stream_to_pdu, zero_copy))
+
         ;
 
 
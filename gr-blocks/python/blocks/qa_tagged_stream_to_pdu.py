@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+#
+# Copyright 2026 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+#
+
+
+import time
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+
+
+class test_tagged_stream_to_pdu(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_chain(self, src_data, packet_len, tags=()):
+        src = blocks.vector_source_f(src_data, tags=tags)
+        s2ts = blocks.stream_to_tagged_stream(
+            gr.sizeof_float,
+            vlen=1,
+            packet_len=packet_len,
+            len_tag_key="packet_len")
+        ts2pdu = blocks.tagged_stream_to_pdu(blocks.float_t, "packet_len")
+        ts2pdu.set_zero_copy(True)
+        self.tb.connect(src, s2ts, ts2pdu)
+        return s2ts, ts2pdu
+
+    def test_001_zero_copy(self):
+        packet_len = 16
+        src_data = [float(x) for x in range(4 * packet_len)]
+        tag1 = gr.tag_t()
+        tag1.offset = 0
+        tag1.key = pmt.string_to_symbol('spam')
+        tag1.value = pmt.from_long(23)
+        tag2 = gr.tag_t()
+        tag2.offset = packet_len + 10
+        tag2.key = pmt.string_to_symbol('eggs')
+        tag2.value = pmt.from_long(42)
+        s2ts, ts2pdu = self.make_chain(src_data, packet_len, (tag1, tag2))
+        self.assertTrue(ts2pdu.zero_copy())
+        dbg = blocks.message_debug()
+        self.tb.msg_connect(ts2pdu, "pdus", dbg, "store")
+        self.tb.run()
+
+        self.assertEqual(4, dbg.num_messages())
+        expected_meta = [{'spam': 23}, {'eggs': 42}, {}, {}]
+        for i in range(4):
+            msg = dbg.get_message(i)
+            self.assertEqual(expected_meta[i], pmt.to_python(pmt.car(msg)))
+            self.assertFloatTuplesAlmostEqual(
+                pmt.f32vector_elements(pmt.cdr(msg)),
+                src_data[i * packet_len:(i + 1) * packet_len])
+
+    def test_002_zero_copy_release(self):
+        # Many times what fits in the buffer; unless dropping a PDU
+        # gives its items back, the source runs out of room and this
+        # never finishes.
+        packet_len = 256
+        npackets = 400
+        src_data = [float(x % 1000) for x in range(packet_len * npackets)]
+        s2ts, ts2pdu = self.make_chain(src_data, packet_len)
+        s2ts.set_max_output_buffer(4 * packet_len)
+        drop = blocks.pdu_filter(pmt.intern('nope'), pmt.PMT_T)
+        self.tb.msg_connect(ts2pdu, "pdus", drop, "pdus")
+
+        self.tb.start()
+        for _ in range(500):
+            if ts2pdu.nitems_read(0) == len(src_data):
+                break
+            time.sleep(0.01)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(len(src_data), ts2pdu.nitems_read(0))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_tagged_stream_to_pdu)
@@ -51,12 +51,8 @@ async_decoder_impl::async_decoder_impl(generic_decoder::sptr my_decoder,
     message_port_register_in(d_in_port);
     message_port_register_out(d_out_port);
 
-    if (d_packed) {
-        set_msg_handler(d_in_port, [this](pmt::pmt_t msg) { this->decode_packed(msg); });
-    } else {
-        set_msg_handler(d_in_port,
-                        [this](pmt::pmt_t msg) { this->decode_unpacked(msg); });
-    }
+    set_msg_batch_handler(d_in_port,
+                          [this](std::vector<pmt::pmt_t>& msgs) { this->decode(msgs); });
 
     // The maximum frame size is set by the initial frame size of the decoder.
     d_max_bits_in = d_mtu * 8 * 1.0 / d_decoder->rate();
@@ -74,7 +70,15 @@ async_decoder_impl::async_decoder_impl(generic_decoder::sptr my_decoder,
 
 async_decoder_impl::~async_decoder_impl() {}
 
-void async_decoder_impl::decode_unpacked(pmt::pmt_t msg)
+void async_decoder_impl::decode(std::vector<pmt::pmt_t>& msgs)
+{
+    // Decode the burst in place, then hand it on at once.
+    for (pmt::pmt_t& msg : msgs)
+        msg = d_packed ? decode_packed(msg) : decode_unpacked(msg);
+    message_port_pub(d_out_port, msgs);
+}
+
+pmt::pmt_t async_decoder_impl::decode_unpacked(pmt::pmt_t msg)
 {
     // extract input pdu
     pmt::pmt_t meta(pmt::car(msg));
@@ -141,10 +145,10 @@ void async_decoder_impl::decode_unpacked(pmt::pmt_t msg)
 
     static const pmt::pmt_t iterations_key = pmt::mp("iterations");
     meta = pmt::dict_add(meta, iterations_key, pmt::mp(d_decoder->get_iterations()));
-    message_port_pub(d_out_port, pmt::cons(meta, outvec));
+    return pmt::cons(meta, outvec);
 }
 
-void async_decoder_impl::decode_packed(pmt::pmt_t msg)
+pmt::pmt_t async_decoder_impl::decode_packed(pmt::pmt_t msg)
 {
     // extract input pdu
     pmt::pmt_t meta(pmt::car(msg));
@@ -194,7 +198,7 @@ void async_decoder_impl::decode_packed(pmt::pmt_t msg)
     else
         d_pack.pack(bytes_out, d_bits_out.data(), nbytes_out);
 
-    message_port_pub(d_out_port, pmt::cons(meta, outvec));
+    return pmt::cons(meta, outvec);
 }
 
 int async_decoder_impl::general_work(int noutput_items,
@@ -37,8 +37,9 @@ private:
     volk::vector<int8_t> d_tmp_u8;
     volk::vector<uint8_t> d_bits_out;
 
-    void decode_packed(pmt::pmt_t msg);
-    void decode_unpacked(pmt::pmt_t msg);
+    void decode(std::vector<pmt::pmt_t>& msgs);
+    pmt::pmt_t decode_packed(pmt::pmt_t msg);
+    pmt::pmt_t decode_unpacked(pmt::pmt_t msg);
 
 public:
     async_decoder_impl(generic_decoder::sptr my_decoder,
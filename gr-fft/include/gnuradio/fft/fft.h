@@ -70,6 +70,7 @@ template <class T, bool forward>
 class FFT_API fft
 {
     int d_nthreads;
+    int d_batch;
     volk::vector<typename fft_inbuf<T, forward>::type> d_inbuf;
     volk::vector<typename fft_outbuf<T, forward>::type> d_outbuf;
     void* d_plan;
@@ -79,6 +80,14 @@ class FFT_API fft
 
 public:
     fft(int fft_size, int nthreads = 1);
+    /*!
+     * \param fft_size length of each transform
+     * \param nthreads number of threads FFTW may use
+     * \param batch number of transforms each execute() does; their
+     *        inputs and outputs sit back to back in the buffers, fft_size
+     *        items apart.
+     */
+    fft(int fft_size, int nthreads, int batch);
     // Copy disabled due to d_plan.
     fft(const fft&) = delete;
     fft& operator=(const fft&) = delete;
@@ -105,9 +114,12 @@ public:
      */
     int nthreads() const { return d_nthreads; }
 
+    //! Number of transforms done by each execute()
+    int batch() const { return d_batch; }
+
     /*!
      * compute FFT. The input comes from inbuf, the output is placed in
-     * outbuf.
+     * outbuf. With a batch, computes all of them.
      */
     void execute();
 };
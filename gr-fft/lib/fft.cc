@@ -32,6 +32,7 @@ static int my_fftw_read_char(void* f) { return fgetc((FILE*)f); }
 #define O_NONBLOCK 0
 #endif //_WIN32
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -143,8 +144,16 @@ static void export_wisdom()
 
 
 template <class T, bool forward>
-fft<T, forward>::fft(int fft_size, int nthreads)
-    : d_nthreads(nthreads), d_inbuf(fft_size), d_outbuf(fft_size)
+fft<T, forward>::fft(int fft_size, int nthreads) : fft(fft_size, nthreads, 1)
+{
+}
+
+template <class T, bool forward>
+fft<T, forward>::fft(int fft_size, int nthreads, int batch)
+    : d_nthreads(nthreads),
+      d_batch(batch),
+      d_inbuf(fft_size * std::max(batch, 1)),
+      d_outbuf(fft_size * std::max(batch, 1))
 {
     gr::configure_default_loggers(d_logger, d_debug_logger, "fft_complex");
     // Hold global mutex during plan construction and destruction.
@@ -156,6 +165,9 @@ fft<T, forward>::fft(int fft_size, int nthreads)
     if (fft_size <= 0) {
         throw std::out_of_range("fft_impl_fftw: invalid fft_size");
     }
+    if (batch <= 0) {
+        throw std::out_of_range("fft_impl_fftw: invalid batch");
+    }
 
     config_threading(nthreads);
     lock_wisdom();
@@ -170,43 +182,107 @@ fft<T, forward>::fft(int fft_size, int nthreads)
     unlock_wisdom();
 }
 
+// Batches of transforms are planned as one, fft_size items apart in both
+// buffers.
 template <>
 void fft<gr_complex, true>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_1d(fft_size,
-                               reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
-                               reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
-                               FFTW_FORWARD,
-                               FFTW_MEASURE);
+    if (d_batch == 1) {
+        d_plan = fftwf_plan_dft_1d(fft_size,
+                                   reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                   reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                   FFTW_FORWARD,
+                                   FFTW_MEASURE);
+        return;
+    }
+    d_plan = fftwf_plan_many_dft(1,
+                                 &fft_size,
+                                 d_batch,
+                                 reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                 NULL,
+                                 1,
+                                 fft_size,
+                                 reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                 NULL,
+                                 1,
+                                 fft_size,
+                                 FFTW_FORWARD,
+                                 FFTW_MEASURE);
 }
 
 template <>
 void fft<gr_complex, false>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_1d(fft_size,
-                               reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
-                               reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
-                               FFTW_BACKWARD,
-                               FFTW_MEASURE);
+    if (d_batch == 1) {
+        d_plan = fftwf_plan_dft_1d(fft_size,
+                                   reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                   reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                   FFTW_BACKWARD,
+                                   FFTW_MEASURE);
+        return;
+    }
+    d_plan = fftwf_plan_many_dft(1,
+                                 &fft_size,
+                                 d_batch,
+                                 reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                 NULL,
+                                 1,
+                                 fft_size,
+                                 reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                 NULL,
+                                 1,
+                                 fft_size,
+                                 FFTW_BACKWARD,
+                                 FFTW_MEASURE);
 }
 
 
 template <>
 void fft<float, true>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_r2c_1d(fft_size,
-                                   d_inbuf.data(),
-                                   reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
-                                   FFTW_MEASURE);
+    if (d_batch == 1) {
+        d_plan = fftwf_plan_dft_r2c_1d(fft_size,
+                                       d_inbuf.data(),
+                                       reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                       FFTW_MEASURE);
+        return;
+    }
+    d_plan = fftwf_plan_many_dft_r2c(1,
+                                     &fft_size,
+                                     d_batch,
+                                     d_inbuf.data(),
+                                     NULL,
+                                     1,
+                                     fft_size,
+                                     reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                     NULL,
+                                     1,
+                                     fft_size,
+                                     FFTW_MEASURE);
 }
 
 template <>
 void fft<float, false>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_c2r_1d(fft_size,
-                                   reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
-                                   d_outbuf.data(),
-                                   FFTW_MEASURE);
+    if (d_batch == 1) {
+        d_plan = fftwf_plan_dft_c2r_1d(fft_size,
+                                       reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                       d_outbuf.data(),
+                                       FFTW_MEASURE);
+        return;
+    }
+    d_plan = fftwf_plan_many_dft_c2r(1,
+                                     &fft_size,
+                                     d_batch,
+                                     reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                     NULL,
+                                     1,
+                                     fft_size,
+                                     d_outbuf.data(),
+                                     NULL,
+                                     1,
+                                     fft_size,
+                                     FFTW_MEASURE);
 }
 
 
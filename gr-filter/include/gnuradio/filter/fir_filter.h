@@ -21,6 +21,17 @@ namespace gr {
 namespace filter {
 namespace kernel {
 
+/*!
+ * \brief One phase of a polyphase filter, as fir_filter::filterNdec()
+ * uses internally: taps[k] applies to in[o + k] for output o.
+ */
+template <class IN_T, class TAP_T>
+struct fir_filter_phase {
+    const IN_T* in;
+    const TAP_T* taps;
+    unsigned ntaps;
+};
+
 template <class IN_T, class OUT_T, class TAP_T>
 class FILTER_API fir_filter
 {
@@ -42,7 +53,24 @@ public:
     unsigned int ntaps() const;
 
     OUT_T filter(const IN_T input[]) const;
+
+    /*!
+     * \brief Compute \p n consecutive outputs, starting at \p input.
+     *
+     * Outputs are computed several at a time in one pass over the
+     * taps, so each tap and input item is loaded once per block of
+     * outputs rather than once per output. The few left over go
+     * through filter().
+     */
     void filterN(OUT_T output[], const IN_T input[], unsigned long n);
+
+    /*!
+     * \brief Compute \p n outputs, \p decimate inputs apart.
+     *
+     * The taps and input are split into \p decimate phases, each of
+     * which is filtered like filterN() without decimating, and the
+     * phases summed.
+     */
     void filterNdec(OUT_T output[],
                     const IN_T input[],
                     unsigned long n,
@@ -55,6 +83,13 @@ protected:
     volk::vector<OUT_T> d_output;
     int d_align;
     int d_naligned;
+
+    // filterNdec(): d_taps split into d_poly_decim phases, and room for
+    // the input split the same way and for pointers into it.
+    std::vector<std::vector<TAP_T>> d_poly_taps;
+    std::vector<IN_T> d_poly_in;
+    std::vector<fir_filter_phase<IN_T, TAP_T>> d_poly_phases;
+    unsigned int d_poly_decim;
 };
 typedef fir_filter<float, float, float> fir_filter_fff;
 typedef fir_filter<gr_complex, gr_complex, float> fir_filter_ccf;
@@ -18,6 +18,15 @@
 namespace gr {
 namespace filter {
 
+/*
+ * how a fir_filter_blk computes its outputs
+ */
+typedef enum {
+    FIR_ENGINE_DIRECT = 0, // convolve in the time domain, kernel::fir_filter
+    FIR_ENGINE_FFT = 1,    // overlap-save FFT convolution, kernel::fft_filter
+    FIR_ENGINE_AUTO = 2    // whichever of the two is faster for the taps
+} fir_filter_engine_t;
+
 /*!
  * \brief FIR filter with IN_T input, OUT_T output, and TAP_T taps
  * \ingroup filter_blk
@@ -58,6 +67,38 @@ public:
 
     virtual void set_taps(const std::vector<TAP_T>& taps) = 0;
     virtual std::vector<TAP_T> taps() const = 0;
+
+    /*!
+     * \brief Choose how to compute the filter.
+     *
+     * \details
+     * FIR_ENGINE_DIRECT (the default) convolves in the time domain;
+     * FIR_ENGINE_FFT convolves with FFTs as the fft_filter blocks do,
+     * which wins for long filters.
+     *
+     * FIR_ENGINE_AUTO times both engines on the block's taps and
+     * decimation, here and whenever set_taps() changes the number of
+     * taps, and uses the faster one. Like FFTW wisdom, the decisions
+     * are kept per item type, tap count and decimation in
+     * ~/.gr_fir_engine_wisdom, so each shape of filter is only timed
+     * once on a machine. The [filter] fir_engine_wisdom preference
+     * names another file to keep them in.
+     *
+     * The FFT engine works a block of outputs at a time, so like the
+     * fft_filter blocks it leaves the last partial block of a finite
+     * stream unfiltered. Buffers are sized for that block when the
+     * flowgraph starts, so choose the engine before then; one chosen
+     * later that needs bigger buffers than there are convolves
+     * directly. Only the ccc, ccf and fff filters have an FFT engine;
+     * the others always convolve directly.
+     */
+    virtual void set_engine(fir_filter_engine_t engine) = 0;
+
+    //! The engine asked for with set_engine()
+    virtual fir_filter_engine_t engine() const = 0;
+
+    //! The engine in use: FIR_ENGINE_DIRECT or FIR_ENGINE_FFT
+    virtual fir_filter_engine_t active_engine() const = 0;
 };
 
 typedef fir_filter_blk<gr_complex, gr_complex, gr_complex> fir_filter_ccc;
@@ -13,13 +13,147 @@
 
 #include <gnuradio/filter/api.h>
 #include <gnuradio/gr_complex.h>
+#include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace gr {
 namespace filter {
 namespace kernel {
 
+/*!
+ * \brief The feedback half of an IIR filter,
+ * y[n] = v[n] + sum_{k=1}^{M} a_k y[n-k], run a block of samples at a time.
+ *
+ * \details
+ * Run sample by sample, every output waits on the one before it. Over
+ * a block of L samples, though, the outputs depend only on the block's
+ * own inputs and the M outputs before it:
+ *
+ *   y[j] = sum_{i=0}^{j} g_{j-i} v[i] + sum_{m=1}^{M} c_{m,j} y[-m]
+ *
+ * where g is the recursion's impulse response and c_m its response to
+ * y[-m] = 1 with no input. Each input and each carried output is then
+ * one multiply-add across the whole block, which the compiler can
+ * vectorize; only the M outputs carried from block to block are serial.
+ *
+ * The extra sums lose more bits than the recursion does as the order
+ * grows, and more than single precision accumulators can spare near the
+ * unit circle. So only recursions of up to MAX_ORDER, such as a
+ * second-order section's, with double precision accumulators run in
+ * blocks; the rest run sample by sample.
+ */
+template <class tap_type, class acc_type>
+class iir_lookahead
+{
+public:
+    static constexpr unsigned BLOCK = 4;
+    static constexpr unsigned MAX_ORDER = 2;
+    static constexpr bool USE_BLOCKS = !std::is_same<acc_type, float>::value &&
+                                       !std::is_same<acc_type, gr_complex>::value;
+
+    iir_lookahead() : d_order(0) {}
+
+    /*!
+     * \brief Precompute the block's responses for feedback taps \p a,
+     * signed as in the sum above; \p a[0] is ignored.
+     */
+    void set_taps(const std::vector<tap_type>& a)
+    {
+        d_order = a.empty() ? 0 : a.size() - 1;
+        d_a = a;
+        if (d_order > MAX_ORDER)
+            return;
+
+        // g_j, the response to v[0] = 1, laid out so that row i holds
+        // what v[i] adds to each output of the block.
+        tap_type g[BLOCK];
+        for (unsigned j = 0; j < BLOCK; j++) {
+            g[j] = j == 0 ? tap_type(1) : tap_type(0);
+            for (unsigned k = 1; k <= std::min(j, d_order); k++)
+                g[j] += d_a[k] * g[j - k];
+        }
+        for (unsigned i = 0; i < BLOCK; i++) {
+            for (unsigned j = 0; j < BLOCK; j++)
+                d_g[i][j] = tap_type(0);
+            for (unsigned j = i; j < BLOCK; j++)
+                d_g[i][j] = g[j - i];
+        }
+
+        // c_{m,j}, the response to y[-m] = 1
+        for (unsigned m = 1; m <= d_order; m++) {
+            tap_type* c = d_c[m - 1];
+            for (unsigned j = 0; j < BLOCK; j++) {
+                c[j] = j + m <= d_order ? d_a[j + m] : tap_type(0);
+                for (unsigned k = 1; k <= std::min(j, d_order); k++)
+                    c[j] += d_a[k] * c[j - k];
+            }
+        }
+    }
+
+    unsigned order() const { return d_order; }
+
+    /*!
+     * \brief Run the recursion over \p n samples of \p v into \p y.
+     *
+     * y[-order()] to y[-1] must hold the outputs before the first. \p y
+     * may be \p v.
+     */
+    void run(acc_type y[], const acc_type v[], long n) const
+    {
+        long i = 0;
+        if (USE_BLOCKS && d_order == 1)
+            i = run_blocks<1>(y, v, n);
+        else if (USE_BLOCKS && d_order == 2)
+            i = run_blocks<2>(y, v, n);
+
+        // Oldest outputs first, so that only the last multiply-add waits
+        // on the output just before.
+        for (; i < n; i++) {
+            acc_type acc = v[i];
+            for (unsigned k = d_order; k > 0; k--)
+                acc += d_a[k] * y[i - k];
+            y[i] = acc;
+        }
+    }
+
+private:
+    // The whole blocks of run() for a recursion of order M; returns the
+    // number of samples done. The taps are copied in so the compiler
+    // knows the stores to y don't change them.
+    template <unsigned M>
+    long run_blocks(acc_type y[], const acc_type v[], long n) const
+    {
+        tap_type g[BLOCK][BLOCK], c[M][BLOCK];
+        std::copy(&d_g[0][0], &d_g[0][0] + BLOCK * BLOCK, &g[0][0]);
+        std::copy(&d_c[0][0], &d_c[0][0] + M * BLOCK, &c[0][0]);
+
+        long i = 0;
+        for (; i + BLOCK <= n; i += BLOCK) {
+            acc_type u[BLOCK] = {};
+            for (unsigned k = 0; k < BLOCK; k++) {
+                const acc_type x = v[i + k];
+                for (unsigned j = 0; j < BLOCK; j++)
+                    u[j] += g[k][j] * x;
+            }
+            for (unsigned m = 1; m <= M; m++) {
+                const acc_type p = y[i - m];
+                for (unsigned j = 0; j < BLOCK; j++)
+                    u[j] += c[m - 1][j] * p;
+            }
+            for (unsigned j = 0; j < BLOCK; j++)
+                y[i + j] = u[j];
+        }
+        return i;
+    }
+
+    unsigned d_order;
+    std::vector<tap_type> d_a;
+    tap_type d_g[BLOCK][BLOCK];     // g_{j-i} at [i][j]
+    tap_type d_c[MAX_ORDER][BLOCK]; // c_{m,j} at [m - 1][j]
+};
+
 /*!
  * \brief Base class template for Infinite Impulse Response filter (IIR)
  *
@@ -113,6 +247,23 @@ public:
         set_taps(fftaps, fbtaps);
     }
 
+    /*!
+     * \brief Construct an IIR as a cascade of second-order sections.
+     *
+     * \p sos holds one row of six taps per section, b0, b1, b2, a0, a1,
+     * a2, as scipy.signal's "sos" output and Matlab's tf2sos() give
+     * them; that is, with the feedback taps in the new style. Each
+     * section is normalized by its a0.
+     *
+     * High order filters are far less sensitive to rounding of their
+     * taps as sections than as one long difference equation.
+     */
+    explicit iir_filter(const std::vector<std::vector<tap_type>>& sos) noexcept(false)
+        : d_oldstyle(false)
+    {
+        set_sos(sos);
+    }
+
     iir_filter() : d_latest_n(0), d_latest_m(0) {}
 
     /*!
@@ -124,15 +275,24 @@ public:
     /*!
      * \brief compute an array of N output values.
      * \p input must have N valid entries.
+     *
+     * The feedback is run through iir_lookahead, which sums it in a
+     * different order and runs low order filters and second-order
+     * sections a block at a time, so outputs can differ from filter()'s
+     * in the last bits.
      */
     void filter_n(o_type output[], const i_type input[], long n);
 
     /*!
-     * \return number of taps in filter.
+     * \return number of taps in filter; both are 0 for a filter built
+     * from sections.
      */
     unsigned ntaps_ff() const { return d_fftaps.size(); }
     unsigned ntaps_fb() const { return d_fbtaps.size(); }
 
+    //! \return number of second-order sections, or 0 for a direct form filter.
+    unsigned nsections() const { return d_sos_fb.size(); }
+
     /*!
      * \brief install new taps.
      */
@@ -161,6 +321,47 @@ public:
         d_prev_output.clear();
         d_prev_input.resize(2 * n, 0);
         d_prev_output.resize(2 * m, 0);
+
+        d_fb.set_taps(d_fbtaps);
+        d_sos.clear();
+        d_sos_fb.clear();
+        d_sos_state.clear();
+    }
+
+    /*!
+     * \brief install new second-order sections, as for the constructor.
+     */
+    void set_sos(const std::vector<std::vector<tap_type>>& sos)
+    {
+        if (sos.empty())
+            throw std::invalid_argument("iir_filter: need at least one section");
+
+        d_sos.clear();
+        d_sos_fb.assign(sos.size(), iir_lookahead<tap_type, acc_type>());
+        for (size_t i = 0; i < sos.size(); i++) {
+            const std::vector<tap_type>& s = sos[i];
+            if (s.size() != 6)
+                throw std::invalid_argument("iir_filter: sections need six taps");
+            if (s[3] == tap_type(0))
+                throw std::invalid_argument("iir_filter: section has a0 of 0");
+
+            // Normalized, with the feedback taps negated as d_fbtaps'
+            // are.
+            const tap_type a0 = s[3];
+            const std::vector<tap_type> sec = { s[0] / a0, s[1] / a0, s[2] / a0,
+                                                -s[4] / a0, -s[5] / a0 };
+            d_sos.insert(d_sos.end(), sec.begin(), sec.end());
+            d_sos_fb[i].set_taps({ tap_type(1), sec[3], sec[4] });
+        }
+        d_sos_state.assign(2 * (sos.size() + 1), acc_type(0));
+
+        d_fftaps.clear();
+        d_fbtaps.clear();
+        d_prev_input.clear();
+        d_prev_output.clear();
+        d_latest_n = 0;
+        d_latest_m = 0;
+        d_fb.set_taps(d_fbtaps);
     }
 
 protected:
@@ -171,6 +372,22 @@ protected:
     int d_latest_m;
     std::vector<acc_type> d_prev_output;
     std::vector<i_type> d_prev_input;
+    iir_lookahead<tap_type, acc_type> d_fb; // d_fbtaps
+
+    // Second-order sections: b0, b1, b2, a1, a2 of each in d_sos; the
+    // last two values of the input and of each section's output, which
+    // is the next one's input, in d_sos_state.
+    std::vector<tap_type> d_sos;
+    std::vector<iir_lookahead<tap_type, acc_type>> d_sos_fb;
+    std::vector<acc_type> d_sos_state;
+
+    // filter_n() works through its input in chunks of this many.
+    static constexpr long CHUNK = 1024;
+    std::vector<acc_type> d_in_buf;
+    std::vector<acc_type> d_out_buf;
+
+    o_type filter_sos(const i_type input);
+    void filter_n_sos(o_type output[], const i_type input[], long n);
 };
 
 //
@@ -184,6 +401,8 @@ o_type iir_filter<i_type, o_type, tap_type, acc_type>::filter(const i_type input
     unsigned n = ntaps_ff();
     unsigned m = ntaps_fb();
 
+    if (!d_sos_fb.empty())
+        return filter_sos(input);
     if (n == 0)
         return (o_type)0;
 
@@ -219,8 +438,128 @@ void iir_filter<i_type, o_type, tap_type, acc_type>::filter_n(o_type output[],
                                                               const i_type input[],
                                                               long n)
 {
-    for (int i = 0; i < n; i++)
-        output[i] = filter(input[i]);
+    if (!d_sos_fb.empty()) {
+        filter_n_sos(output, input, n);
+        return;
+    }
+
+    const long nff = ntaps_ff();
+    const long nfb = d_fb.order();
+    if (nff == 0) {
+        std::fill(output, output + n, o_type(0));
+        return;
+    }
+
+    // Lay the inputs and outputs out in a line, after the nff - 1 and
+    // nfb before them, so that each half of the filter is a plain loop
+    // over a chunk: the feed-forward half independently for every
+    // sample, then the feedback half.
+    d_in_buf.resize(nff - 1 + CHUNK);
+    d_out_buf.resize(nfb + CHUNK);
+    acc_type* x = &d_in_buf[nff - 1];
+    acc_type* y = &d_out_buf[nfb];
+    for (long k = 1; k < nff; k++)
+        x[-k] = static_cast<acc_type>(d_prev_input[d_latest_n + k]);
+    for (long k = 1; k <= nfb; k++)
+        y[-k] = d_prev_output[d_latest_m + k];
+
+    for (long i = 0; i < n; i += CHUNK) {
+        const long len = std::min(CHUNK, n - i);
+        for (long j = 0; j < len; j++)
+            x[j] = static_cast<acc_type>(input[i + j]);
+
+        for (long j = 0; j < len; j++)
+            y[j] = d_fftaps[0] * x[j];
+        for (long k = 1; k < nff; k++) {
+            for (long j = 0; j < len; j++)
+                y[j] += d_fftaps[k] * x[j - k];
+        }
+        d_fb.run(y, y, len);
+
+        for (long j = 0; j < len; j++)
+            output[i + j] = static_cast<o_type>(y[j]);
+
+        // Carry the history on to the next chunk.
+        std::copy(x + len - (nff - 1), x + len, x - (nff - 1));
+        std::copy(y + len - nfb, y + len, y - nfb);
+    }
+
+    // Leave it where filter() expects it, next to be written at 0.
+    d_latest_n = 0;
+    d_latest_m = 0;
+    for (long k = 1; k < nff; k++)
+        d_prev_input[k] = d_prev_input[k + nff] = static_cast<i_type>(x[-k]);
+    for (long k = 1; k <= nfb; k++)
+        d_prev_output[k] = d_prev_output[k + nfb + 1] = y[-k];
+}
+
+template <class i_type, class o_type, class tap_type, class acc_type>
+o_type iir_filter<i_type, o_type, tap_type, acc_type>::filter_sos(const i_type input)
+{
+    acc_type x = static_cast<acc_type>(input);
+    acc_type* prev = d_sos_state.data(); // this section's input's
+    for (size_t s = 0; s < d_sos_fb.size(); s++) {
+        const tap_type* t = &d_sos[5 * s];
+        acc_type* out = prev + 2; // and its output's
+
+        acc_type acc = t[0] * x;
+        acc += t[1] * prev[0];
+        acc += t[2] * prev[1];
+        acc += t[3] * out[0];
+        acc += t[4] * out[1];
+
+        prev[1] = prev[0];
+        prev[0] = x;
+        x = acc;
+        prev = out;
+    }
+    prev[1] = prev[0];
+    prev[0] = x;
+    return static_cast<o_type>(x);
+}
+
+template <class i_type, class o_type, class tap_type, class acc_type>
+void iir_filter<i_type, o_type, tap_type, acc_type>::filter_n_sos(o_type output[],
+                                                                  const i_type input[],
+                                                                  long n)
+{
+    // Each chunk goes through the sections one after another, each
+    // taking the last's outputs in a line after their two before.
+    d_in_buf.resize(2 + CHUNK);
+    d_out_buf.resize(2 + CHUNK);
+
+    for (long i = 0; i < n; i += CHUNK) {
+        const long len = std::min(CHUNK, n - i);
+        acc_type* x = &d_in_buf[2];
+        acc_type* y = &d_out_buf[2];
+        acc_type* prev = d_sos_state.data();
+
+        x[-1] = prev[0];
+        x[-2] = prev[1];
+        for (long j = 0; j < len; j++)
+            x[j] = static_cast<acc_type>(input[i + j]);
+
+        for (size_t s = 0; s < d_sos_fb.size(); s++) {
+            const tap_type* t = &d_sos[5 * s];
+            acc_type* out = prev + 2;
+
+            y[-1] = out[0];
+            y[-2] = out[1];
+            for (long j = 0; j < len; j++)
+                y[j] = t[0] * x[j] + t[1] * x[j - 1] + t[2] * x[j - 2];
+            d_sos_fb[s].run(y, y, len);
+
+            prev[0] = x[len - 1];
+            prev[1] = x[len - 2];
+            std::swap(x, y);
+            prev = out;
+        }
+        prev[0] = x[len - 1];
+        prev[1] = x[len - 2];
+
+        for (long j = 0; j < len; j++)
+            output[i + j] = static_cast<o_type>(x[j]);
+    }
 }
 
 template <>
@@ -0,0 +1,92 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_FILTER_INTERLEAVED_FILTERBANK_H
+#define INCLUDED_FILTER_INTERLEAVED_FILTERBANK_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/gr_complex.h>
+#include <volk/volk_alloc.hh>
+#include <climits>
+#include <vector>
+
+namespace gr {
+namespace filter {
+namespace kernel {
+
+/*!
+ * \brief A bank of complex FIR filters with float taps, run several
+ * arms at a time.
+ * \ingroup filter_blk
+ * \ingroup pfb_blk
+ *
+ * \details
+ * Where a filterbank keeps one gr::filter::kernel::fir_filter_ccf per
+ * arm and runs them one after the other, this keeps the arms' taps
+ * interleaved in groups of group_size(): tap k of every arm in a group
+ * sits in one SIMD vector. Each pass over the taps then computes an
+ * output for every arm in the group, streaming through the taps once
+ * for all of them rather than once per arm.
+ *
+ * The arms read their own inputs, which filterN() interleaves the same
+ * way a block of items at a time. The polyphase filterbanks use this
+ * where all of their arms are wanted at once; see
+ * gr::filter::kernel::polyphase_filterbank.
+ */
+class FILTER_API interleaved_filterbank_ccf
+{
+private:
+    unsigned int d_narms;
+    unsigned int d_ntaps;
+    volk::vector<float> d_taps; // [group][reversed tap][arm in group][re, im]
+
+public:
+    /*!
+     * Build the filterbank.
+     *
+     * \param taps one vector of taps per arm. They need not all be the
+     *             same length, but the bank runs as long as the longest.
+     */
+    interleaved_filterbank_ccf(const std::vector<std::vector<float>>& taps);
+
+    void set_taps(const std::vector<std::vector<float>>& taps);
+
+    unsigned int narms() const { return d_narms; }
+    unsigned int ntaps() const { return d_ntaps; }
+
+    //! Arms computed together; splitting work on multiples of it is cheapest.
+    static unsigned int group_size();
+
+    /*!
+     * Run arms \p first to \p last - 1 over \p n outputs each. Output i of
+     * arm a is what fir_filter_ccf::filter() would give with this arm's
+     * taps on in[a] + i * step, and goes to out[i * out_stride + a].
+     *
+     * Only in[first] to in[last - 1] are read. The inputs are
+     * interleaved into \p scratch, which is grown as needed; callers
+     * keep one, so that only their first call allocates. Safe to call
+     * from several threads at once on different arms, each with its own
+     * \p scratch.
+     */
+    void filterN(gr_complex out[],
+                 unsigned long out_stride,
+                 const gr_complex* const in[],
+                 unsigned long n,
+                 volk::vector<gr_complex>& scratch,
+                 unsigned int step = 1,
+                 unsigned int first = 0,
+                 unsigned int last = UINT_MAX) const;
+};
+
+} /* namespace kernel */
+} /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_INTERLEAVED_FILTERBANK_H */
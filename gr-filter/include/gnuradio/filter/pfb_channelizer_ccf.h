@@ -189,6 +189,19 @@ public:
      * Gets the current channel map.
      */
     virtual std::vector<int> channel_map() const = 0;
+
+    /*!
+     * Spread the work over \p n threads. The filterbank's filters are
+     * shared out between them; once they have all been run, so are the
+     * FFTs and the copying to the outputs. With n = 1, the default,
+     * the block's own thread does it all.
+     */
+    virtual void set_nthreads(int n) = 0;
+
+    /*!
+     * Gets the number of threads the work is spread over.
+     */
+    virtual int nthreads() const = 0;
 };
 
 } /* namespace filter */
@@ -16,6 +16,7 @@
 #include <gnuradio/filter/api.h>
 #include <gnuradio/filter/fft_filter.h>
 #include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/interleaved_filterbank.h>
 
 namespace gr {
 namespace filter {
@@ -52,6 +53,12 @@ namespace kernel {
  * the input stream has been deinterleaved. This is most easily
  * done using the gr::blocks::stream_to_streams block.
  *
+ * The same filters are also kept together in a
+ * gr::filter::kernel::interleaved_filterbank_ccf, which runs several of
+ * them in each SIMD pass. Blocks that want every filter's output for
+ * the same items, as the channelizer and decimator do, use that instead
+ * of running the filters one at a time.
+ *
  * The output is then produced as a vector, where index
  * <EM>i</EM> in the vector is the next sample from the
  * <EM>i</EM>th channel. This is most easily handled by sending
@@ -92,6 +99,7 @@ protected:
     unsigned int d_nfilts;
     std::vector<kernel::fir_filter_ccf> d_fir_filters;
     std::vector<kernel::fft_filter_ccf> d_fft_filters;
+    kernel::interleaved_filterbank_ccf d_interleaved; // all of d_fir_filters
     std::vector<std::vector<float>> d_taps;
     unsigned int d_taps_per_filter;
     fft::fft_complex_rev* d_fft;
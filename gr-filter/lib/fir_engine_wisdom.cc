@@ -0,0 +1,123 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fir_engine_wisdom.h"
+#include <gnuradio/logger.h>
+#include <gnuradio/prefs.h>
+#include <gnuradio/sys_paths.h>
+#include <gnuradio/thread/thread.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/format.hpp>
+#include <fstream>
+#include <map>
+#include <tuple>
+
+namespace fs = boost::filesystem;
+
+namespace gr {
+namespace filter {
+
+namespace {
+
+typedef std::tuple<std::string, unsigned int, int> wisdom_key;
+typedef std::map<wisdom_key, bool> wisdom_map;
+
+gr::thread::mutex s_wisdom_mutex;
+wisdom_map s_wisdom; // guarded by s_wisdom_mutex
+bool s_wisdom_loaded = false;
+
+fs::path wisdom_filename()
+{
+    const std::string filename =
+        gr::prefs::singleton()->get_string("filter", "fir_engine_wisdom", "");
+    if (!filename.empty())
+        return fs::path(filename);
+    return fs::path(gr::appdata_path()) / ".gr_fir_engine_wisdom";
+}
+
+// Merge the file's decisions into the map, keeping any already there.
+void read_wisdom(wisdom_map& wisdom)
+{
+    std::ifstream in(wisdom_filename().string());
+    std::string type, engine;
+    unsigned int ntaps;
+    int decimation;
+    while (in >> type >> ntaps >> decimation >> engine)
+        wisdom.emplace(wisdom_key(type, ntaps, decimation), engine == "fft");
+}
+
+// Write to a temporary file and rename it over the old one, so a process
+// reading the file at the same time sees either all of it or none.
+void write_wisdom(const wisdom_map& wisdom)
+{
+    const fs::path filename = wisdom_filename();
+    const fs::path tmp = filename.string() + fs::unique_path(".%%%%-%%%%").string();
+    {
+        std::ofstream out(tmp.string());
+        for (const auto& w : wisdom) {
+            out << std::get<0>(w.first) << " " << std::get<1>(w.first) << " "
+                << std::get<2>(w.first) << " " << (w.second ? "fft" : "direct")
+                << "\n";
+        }
+        if (!out) {
+            gr::logger_ptr logger, debug_logger;
+            gr::configure_default_loggers(logger, debug_logger, "fir_engine_wisdom");
+            GR_LOG_ERROR(logger,
+                         boost::format("can't write wisdom to %s") % tmp.string());
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    fs::rename(tmp, filename, ec);
+    if (ec)
+        fs::remove(tmp, ec);
+}
+
+} // namespace
+
+bool fir_engine_wisdom_lookup(const std::string& type,
+                              unsigned int ntaps,
+                              int decimation,
+                              bool& use_fft)
+{
+    gr::thread::scoped_lock lock(s_wisdom_mutex);
+    if (!s_wisdom_loaded) {
+        read_wisdom(s_wisdom);
+        s_wisdom_loaded = true;
+    }
+
+    auto w = s_wisdom.find(wisdom_key(type, ntaps, decimation));
+    if (w == s_wisdom.end())
+        return false;
+    use_fft = w->second;
+    return true;
+}
+
+void fir_engine_wisdom_store(const std::string& type,
+                             unsigned int ntaps,
+                             int decimation,
+                             bool use_fft)
+{
+    gr::thread::scoped_lock lock(s_wisdom_mutex);
+    s_wisdom[wisdom_key(type, ntaps, decimation)] = use_fft;
+
+    // Pick up whatever other processes have learnt since we last looked.
+    read_wisdom(s_wisdom);
+    write_wisdom(s_wisdom);
+}
+
+} /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,43 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_FILTER_FIR_ENGINE_WISDOM_H
+#define INCLUDED_FILTER_FIR_ENGINE_WISDOM_H
+
+#include <string>
+
+namespace gr {
+namespace filter {
+
+/*!
+ * Whether the FFT engine beat direct convolution for a filter of a given
+ * item type ("ccf", ...), tap count and decimation on this machine, as
+ * found by fir_filter_blk's FIR_ENGINE_AUTO. Kept in ~/.gr_fir_engine_wisdom
+ * alongside FFTW's own wisdom, or in the file named by the [filter]
+ * fir_engine_wisdom preference, one "type ntaps decimation engine" line
+ * per filter.
+ *
+ * Returns false if the filter has not been timed yet.
+ */
+bool fir_engine_wisdom_lookup(const std::string& type,
+                              unsigned int ntaps,
+                              int decimation,
+                              bool& use_fft);
+
+//! Remember the engine chosen for a filter.
+void fir_engine_wisdom_store(const std::string& type,
+                             unsigned int ntaps,
+                             int decimation,
+                             bool use_fft);
+
+} /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FIR_ENGINE_WISDOM_H */
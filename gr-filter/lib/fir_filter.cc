@@ -8,9 +8,11 @@
  *
  */
 
+#include "fvec.h"
 #include <gnuradio/fft/fft.h>
 #include <gnuradio/filter/fir_filter.h>
 #include <volk/volk.h>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 
@@ -18,8 +20,142 @@ namespace gr {
 namespace filter {
 namespace kernel {
 
+namespace {
+
+// filterN() and filterNdec() compute a block of outputs per pass over
+// the taps: each tap is multiplied into a vector of consecutive inputs,
+// one lane per output, so nothing is summed across lanes. volk's dot
+// products don't have a multi-output form.
+using simd::fvec;
+using simd::LANES;
+using simd::load;
+
+const unsigned NACC = 4; // vectors of outputs per pass
+
+// volk picks AVX at run time; if we can't, its dot products are faster
+// for long filters.
+const unsigned MAX_BLOCK_TAPS = LANES >= 8 ? UINT_MAX : 128;
+
+// filterN() has just the one phase.
+template <class IN_T, class TAP_T>
+using phase = fir_filter_phase<IN_T, TAP_T>;
+
+// acc[i][l] += sum_k taps[k] * x[k * STRIDE + i * LANES + l]
+template <unsigned STRIDE>
+inline void mac(fvec acc[NACC], const float* x, const float* taps, unsigned ntaps)
+{
+    for (unsigned k = 0; k < ntaps; k++, x += STRIDE) {
+        const float t = taps[k];
+        for (unsigned i = 0; i < NACC; i++)
+            acc[i] += t * load(x + i * LANES);
+    }
+}
+
+// As mac(), with the real and imaginary parts of complex taps
+// accumulated separately.
+template <unsigned STRIDE>
+inline void
+mac(fvec re[NACC], fvec im[NACC], const float* x, const gr_complex* taps, unsigned ntaps)
+{
+    for (unsigned k = 0; k < ntaps; k++, x += STRIDE) {
+        const float tr = taps[k].real();
+        const float ti = taps[k].imag();
+        for (unsigned i = 0; i < NACC; i++) {
+            const fvec xi = load(x + i * LANES);
+            re[i] += tr * xi;
+            im[i] += ti * xi;
+        }
+    }
+}
+
+// block<IN_T, OUT_T, TAP_T>::filter() sums the phases into N outputs;
+// N is 0 for types that always go through fir_filter::filter().
+template <class IN_T, class OUT_T, class TAP_T>
+struct block {
+    static const unsigned N = 0;
+    static void filter(OUT_T[], const phase<IN_T, TAP_T>[], unsigned) {}
+};
+
+template <>
+struct block<float, float, float> {
+    static const unsigned N = NACC * LANES;
+    static void filter(float out[], const phase<float, float> p[], unsigned np)
+    {
+        fvec acc[NACC] = {};
+        for (unsigned j = 0; j < np; j++)
+            mac<1>(acc, p[j].in, p[j].taps, p[j].ntaps);
+        memcpy(out, acc, sizeof(acc));
+    }
+};
+
+template <>
+struct block<float, std::int16_t, float> {
+    static const unsigned N = NACC * LANES;
+    static void filter(std::int16_t out[], const phase<float, float> p[], unsigned np)
+    {
+        float acc[N];
+        block<float, float, float>::filter(acc, p, np);
+        for (unsigned i = 0; i < N; i++)
+            out[i] = (std::int16_t)acc[i]; // as volk_32f_x2_dot_prod_16i does
+    }
+};
+
+template <>
+struct block<gr_complex, gr_complex, float> {
+    static const unsigned N = NACC * LANES / 2;
+    static void filter(gr_complex out[], const phase<gr_complex, float> p[], unsigned np)
+    {
+        fvec acc[NACC] = {};
+        for (unsigned j = 0; j < np; j++)
+            mac<2>(acc, (const float*)p[j].in, p[j].taps, p[j].ntaps);
+        memcpy(out, acc, sizeof(acc));
+    }
+};
+
+template <>
+struct block<float, gr_complex, gr_complex> {
+    static const unsigned N = NACC * LANES;
+    static void filter(gr_complex out[], const phase<float, gr_complex> p[], unsigned np)
+    {
+        fvec re[NACC] = {}, im[NACC] = {};
+        for (unsigned j = 0; j < np; j++)
+            mac<1>(re, im, p[j].in, p[j].taps, p[j].ntaps);
+
+        const float* r = (const float*)re;
+        const float* i = (const float*)im;
+        for (unsigned o = 0; o < N; o++)
+            out[o] = gr_complex(r[o], i[o]);
+    }
+};
+
+template <>
+struct block<gr_complex, gr_complex, gr_complex> {
+    static const unsigned N = NACC * LANES / 2;
+    static void
+    filter(gr_complex out[], const phase<gr_complex, gr_complex> p[], unsigned np)
+    {
+        fvec re[NACC] = {}, im[NACC] = {};
+        for (unsigned j = 0; j < np; j++)
+            mac<2>(re, im, (const float*)p[j].in, p[j].taps, p[j].ntaps);
+
+        // re holds sum(tap.real * x), im sum(tap.imag * x), both still
+        // interleaved as x is.
+        const float* r = (const float*)re;
+        const float* i = (const float*)im;
+        for (unsigned o = 0; o < N; o++) {
+            out[o] = gr_complex(r[2 * o] - i[2 * o + 1], r[2 * o + 1] + i[2 * o]);
+        }
+    }
+};
+
+// Inputs deinterleaved per filterNdec() pass, per phase
+const unsigned long POLY_CHUNK = 16384;
+
+} // namespace
+
 template <class IN_T, class OUT_T, class TAP_T>
-fir_filter<IN_T, OUT_T, TAP_T>::fir_filter(const std::vector<TAP_T>& taps) : d_output(1)
+fir_filter<IN_T, OUT_T, TAP_T>::fir_filter(const std::vector<TAP_T>& taps)
+    : d_output(1), d_poly_decim(0)
 {
     d_align = volk_get_alignment();
     d_naligned = std::max((size_t)1, d_align / sizeof(IN_T));
@@ -40,6 +176,7 @@ void fir_filter<IN_T, OUT_T, TAP_T>::set_taps(const std::vector<TAP_T>& taps)
         for (unsigned int j = 0; j < d_ntaps; j++)
             d_aligned_taps[i][i + j] = d_taps[j];
     }
+    d_poly_decim = 0;
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -49,6 +186,7 @@ void fir_filter<IN_T, OUT_T, TAP_T>::update_tap(TAP_T t, unsigned int index)
     for (int i = 0; i < d_naligned; i++) {
         d_aligned_taps[i][i + index] = t;
     }
+    d_poly_decim = 0;
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -70,7 +208,17 @@ void fir_filter<IN_T, OUT_T, TAP_T>::filterN(OUT_T output[],
                                              const IN_T input[],
                                              unsigned long n)
 {
-    for (unsigned long i = 0; i < n; i++) {
+    typedef block<IN_T, OUT_T, TAP_T> blk;
+
+    unsigned long i = 0;
+    if (blk::N && d_ntaps <= MAX_BLOCK_TAPS) {
+        phase<IN_T, TAP_T> p = { input, d_taps.data(), d_ntaps };
+        for (; i + blk::N <= n; i += blk::N) {
+            p.in = &input[i];
+            blk::filter(&output[i], &p, 1);
+        }
+    }
+    for (; i < n; i++) {
         output[i] = filter(&input[i]);
     }
 }
@@ -81,8 +229,62 @@ void fir_filter<IN_T, OUT_T, TAP_T>::filterNdec(OUT_T output[],
                                                 unsigned long n,
                                                 unsigned int decimate)
 {
-    unsigned long j = 0;
-    for (unsigned long i = 0; i < n; i++) {
+    typedef block<IN_T, OUT_T, TAP_T> blk;
+
+    if (decimate == 1) {
+        filterN(output, input, n);
+        return;
+    }
+
+    // y[o] = sum_k taps[k] x[o D + k]
+    //      = sum_p sum_m taps[m D + p] x[(o + m) D + p]
+    // i.e. the sum over phases p of x[i D + p] filtered by taps[m D + p].
+    unsigned long i = 0;
+    if (blk::N && d_ntaps <= MAX_BLOCK_TAPS && n >= blk::N) {
+        if (d_poly_decim != decimate) {
+            d_poly_taps.assign(std::min(decimate, d_ntaps), std::vector<TAP_T>());
+            for (unsigned int k = 0; k < d_ntaps; k++)
+                d_poly_taps[k % decimate].push_back(d_taps[k]);
+            d_poly_phases.resize(d_poly_taps.size());
+            d_poly_decim = decimate;
+        }
+
+        const unsigned long chunk =
+            std::max(POLY_CHUNK / decimate / blk::N, 1UL) * blk::N;
+        const unsigned int nphases = d_poly_taps.size();
+        phase<IN_T, TAP_T>* phases = d_poly_phases.data();
+
+        while (n - i >= blk::N) {
+            const unsigned long nout = std::min(chunk, (n - i) / blk::N * blk::N);
+            const IN_T* in = &input[i * decimate];
+
+            // Deinterleave just the inputs each phase uses.
+            size_t need = 0;
+            for (const auto& t : d_poly_taps)
+                need += nout + t.size() - 1;
+            if (d_poly_in.size() < need)
+                d_poly_in.resize(need);
+
+            IN_T* x = d_poly_in.data();
+            for (unsigned int p = 0; p < nphases; p++) {
+                unsigned long nin = nout + d_poly_taps[p].size() - 1;
+                for (unsigned long j = 0; j < nin; j++)
+                    x[j] = in[j * decimate + p];
+                phases[p] = { x, d_poly_taps[p].data(), (unsigned)d_poly_taps[p].size() };
+                x += nin;
+            }
+
+            for (unsigned long o = 0; o < nout; o += blk::N) {
+                blk::filter(&output[i + o], phases, nphases);
+                for (unsigned int p = 0; p < nphases; p++)
+                    phases[p].in += blk::N;
+            }
+            i += nout;
+        }
+    }
+
+    unsigned long j = i * decimate;
+    for (; i < n; i++) {
         output[i] = filter(&input[j]);
         j += decimate;
     }
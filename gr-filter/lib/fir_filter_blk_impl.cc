@@ -13,8 +13,16 @@
 #endif
 
 #include "fir_filter_blk_impl.h"
+#include "fir_engine_wisdom.h"
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <gnuradio/high_res_timer.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <volk/volk_alloc.hh>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace gr {
 namespace filter {
@@ -36,6 +44,9 @@ fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::fir_filter_blk_impl(
                      io_signature::make(1, 1, sizeof(OUT_T)),
                      decimation),
       d_fir(taps),
+      d_engine(FIR_ENGINE_DIRECT),
+      d_use_fft(false),
+      d_nsamples(1),
       d_updated(false)
 {
     this->set_history(d_fir.ntaps());
@@ -47,15 +58,151 @@ fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::fir_filter_blk_impl(
 template <class IN_T, class OUT_T, class TAP_T>
 void fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::set_taps(const std::vector<TAP_T>& taps)
 {
+    fir_filter_engine_t engine;
+    {
+        gr::thread::scoped_lock l(this->d_setlock);
+        engine = d_engine;
+    }
+    update(taps, engine);
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+std::vector<TAP_T> fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::taps() const
+{
+    return d_fir.taps();
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::set_engine(fir_filter_engine_t engine)
+{
+    std::vector<TAP_T> taps;
+    {
+        gr::thread::scoped_lock l(this->d_setlock);
+        taps = d_fir.taps();
+    }
+    update(taps, engine);
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::update(const std::vector<TAP_T>& taps,
+                                                     fir_filter_engine_t engine)
+{
+    // Timing the engines can take a while, so it is done on filters of
+    // its own without holding up work().
+    std::unique_ptr<fft_filter_t> fft;
+    int nsamples = 1;
+    bool use_fft = choose_engine(taps, engine, fft, nsamples);
+
     gr::thread::scoped_lock l(this->d_setlock);
+
+    // Buffers are sized for the output multiple when the flowgraph
+    // starts. Once it has, they can't grow to hold a bigger FFT block.
+    if (use_fft && !fits_buffers(nsamples, taps.size())) {
+        GR_LOG_WARN(this->d_logger,
+                    boost::format("buffers too small for a %d-output FFT block; "
+                                  "convolving directly") %
+                        nsamples);
+        use_fft = false;
+    }
+
     d_fir.set_taps(taps);
+    d_engine = engine;
+    if (use_fft)
+        d_fft = std::move(fft);
+    else
+        d_fft.reset();
+    d_use_fft = use_fft;
+    d_nsamples = nsamples;
     d_updated = true;
+
+    // Before the flowgraph starts, so that the buffers are made big
+    // enough; work() takes care of it afterwards.
+    if (!this->detail()) {
+        this->set_history(d_fir.ntaps());
+        this->set_output_multiple(d_use_fft ? d_nsamples : 1);
+    }
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
-std::vector<TAP_T> fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::taps() const
+bool fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::fits_buffers(int nsamples,
+                                                           unsigned int ntaps) const
 {
-    return d_fir.taps();
+    block_detail_sptr detail = this->detail();
+    if (!detail)
+        return true;
+
+    buffer_sptr out = detail->output(0);
+    buffer_reader_sptr in = detail->input(0);
+    if (out && nsamples > out->bufsize() - 1)
+        return false;
+    if (in && nsamples * this->decimation() + int(ntaps) - 1 >
+                  in->max_possible_items_available())
+        return false;
+    return true;
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+bool fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::choose_engine(
+    const std::vector<TAP_T>& taps,
+    fir_filter_engine_t engine,
+    std::unique_ptr<fft_filter_t>& fft,
+    int& nsamples) const
+{
+    if constexpr (HAVE_FFT) {
+        if (engine == FIR_ENGINE_DIRECT)
+            return false;
+
+        fft = std::make_unique<fft_filter_t>(this->decimation(), taps);
+        nsamples = fft->set_taps(taps);
+        if (engine == FIR_ENGINE_FFT)
+            return true;
+
+        if (!fft_is_faster(taps, *fft, nsamples))
+            return false;
+        fft->set_taps(taps); // clear what timing it left behind
+        return true;
+    }
+    return false;
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+bool fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::fft_is_faster(
+    const std::vector<TAP_T>& taps, fft_filter_t& fft_filter, int nsamples) const
+{
+    if constexpr (HAVE_FFT) {
+        const char* type = fft_filter_for<IN_T, OUT_T, TAP_T>::name;
+        const unsigned int ntaps = taps.size();
+        const int decim = this->decimation();
+
+        bool use_fft;
+        if (fir_engine_wisdom_lookup(type, ntaps, decim, use_fft))
+            return use_fft;
+
+        // Time both on a few FFT blocks' worth of outputs, best of three.
+        kernel::fir_filter<IN_T, OUT_T, TAP_T> fir(taps);
+        const int noutputs = nsamples * std::max(2, 8192 / nsamples);
+        volk::vector<IN_T> in(noutputs * decim + ntaps);
+        volk::vector<OUT_T> out(noutputs);
+        for (size_t i = 0; i < in.size(); i++)
+            in[i] = IN_T(int(i % 17) - 8);
+
+        high_res_timer_type direct = std::numeric_limits<high_res_timer_type>::max();
+        high_res_timer_type fft = direct;
+        for (int n = 0; n < 3; n++) {
+            high_res_timer_type t0 = gr::high_res_timer_now();
+            fir.filterNdec(out.data(), in.data(), noutputs, decim);
+            high_res_timer_type t1 = gr::high_res_timer_now();
+            fft_filter.filter(noutputs, in.data() + ntaps - 1, out.data());
+            high_res_timer_type t2 = gr::high_res_timer_now();
+            direct = std::min(direct, t1 - t0);
+            fft = std::min(fft, t2 - t1);
+        }
+
+        use_fft = fft < direct;
+        fir_engine_wisdom_store(type, ntaps, decim, use_fft);
+        return use_fft;
+    }
+    return false;
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -70,10 +217,20 @@ int fir_filter_blk_impl<IN_T, OUT_T, TAP_T>::work(int noutput_items,
 
     if (d_updated) {
         this->set_history(d_fir.ntaps());
+        this->set_output_multiple(d_use_fft ? d_nsamples : 1);
         d_updated = false;
         return 0; // history requirements may have changed.
     }
 
+    if constexpr (HAVE_FFT) {
+        if (d_use_fft) {
+            // The FFT filter keeps its own history; start at the newest
+            // item of ours.
+            d_fft->filter(noutput_items, in + d_fir.ntaps() - 1, out);
+            return noutput_items;
+        }
+    }
+
     if (this->decimation() == 1) {
         d_fir.filterN(out, in, noutput_items);
     } else {
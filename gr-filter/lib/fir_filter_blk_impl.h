@@ -11,25 +11,80 @@
 #ifndef FIR_FILTER_BLK_IMPL_H
 #define FIR_FILTER_BLK_IMPL_H
 
+#include <gnuradio/filter/fft_filter.h>
 #include <gnuradio/filter/fir_filter.h>
 #include <gnuradio/filter/fir_filter_blk.h>
+#include <memory>
+#include <type_traits>
 
 namespace gr {
 namespace filter {
 
+// The FFT filter kernel for each type of fir_filter_blk that has one.
+struct no_fft_filter {
+};
+
+template <class IN_T, class OUT_T, class TAP_T>
+struct fft_filter_for {
+    typedef no_fft_filter type;
+};
+template <>
+struct fft_filter_for<gr_complex, gr_complex, gr_complex> {
+    typedef kernel::fft_filter_ccc type;
+    static constexpr const char* name = "ccc";
+};
+template <>
+struct fft_filter_for<gr_complex, gr_complex, float> {
+    typedef kernel::fft_filter_ccf type;
+    static constexpr const char* name = "ccf";
+};
+template <>
+struct fft_filter_for<float, float, float> {
+    typedef kernel::fft_filter_fff type;
+    static constexpr const char* name = "fff";
+};
+
 template <class IN_T, class OUT_T, class TAP_T>
 class FILTER_API fir_filter_blk_impl : public fir_filter_blk<IN_T, OUT_T, TAP_T>
 {
 private:
+    typedef typename fft_filter_for<IN_T, OUT_T, TAP_T>::type fft_filter_t;
+    static constexpr bool HAVE_FFT = !std::is_same<fft_filter_t, no_fft_filter>::value;
+
     kernel::fir_filter<IN_T, OUT_T, TAP_T> d_fir;
+    std::unique_ptr<fft_filter_t> d_fft; // only while the FFT engine is used
+    fir_filter_engine_t d_engine;
+    bool d_use_fft;
+    int d_nsamples; // FFT filter's outputs per block
     bool d_updated;
 
+    void update(const std::vector<TAP_T>& taps, fir_filter_engine_t engine);
+    bool fits_buffers(int nsamples, unsigned int ntaps) const;
+
+    // Decide between the engines for taps, setting up an FFT filter in
+    // fft if it is to be used. Touches nothing of the block's, so needs
+    // no lock.
+    bool choose_engine(const std::vector<TAP_T>& taps,
+                       fir_filter_engine_t engine,
+                       std::unique_ptr<fft_filter_t>& fft,
+                       int& nsamples) const;
+    bool fft_is_faster(const std::vector<TAP_T>& taps,
+                       fft_filter_t& fft_filter,
+                       int nsamples) const;
+
 public:
     fir_filter_blk_impl(int decimation, const std::vector<TAP_T>& taps);
 
     void set_taps(const std::vector<TAP_T>& taps) override;
     std::vector<TAP_T> taps() const override;
 
+    void set_engine(fir_filter_engine_t engine) override;
+    fir_filter_engine_t engine() const override { return d_engine; }
+    fir_filter_engine_t active_engine() const override
+    {
+        return d_use_fft ? FIR_ENGINE_FFT : FIR_ENGINE_DIRECT;
+    }
+
     int work(int noutput_items,
              gr_vector_const_void_star& input_items,
              gr_vector_void_star& output_items) override;
@@ -163,11 +163,7 @@ int freq_xlating_fir_filter_impl<IN_T, OUT_T, TAP_T>::work(
         return 0; // history requirements may have changed.
     }
 
-    unsigned j = 0;
-    for (int i = 0; i < noutput_items; i++) {
-        out[i] = d_composite_fir.filter(&in[j]);
-        j += d_decim;
-    }
+    d_composite_fir.filterNdec(out, in, noutput_items, d_decim);
 
     // re-use of the same buffer as the input and output is safe for many volk functions
     // and faster than creating local temporary memory in the work function and doing an
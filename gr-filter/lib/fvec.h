@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_FILTER_FVEC_H
+#define INCLUDED_FILTER_FVEC_H
+
+#include <cstring>
+
+namespace gr {
+namespace filter {
+namespace kernel {
+namespace simd {
+
+// A vector of floats as wide as the compiler targets, for the kernels
+// whose loops volk has no form for. The compiler turns the arithmetic
+// on them into SIMD instructions.
+#ifdef __GNUC__
+#ifdef __AVX__
+typedef float fvec __attribute__((vector_size(32)));
+#else
+typedef float fvec __attribute__((vector_size(16)));
+#endif
+#else
+struct fvec {
+    float v[4];
+    fvec& operator+=(const fvec& x)
+    {
+        for (int i = 0; i < 4; i++)
+            v[i] += x.v[i];
+        return *this;
+    }
+};
+inline fvec operator*(float t, const fvec& x)
+{
+    fvec r;
+    for (int i = 0; i < 4; i++)
+        r.v[i] = t * x.v[i];
+    return r;
+}
+inline fvec operator*(const fvec& a, const fvec& b)
+{
+    fvec r;
+    for (int i = 0; i < 4; i++)
+        r.v[i] = a.v[i] * b.v[i];
+    return r;
+}
+#endif
+
+const unsigned LANES = sizeof(fvec) / sizeof(float);
+
+inline fvec load(const float* p)
+{
+    fvec v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+} // namespace simd
+} /* namespace kernel */
+} /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FVEC_H */
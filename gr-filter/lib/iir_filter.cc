@@ -23,6 +23,8 @@ iir_filter<gr_complex, gr_complex, float, gr_complex>::filter(const gr_complex i
     unsigned n = ntaps_ff();
     unsigned m = ntaps_fb();
 
+    if (!d_sos_fb.empty())
+        return filter_sos(input);
     if (n == 0)
         return (gr_complex)0;
 
@@ -62,6 +64,8 @@ iir_filter<gr_complex, gr_complex, double, gr_complexd>::filter(const gr_complex
     unsigned n = ntaps_ff();
     unsigned m = ntaps_fb();
 
+    if (!d_sos_fb.empty())
+        return filter_sos(input);
     if (n == 0)
         return (gr_complex)0;
 
@@ -101,6 +105,8 @@ gr_complex iir_filter<gr_complex, gr_complex, gr_complexd, gr_complexd>::filter(
     unsigned n = ntaps_ff();
     unsigned m = ntaps_fb();
 
+    if (!d_sos_fb.empty())
+        return filter_sos(input);
     if (n == 0)
         return (gr_complex)0;
 
@@ -0,0 +1,165 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fvec.h"
+#include <gnuradio/filter/interleaved_filterbank.h>
+#include <algorithm>
+#include <cstring>
+
+namespace gr {
+namespace filter {
+namespace kernel {
+
+namespace {
+
+using simd::fvec;
+using simd::LANES;
+using simd::load;
+
+// A group is NVEC vectors of arms, each complex arm taking two lanes:
+// 4 arms with SSE, 8 with AVX. NOUT outputs of the group are computed
+// per pass over the taps, so each tap vector loaded is used NOUT times.
+const unsigned NVEC = 2;
+const unsigned GROUP = NVEC * LANES / 2;
+const unsigned NOUT = 4;
+
+// Items of interleaved input per block, so a group's block stays in L1.
+const unsigned long MAX_ROWS = 512;
+
+// For NO outputs o of a group, with x the interleaved inputs of output 0
+// and each output xstep floats on from the last,
+//   out[o * out_stride + l] = sum_k taps[k][l] * x[o * xstep + k][l]
+// for arms l from l0 to l1 - 1.
+template <unsigned NO>
+inline void filter_group(gr_complex out[],
+                         unsigned long out_stride,
+                         const float* x,
+                         unsigned long xstep,
+                         const float* taps,
+                         unsigned ntaps,
+                         unsigned l0,
+                         unsigned l1)
+{
+    fvec acc[NO][NVEC] = {};
+    for (unsigned k = 0; k < ntaps; k++) {
+        fvec t[NVEC];
+        for (unsigned v = 0; v < NVEC; v++)
+            t[v] = load(taps + v * LANES);
+        for (unsigned o = 0; o < NO; o++) {
+            for (unsigned v = 0; v < NVEC; v++)
+                acc[o][v] += t[v] * load(x + o * xstep + v * LANES);
+        }
+        taps += 2 * GROUP;
+        x += 2 * GROUP;
+    }
+
+    for (unsigned o = 0; o < NO; o++) {
+        const gr_complex* a = (const gr_complex*)acc[o];
+        memcpy(&out[o * out_stride + l0], &a[l0], (l1 - l0) * sizeof(gr_complex));
+    }
+}
+
+} // namespace
+
+interleaved_filterbank_ccf::interleaved_filterbank_ccf(
+    const std::vector<std::vector<float>>& taps)
+    : d_narms(0), d_ntaps(0)
+{
+    set_taps(taps);
+}
+
+void interleaved_filterbank_ccf::set_taps(const std::vector<std::vector<float>>& taps)
+{
+    d_narms = taps.size();
+    d_ntaps = 0;
+    for (const auto& t : taps)
+        d_ntaps = std::max(d_ntaps, (unsigned int)t.size());
+
+    // Arms past the last are all zeros. Taps are reversed, as
+    // fir_filter's are, so that tap k applies to input item k.
+    const unsigned int ngroups = (d_narms + GROUP - 1) / GROUP;
+    d_taps.assign((size_t)ngroups * d_ntaps * GROUP * 2, 0);
+    for (unsigned int a = 0; a < d_narms; a++) {
+        const unsigned int g = a / GROUP, l = a % GROUP;
+        const unsigned int pad = d_ntaps - taps[a].size();
+        for (unsigned int j = 0; j < taps[a].size(); j++) {
+            unsigned int k = d_ntaps - 1 - pad - j;
+            float* t = &d_taps[(((size_t)g * d_ntaps + k) * GROUP + l) * 2];
+            t[0] = t[1] = taps[a][j];
+        }
+    }
+}
+
+unsigned int interleaved_filterbank_ccf::group_size() { return GROUP; }
+
+void interleaved_filterbank_ccf::filterN(gr_complex out[],
+                                         unsigned long out_stride,
+                                         const gr_complex* const in[],
+                                         unsigned long n,
+                                         volk::vector<gr_complex>& scratch,
+                                         unsigned int step,
+                                         unsigned int first,
+                                         unsigned int last) const
+{
+    last = std::min(last, d_narms);
+    if (n == 0 || first >= last)
+        return;
+
+    // Outputs per block, and the input items they span
+    unsigned long m = MAX_ROWS > d_ntaps ? (MAX_ROWS - d_ntaps) / step + 1 : 1;
+    m = std::min(std::max(m, (unsigned long)NOUT), n);
+    const size_t nx = ((m - 1) * step + d_ntaps) * GROUP;
+    if (scratch.size() < nx)
+        scratch.resize(nx);
+    gr_complex* x = scratch.data();
+    const unsigned long xstep = 2 * GROUP * step;
+
+    for (unsigned int g = first / GROUP; g * GROUP < last; g++) {
+        const unsigned int a0 = g * GROUP;
+        const unsigned int l0 = std::max(first, a0) - a0;
+        const unsigned int l1 = std::min(last, a0 + GROUP) - a0;
+        const float* taps = &d_taps[(size_t)g * d_ntaps * GROUP * 2];
+        std::fill(x, x + nx, gr_complex(0, 0));
+
+        for (unsigned long i0 = 0; i0 < n; i0 += m) {
+            const unsigned long mm = std::min(m, n - i0);
+            const unsigned long rows = (mm - 1) * step + d_ntaps;
+
+            // Interleave the group's inputs, item by item.
+            for (unsigned int l = l0; l < l1; l++) {
+                const gr_complex* src = in[a0 + l] + i0 * step;
+                for (unsigned long r = 0; r < rows; r++)
+                    x[r * GROUP + l] = src[r];
+            }
+
+            const float* xf = (const float*)x;
+            gr_complex* o = &out[i0 * out_stride + a0];
+            unsigned long i = 0;
+            for (; i + NOUT <= mm; i += NOUT) {
+                filter_group<NOUT>(o, out_stride, xf, xstep, taps, d_ntaps, l0, l1);
+                xf += NOUT * xstep;
+                o += NOUT * out_stride;
+            }
+            for (; i < mm; i++) {
+                filter_group<1>(o, out_stride, xf, xstep, taps, d_ntaps, l0, l1);
+                xf += xstep;
+                o += out_stride;
+            }
+        }
+    }
+}
+
+} /* namespace kernel */
+} /* namespace filter */
+} /* namespace gr */
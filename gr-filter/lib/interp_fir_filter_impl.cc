@@ -126,11 +126,13 @@ int interp_fir_filter_impl<IN_T, OUT_T, TAP_T>::work(
     int nfilters = this->interpolation();
     int ni = noutput_items / this->interpolation();
 
-    for (int i = 0; i < ni; i++) {
-        for (int nf = 0; nf < nfilters; nf++) {
-            out[nf] = d_firs[nf].filter(&in[i]);
-        }
-        out += nfilters;
+    // Run each filter over the whole input, then interleave its outputs.
+    if (d_phase_out.size() < (size_t)ni)
+        d_phase_out.resize(ni);
+    for (int nf = 0; nf < nfilters; nf++) {
+        d_firs[nf].filterN(d_phase_out.data(), in, ni);
+        for (int i = 0; i < ni; i++)
+            out[i * nfilters + nf] = d_phase_out[i];
     }
 
     return noutput_items;
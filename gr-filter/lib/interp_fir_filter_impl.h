@@ -26,6 +26,7 @@ private:
     bool d_updated;
     std::vector<kernel::fir_filter<IN_T, OUT_T, TAP_T>> d_firs;
     std::vector<TAP_T> d_new_taps;
+    std::vector<OUT_T> d_phase_out; // one filter's outputs, before interleaving
 
     void install_taps(const std::vector<TAP_T>& taps);
 
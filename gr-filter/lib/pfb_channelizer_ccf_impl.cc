@@ -14,7 +14,9 @@
 
 #include "pfb_channelizer_ccf_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 
 #ifdef _MSC_VER
 #define round(number) number < 0.0 ? ceil(number - 0.5) : floor(number + 0.5)
@@ -39,7 +41,12 @@ pfb_channelizer_ccf_impl::pfb_channelizer_ccf_impl(unsigned int nfilts,
             io_signature::make(1, nfilts, sizeof(gr_complex))),
       polyphase_filterbank(nfilts, taps),
       d_updated(false),
-      d_oversample_rate(oversample_rate)
+      d_oversample_rate(oversample_rate),
+      d_nthreads(1),
+      d_quit(false),
+      d_nrounds(0),
+      d_input_items(nullptr),
+      d_output_items(nullptr)
 {
     // The over sampling rate must be rationally related to the number of channels
     // in that it must be N/i for i in [1,N], which gives an outputsample rate
@@ -83,14 +90,24 @@ pfb_channelizer_ccf_impl::pfb_channelizer_ccf_impl(unsigned int nfilts,
         d_output_multiple++;
     set_output_multiple(d_output_multiple);
 
+    // Keep each chunk's FFT inputs to about a megabyte, and batch enough
+    // small FFTs together to make them worth the while.
+    d_fft_batch = std::max(1, 4096 / (int)d_nfilts);
+    d_chunk = std::max(d_fft_batch, 131072 / (int)d_nfilts);
+    d_fft_in.resize(d_chunk * d_nfilts);
+
     // Use set_taps to also set the history requirement
     set_taps(taps);
 
     // because we need a stream_to_streams block for the input,
     // only send tags from in[i] -> out[i].
     set_tag_propagation_policy(TPP_ONE_TO_ONE);
+
+    start_workers();
 }
 
+pfb_channelizer_ccf_impl::~pfb_channelizer_ccf_impl() { stop_workers(); }
+
 void pfb_channelizer_ccf_impl::set_taps(const std::vector<float>& taps)
 {
     gr::thread::scoped_lock guard(d_mutex);
@@ -123,6 +140,187 @@ void pfb_channelizer_ccf_impl::set_channel_map(const std::vector<int>& map)
 
 std::vector<int> pfb_channelizer_ccf_impl::channel_map() const { return d_channel_map; }
 
+void pfb_channelizer_ccf_impl::set_nthreads(int n)
+{
+    if (n < 1) {
+        throw std::invalid_argument(
+            "pfb_channelizer_ccf_impl::set_nthreads: need at least one thread.");
+    }
+
+    gr::thread::scoped_lock guard(d_mutex);
+    stop_workers();
+    d_nthreads = n;
+    start_workers();
+}
+
+int pfb_channelizer_ccf_impl::nthreads() const { return d_nthreads; }
+
+bool pfb_channelizer_ccf_impl::stop()
+{
+    // The threads are started again when they are next needed.
+    gr::thread::scoped_lock guard(d_mutex);
+    stop_workers();
+    return block::stop();
+}
+
+void pfb_channelizer_ccf_impl::start_workers()
+{
+    d_workers.resize(d_nthreads);
+    for (auto& w : d_workers) {
+        if (!w.fft) {
+            w.fft = std::make_unique<fft::fft_complex_rev>(d_nfilts);
+            if (d_fft_batch > 1)
+                w.batch_fft =
+                    std::make_unique<fft::fft_complex_rev>(d_nfilts, 1, d_fft_batch);
+            w.filter_in.resize(d_nfilts);
+            if (d_rate_ratio != (int)d_nfilts)
+                w.filter_out.resize((d_chunk / d_output_multiple + 1) * d_nfilts);
+        }
+    }
+
+    if (d_nthreads > 1) {
+        d_quit = false;
+        d_barrier = std::make_shared<gr::thread::barrier>(d_nthreads);
+        for (int i = 1; i < d_nthreads; i++)
+            d_threads.emplace_back([this, i]() { run_worker(i); });
+    }
+}
+
+void pfb_channelizer_ccf_impl::stop_workers()
+{
+    if (!d_threads.empty()) {
+        boost::this_thread::disable_interruption no_interrupt;
+        d_quit = true;
+        d_barrier->wait();
+        for (auto& t : d_threads)
+            t.join();
+        d_threads.clear();
+    }
+    d_barrier.reset();
+}
+
+void pfb_channelizer_ccf_impl::sync()
+{
+    if (d_barrier)
+        d_barrier->wait();
+}
+
+void pfb_channelizer_ccf_impl::run_worker(int w)
+{
+    while (true) {
+        d_barrier->wait(); // for general_work() or stop_workers()
+        if (d_quit)
+            return;
+
+        // general_work() may move on to its next call once we are all
+        // past the last barrier, so don't look at d_nrounds again.
+        const int nrounds = d_nrounds;
+        for (int r0 = 0; r0 < nrounds; r0 += d_chunk) {
+            int r1 = std::min(r0 + d_chunk, nrounds);
+            filter_chunk(w, r0, r1);
+            d_barrier->wait();
+            fft_chunk(w, r0, r1);
+            d_barrier->wait();
+        }
+    }
+}
+
+void pfb_channelizer_ccf_impl::filter_chunk(int w, int r0, int r1)
+{
+    const int nfilts = d_nfilts;
+    // Share out whole groups of d_interleaved if there are enough to go
+    // round.
+    const int group = kernel::interleaved_filterbank_ccf::group_size();
+    const int unit = (nfilts + group - 1) / group >= d_nthreads ? group : 1;
+    const int nunits = (nfilts + unit - 1) / unit;
+    const int f0 = std::min(nfilts, w * nunits / d_nthreads * unit);
+    const int f1 = std::min(nfilts, (w + 1) * nunits / d_nthreads * unit);
+    if (f0 >= f1)
+        return;
+
+    // Rounds d_output_multiple apart start with the same filter, so in
+    // those each filter takes the same input, step items further on.
+    const int period = d_output_multiple;
+    const int step = d_output_multiple * d_rate_ratio / nfilts;
+    worker& wk = d_workers[w];
+
+    for (int r = r0; r < std::min(r0 + period, r1); r++) {
+        // The filters past the round's first take the item before.
+        const int last = d_round_last[r];
+        for (int f = f0; f < f1; f++) {
+            int j = last - f;
+            int n = d_round_n[r];
+            if (j < 0) {
+                j += nfilts;
+                n--;
+            }
+            wk.filter_in[f] = (const gr_complex*)(*d_input_items)[j] + n;
+        }
+        const int nr = (r1 - r - 1) / period + 1;
+
+        if (d_rate_ratio == nfilts) {
+            // Without oversampling filter f goes to FFT input f.
+            d_interleaved.filterN(&d_fft_in[(r - r0) * nfilts],
+                                  nfilts,
+                                  wk.filter_in.data(),
+                                  nr,
+                                  wk.filter_scratch,
+                                  step,
+                                  f0,
+                                  f1);
+            continue;
+        }
+
+        d_interleaved.filterN(wk.filter_out.data(),
+                              nfilts,
+                              wk.filter_in.data(),
+                              nr,
+                              wk.filter_scratch,
+                              step,
+                              f0,
+                              f1);
+        for (int i = 0; i < nr; i++) {
+            gr_complex* fft_in = &d_fft_in[(r - r0 + i * period) * nfilts];
+            const gr_complex* out = &wk.filter_out[i * nfilts];
+            for (int f = f0; f < f1; f++)
+                fft_in[d_idxlut[(last - f + nfilts) % nfilts]] = out[f];
+        }
+    }
+}
+
+void pfb_channelizer_ccf_impl::fft_chunk(int w, int r0, int r1)
+{
+    const int nfilts = d_nfilts;
+    const size_t noutputs = d_output_items->size();
+    const int nrounds = r1 - r0;
+    int r = r0 + w * nrounds / d_nthreads;
+    const int rend = r0 + (w + 1) * nrounds / d_nthreads;
+
+    while (r < rend) {
+        // despin through FFT
+        fft::fft_complex_rev* fft = d_workers[w].fft.get();
+        int batch = 1;
+        if (d_fft_batch > 1 && rend - r >= d_fft_batch) {
+            fft = d_workers[w].batch_fft.get();
+            batch = d_fft_batch;
+        }
+        memcpy(fft->get_inbuf(),
+               &d_fft_in[(r - r0) * nfilts],
+               batch * nfilts * sizeof(gr_complex));
+        fft->execute();
+
+        // Send to output channels
+        for (int b = 0; b < batch; b++) {
+            const gr_complex* chans = fft->get_outbuf() + b * nfilts;
+            for (size_t nn = 0; nn < noutputs; nn++) {
+                gr_complex* out = (gr_complex*)(*d_output_items)[nn];
+                out[r + b] = chans[d_channel_map[nn]];
+            }
+        }
+        r += batch;
+    }
+}
+
 int pfb_channelizer_ccf_impl::general_work(int noutput_items,
                                            gr_vector_int& ninput_items,
                                            gr_vector_const_void_star& input_items,
@@ -130,16 +328,11 @@ int pfb_channelizer_ccf_impl::general_work(int noutput_items,
 {
     gr::thread::scoped_lock guard(d_mutex);
 
-    gr_complex* in = (gr_complex*)input_items[0];
-    gr_complex* out = (gr_complex*)output_items[0];
-
     if (d_updated) {
         d_updated = false;
         return 0; // history requirements may have changed.
     }
 
-    size_t noutputs = output_items.size();
-
     // The following algorithm looks more complex in order to handle
     // the cases where we want more that 1 sps for each
     // channel. Otherwise, this would boil down into a single loop
@@ -152,38 +345,41 @@ int pfb_channelizer_ccf_impl::general_work(int noutput_items,
     // fred harris, Multirate Signal Processing For Communication
     // Systems. Upper Saddle River, NJ: Prentice Hall, 2004.
 
-    int n = 1, i = -1, j = 0, oo = 0, last;
+    // Each output round runs all of the filters, starting with filter
+    // 'last' on input 0 and item n and working down to filter 0, then
+    // from filter d_nfilts - 1 down to last + 1 on item n - 1. Work
+    // out where each round starts so that the rounds can be shared out.
+    d_round_last.clear();
+    d_round_n.clear();
+    int n = 1, last = -1;
     int toconsume = (int)rintf(noutput_items / d_oversample_rate);
     while (n <= toconsume) {
-        j = 0;
-        i = (i + d_rate_ratio) % d_nfilts;
-        last = i;
-        while (i >= 0) {
-            in = (gr_complex*)input_items[j];
-            d_fft->get_inbuf()[d_idxlut[j]] = d_fir_filters[i].filter(&in[n]);
-            j++;
-            i--;
-        }
-
-        i = d_nfilts - 1;
-        while (i > last) {
-            in = (gr_complex*)input_items[j];
-            d_fft->get_inbuf()[d_idxlut[j]] = d_fir_filters[i].filter(&in[n - 1]);
-            j++;
-            i--;
-        }
-
-        n += (i + d_rate_ratio) >= (int)d_nfilts;
+        last = (last + d_rate_ratio) % d_nfilts;
+        d_round_last.push_back(last);
+        d_round_n.push_back(n);
+        n += (last + d_rate_ratio) >= (int)d_nfilts;
+    }
+    d_nrounds = d_round_last.size();
+    d_input_items = &input_items;
+    d_output_items = &output_items;
 
-        // despin through FFT
-        d_fft->execute();
+    if (d_nrounds == 0) {
+        consume_each(toconsume);
+        return noutput_items;
+    }
 
-        // Send to output channels
-        for (unsigned int nn = 0; nn < noutputs; nn++) {
-            out = (gr_complex*)output_items[nn];
-            out[oo] = d_fft->get_outbuf()[d_channel_map[nn]];
-        }
-        oo++;
+    if (d_nthreads > 1 && d_threads.empty())
+        start_workers();
+
+    // The workers wait on us at each barrier; don't leave them there.
+    boost::this_thread::disable_interruption no_interrupt;
+    sync();
+    for (int r0 = 0; r0 < d_nrounds; r0 += d_chunk) {
+        int r1 = std::min(r0 + d_chunk, d_nrounds);
+        filter_chunk(0, r0, r1);
+        sync(); // all of the filters are done before the FFTs
+        fft_chunk(0, r0, r1);
+        sync();
     }
 
     consume_each(toconsume);
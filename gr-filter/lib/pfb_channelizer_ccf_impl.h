@@ -16,6 +16,8 @@
 #include <gnuradio/filter/pfb_channelizer_ccf.h>
 #include <gnuradio/filter/polyphase_filterbank.h>
 #include <gnuradio/thread/thread.h>
+#include <volk/volk_alloc.hh>
+#include <memory>
 
 namespace gr {
 namespace filter {
@@ -32,10 +34,48 @@ private:
     std::vector<int> d_channel_map;
     gr::thread::mutex d_mutex; // mutex to protect set/work access
 
+    // general_work() runs in chunks of d_chunk output rounds. For each,
+    // the threads first share out the filters a group of d_interleaved at
+    // a time, each running its own over the whole chunk into d_fft_in;
+    // then, past a barrier, they share out the rounds, each doing FFTs in
+    // batches and writing the outputs. general_work()'s own thread is
+    // worker 0.
+    struct worker {
+        std::unique_ptr<fft::fft_complex_rev> batch_fft; // d_fft_batch rounds
+        std::unique_ptr<fft::fft_complex_rev> fft;       // one round
+        std::vector<const gr_complex*> filter_in;        // each filter's input
+        volk::vector<gr_complex> filter_out; // filter outputs when oversampling
+        volk::vector<gr_complex> filter_scratch; // for d_interleaved.filterN()
+    };
+
+    int d_nthreads;
+    int d_chunk;
+    int d_fft_batch;
+    std::vector<worker> d_workers;
+    std::vector<gr::thread::thread> d_threads; // workers 1 to d_nthreads - 1
+    gr::thread::barrier_sptr d_barrier;
+    bool d_quit;
+
+    // The general_work() call being shared out
+    std::vector<int> d_round_last; // first filter of each round
+    std::vector<int> d_round_n;    // its input item
+    int d_nrounds;
+    const gr_vector_const_void_star* d_input_items;
+    gr_vector_void_star* d_output_items;
+    volk::vector<gr_complex> d_fft_in; // d_chunk rounds of d_nfilts
+
+    void start_workers();
+    void stop_workers();
+    void sync();
+    void run_worker(int w);
+    void filter_chunk(int w, int r0, int r1);
+    void fft_chunk(int w, int r0, int r1);
+
 public:
     pfb_channelizer_ccf_impl(unsigned int nfilts,
                              const std::vector<float>& taps,
                              float oversample_rate);
+    ~pfb_channelizer_ccf_impl() override;
 
     void set_taps(const std::vector<float>& taps) override;
     void print_taps() override;
@@ -44,6 +84,11 @@ public:
     void set_channel_map(const std::vector<int>& map) override;
     std::vector<int> channel_map() const override;
 
+    void set_nthreads(int n) override;
+    int nthreads() const override;
+
+    bool stop() override;
+
     int general_work(int noutput_items,
                      gr_vector_int& ninput_items,
                      gr_vector_const_void_star& input_items,
@@ -17,6 +17,7 @@
 #include <gnuradio/io_signature.h>
 #include <gnuradio/math.h>
 #include <volk/volk.h>
+#include <cstring>
 
 namespace gr {
 namespace filter {
@@ -46,6 +47,7 @@ pfb_decimator_ccf_impl::pfb_decimator_ccf_impl(unsigned int decim,
       d_use_fft_filters(use_fft_filters)
 {
     d_rate = decim;
+    d_filter_in.resize(d_rate);
     d_rotator.resize(d_rate);
     for (unsigned int i = 0; i < d_rate; i++) {
         d_rotator[i] = gr_expj(i * d_chan * 2 * GR_M_PI / d_rate);
@@ -62,9 +64,7 @@ pfb_decimator_ccf_impl::pfb_decimator_ccf_impl(unsigned int decim,
 
 bool pfb_decimator_ccf_impl::start()
 {
-    if (d_use_fft_filters) {
-        d_tmp.resize(max_noutput_items() * d_rate);
-    }
+    d_tmp.resize(max_noutput_items() * d_rate);
 
     return block::start();
 }
@@ -119,21 +119,33 @@ int pfb_decimator_ccf_impl::work(int noutput_items,
     }
 }
 
+void pfb_decimator_ccf_impl::filter_fir(int noutput_items,
+                                        gr_vector_const_void_star& input_items)
+{
+    // Filter j takes the input streams in reverse; its outputs go to
+    // column j of d_tmp.
+    for (unsigned int j = 0; j < d_rate; j++)
+        d_filter_in[j] = (const gr_complex*)input_items[d_rate - 1 - j];
+    d_interleaved.filterN(
+        d_tmp.data(), d_rate, d_filter_in.data(), noutput_items, d_filter_scratch);
+}
+
 int pfb_decimator_ccf_impl::work_fir_exp(int noutput_items,
                                          gr_vector_const_void_star& input_items,
                                          gr_vector_void_star& output_items)
 {
-    gr_complex* in;
     gr_complex* out = (gr_complex*)output_items[0];
 
     int i;
+
+    // Run all of the filters over their input streams at once, then
+    // rotate and add.
+    filter_fir(noutput_items, input_items);
+
     for (i = 0; i < noutput_items; i++) {
-        // Move through filters from bottom to top
         out[i] = 0;
-        for (int j = d_rate - 1; j >= 0; j--) {
-            // Take items from M-1 to 0; filter and rotate
-            in = (gr_complex*)input_items[d_rate - 1 - j];
-            out[i] += d_fir_filters[j].filter(&in[i]) * d_rotator[j];
+        for (unsigned int j = 0; j < d_rate; j++) {
+            out[i] += d_tmp[i * d_rate + j] * d_rotator[j];
         }
     }
 
@@ -144,18 +156,14 @@ int pfb_decimator_ccf_impl::work_fir_fft(int noutput_items,
                                          gr_vector_const_void_star& input_items,
                                          gr_vector_void_star& output_items)
 {
-    gr_complex* in;
     gr_complex* out = (gr_complex*)output_items[0];
 
     int i;
+
+    filter_fir(noutput_items, input_items);
+
     for (i = 0; i < noutput_items; i++) {
-        // Move through filters from bottom to top
-        out[i] = 0;
-        for (unsigned int j = 0; j < d_rate; j++) {
-            // Take in the items from the first input stream to d_rate
-            in = (gr_complex*)input_items[d_rate - 1 - j];
-            d_fft->get_inbuf()[j] = d_fir_filters[j].filter(&in[i]);
-        }
+        memcpy(d_fft->get_inbuf(), &d_tmp[i * d_rate], d_rate * sizeof(gr_complex));
 
         // Perform the FFT to do the complex multiply despinning for all channels
         d_fft->execute();
@@ -30,9 +30,14 @@ private:
     bool d_use_fft_rotator;
     bool d_use_fft_filters;
     std::vector<gr_complex> d_rotator;
-    volk::vector<gr_complex> d_tmp; // used for fft filters
+    std::vector<const gr_complex*> d_filter_in;
+    volk::vector<gr_complex> d_filter_scratch; // for d_interleaved.filterN()
+    // filter outputs: a row per filter from the FFT filters, a row per
+    // output item from the FIR filters
+    volk::vector<gr_complex> d_tmp;
     gr::thread::mutex d_mutex;      // mutex to protect set/work access
 
+    void filter_fir(int noutput_items, gr_vector_const_void_star& input_items);
     inline int work_fir_exp(int noutput_items,
                             gr_vector_const_void_star& input_items,
                             gr_vector_void_star& output_items);
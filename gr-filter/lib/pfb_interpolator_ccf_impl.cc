@@ -14,6 +14,7 @@
 
 #include "pfb_interpolator_ccf_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 
 namespace gr {
 namespace filter {
@@ -33,7 +34,8 @@ pfb_interpolator_ccf_impl::pfb_interpolator_ccf_impl(unsigned int interp,
                         interp),
       polyphase_filterbank(interp, taps),
       d_updated(false),
-      d_rate(interp)
+      d_rate(interp),
+      d_filter_in(interp)
 {
     set_history(d_taps_per_filter);
 }
@@ -66,17 +68,13 @@ int pfb_interpolator_ccf_impl::work(int noutput_items,
         return 0; // history requirements may have changed.
     }
 
-    int i = 0, count = 0;
+    // Every filter runs over the same input, each giving every d_rate'th
+    // output.
+    std::fill(d_filter_in.begin(), d_filter_in.end(), in);
+    d_interleaved.filterN(
+        out, d_rate, d_filter_in.data(), noutput_items / d_rate, d_filter_scratch);
 
-    while (i < noutput_items) {
-        for (unsigned int j = 0; j < d_rate; j++) {
-            out[i] = d_fir_filters[j].filter(&in[count]);
-            i++;
-        }
-        count++;
-    }
-
-    return i;
+    return noutput_items;
 }
 
 } /* namespace filter */
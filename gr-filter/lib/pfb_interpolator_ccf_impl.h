@@ -27,6 +27,8 @@ class FILTER_API pfb_interpolator_ccf_impl : public pfb_interpolator_ccf,
 private:
     bool d_updated;
     unsigned int d_rate;
+    std::vector<const gr_complex*> d_filter_in;
+    volk::vector<gr_complex> d_filter_scratch; // for d_interleaved.filterN()
     gr::thread::mutex d_mutex; // mutex to protect set/work access
 
 public:
@@ -20,7 +20,7 @@ namespace filter {
 namespace kernel {
 polyphase_filterbank::polyphase_filterbank(unsigned int nfilts,
                                            const std::vector<float>& taps)
-    : d_nfilts(nfilts)
+    : d_nfilts(nfilts), d_interleaved(std::vector<std::vector<float>>())
 {
     d_fir_filters.reserve(d_nfilts);
     d_fft_filters.reserve(d_nfilts);
@@ -67,6 +67,7 @@ void polyphase_filterbank::set_taps(const std::vector<float>& taps)
         d_fir_filters[i].set_taps(d_taps[i]);
         d_fft_filters[i].set_taps(d_taps[i]);
     }
+    d_interleaved.set_taps(d_taps);
 }
 
 void polyphase_filterbank::print_taps()
@@ -0,0 +1,119 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/random.h>
+#include <volk/volk_alloc.hh>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace gr {
+namespace filter {
+
+static gr::random rndm;
+
+// Inputs are this big; outputs are this big times the sum of the taps.
+template <class T>
+static float scale()
+{
+    return 1;
+}
+template <>
+float scale<std::int16_t>()
+{
+    return 1000;
+}
+
+static float uniform() { return 2.0 * (rndm.ran1() - 0.5); }
+
+template <class T>
+static T random_item(float s)
+{
+    return T(s * uniform());
+}
+template <>
+gr_complex random_item<gr_complex>(float s)
+{
+    return gr_complex(s * uniform(), s * uniform());
+}
+
+static double magnitude(float x) { return std::abs(x); }
+static double magnitude(int x) { return std::abs(x); }
+static double magnitude(gr_complex x) { return std::abs(x); }
+
+//
+// filterN() and filterNdec() compute blocks of outputs at a time, and
+// filterNdec() splits the filter into phases; check them against
+// filter() one output at a time, for tap counts and lengths either side
+// of the block sizes.
+//
+template <class IN_T, class OUT_T, class TAP_T>
+static void test_filterNdec(unsigned int decimate)
+{
+    const unsigned int tap_counts[] = { 1, 2, 3, 7, 16, 33, 64, 129 };
+    const unsigned long lengths[] = { 0, 1, 7, 15, 16, 17, 31, 33, 64, 100, 257 };
+    // Keep int16 outputs in range but well clear of rounding.
+    const float in_scale = sizeof(OUT_T) == 2 ? 100 : scale<IN_T>();
+
+    for (unsigned int ntaps : tap_counts) {
+        for (unsigned long n : lengths) {
+            std::vector<TAP_T> taps(ntaps);
+            for (auto& t : taps)
+                t = random_item<TAP_T>(1);
+            volk::vector<IN_T> input(n * decimate + ntaps);
+            for (auto& x : input)
+                x = random_item<IN_T>(in_scale);
+
+            kernel::fir_filter<IN_T, OUT_T, TAP_T> f(taps);
+            volk::vector<OUT_T> output(n + 1);
+            if (decimate == 1)
+                f.filterN(output.data(), input.data(), n);
+            else
+                f.filterNdec(output.data(), input.data(), n, decimate);
+
+            const double tolerance =
+                1e-5 * in_scale * ntaps + (sizeof(OUT_T) == 2 ? 1 : 0);
+            for (unsigned long o = 0; o < n; o++) {
+                OUT_T expected = f.filter(&input[o * decimate]);
+                BOOST_CHECK_MESSAGE(magnitude(expected - output[o]) <= tolerance,
+                                    "ntaps " << ntaps << " n " << n << " decimate "
+                                             << decimate << " output " << o);
+            }
+        }
+    }
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+static void test_filter()
+{
+    for (unsigned int decimate : { 1, 2, 3, 8, 40 })
+        test_filterNdec<IN_T, OUT_T, TAP_T>(decimate);
+}
+
+BOOST_AUTO_TEST_CASE(t1_fff) { test_filter<float, float, float>(); }
+
+BOOST_AUTO_TEST_CASE(t2_ccf) { test_filter<gr_complex, gr_complex, float>(); }
+
+BOOST_AUTO_TEST_CASE(t3_fcc) { test_filter<float, gr_complex, gr_complex>(); }
+
+BOOST_AUTO_TEST_CASE(t4_ccc) { test_filter<gr_complex, gr_complex, gr_complex>(); }
+
+BOOST_AUTO_TEST_CASE(t5_scc) { test_filter<std::int16_t, gr_complex, gr_complex>(); }
+
+BOOST_AUTO_TEST_CASE(t6_fsf) { test_filter<float, std::int16_t, float>(); }
+
+} /* namespace filter */
+} /* namespace gr */
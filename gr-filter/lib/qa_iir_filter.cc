@@ -0,0 +1,367 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/filter/iir_filter.h>
+#include <gnuradio/random.h>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <type_traits>
+
+namespace gr {
+namespace filter {
+
+static gr::random rndm;
+
+static double uniform() { return 2.0 * (rndm.ran1() - 0.5); }
+
+template <class T>
+static T make(std::complex<double> x)
+{
+    return T(x.real());
+}
+template <>
+gr_complex make<gr_complex>(std::complex<double> x)
+{
+    return gr_complex(x);
+}
+template <>
+gr_complexd make<gr_complexd>(std::complex<double> x)
+{
+    return x;
+}
+
+template <class T>
+static bool is_complex()
+{
+    return make<T>(std::complex<double>(0, 1)) != T(0);
+}
+
+template <class T>
+static gr_complexd to_cd(T x)
+{
+    return gr_complexd(x);
+}
+template <>
+gr_complexd to_cd<gr_complex>(gr_complex x)
+{
+    return gr_complexd(x.real(), x.imag());
+}
+
+// How closely a filter with this accumulator follows the exact one,
+// relative to the size of its outputs, which are floats
+template <class ACC_T>
+static double tolerance()
+{
+    return std::is_same<ACC_T, float>::value || std::is_same<ACC_T, gr_complex>::value
+               ? 1e-3
+               : 1e-6;
+}
+
+// Multiply out prod_k (1 - r_k z^-1) as 1, -a_1, -a_2, ...
+static std::vector<std::complex<double>>
+poly(const std::vector<std::complex<double>>& roots)
+{
+    std::vector<std::complex<double>> p(1, 1);
+    for (auto r : roots) {
+        p.push_back(0);
+        for (size_t k = p.size() - 1; k > 0; k--)
+            p[k] -= r * p[k - 1];
+    }
+    return p;
+}
+
+// Taps for a stable filter of the given order, in the new style. Poles
+// come in conjugate pairs, turned by a quarter turn for complex taps so
+// that the filter isn't symmetric in frequency.
+template <class TAP_T>
+static void random_filter(unsigned order,
+                          double radius,
+                          std::vector<TAP_T>& fftaps,
+                          std::vector<TAP_T>& fbtaps)
+{
+    std::vector<std::complex<double>> poles;
+    while (poles.size() < order) {
+        std::complex<double> p = std::polar(radius * (0.5 + 0.5 * rndm.ran1()),
+                                            M_PI * rndm.ran1());
+        poles.push_back(p);
+        if (poles.size() < order)
+            poles.push_back(std::conj(p));
+        else
+            poles.back() = p.real();
+    }
+    const std::complex<double> turn = is_complex<TAP_T>() ? std::polar(1.0, 0.5) : 1.0;
+    std::vector<std::complex<double>> a = poly(poles);
+
+    fftaps.clear();
+    fbtaps.clear();
+    for (unsigned k = 0; k <= order; k++) {
+        fftaps.push_back(make<TAP_T>(uniform()));
+        fbtaps.push_back(make<TAP_T>(a[k] * std::pow(turn, k)));
+    }
+}
+
+template <class IN_T>
+static std::vector<IN_T> random_input(size_t n)
+{
+    std::vector<IN_T> x(n);
+    for (auto& v : x)
+        v = make<IN_T>(std::complex<double>(uniform(), uniform()));
+    return x;
+}
+
+// The filter as it should be, in double precision: new style taps,
+// y[n] = sum_k b_k x[n-k] - sum_{k>0} a_k y[n-k].
+template <class I, class T>
+static std::vector<gr_complexd> reference(const std::vector<T>& fftaps,
+                                          const std::vector<T>& fbtaps,
+                                          const std::vector<I>& x)
+{
+    std::vector<gr_complexd> y(x.size());
+    for (size_t n = 0; n < x.size(); n++) {
+        gr_complexd acc = 0;
+        for (size_t k = 0; k < fftaps.size() && k <= n; k++)
+            acc += to_cd(fftaps[k]) * to_cd(x[n - k]);
+        for (size_t k = 1; k < fbtaps.size() && k <= n; k++)
+            acc -= to_cd(fbtaps[k]) * y[n - k];
+        y[n] = acc;
+    }
+    return y;
+}
+
+template <class O>
+static double max_error(const std::vector<O>& y, const std::vector<gr_complexd>& ref)
+{
+    double err = 0;
+    for (size_t i = 0; i < y.size(); i++)
+        err = std::max(err, std::abs(to_cd(y[i]) - ref[i]));
+    return err;
+}
+
+static double max_abs(const std::vector<gr_complexd>& x)
+{
+    double m = 0;
+    for (auto v : x)
+        m = std::max(m, std::abs(v));
+    return m;
+}
+
+// Run the filter through x in pieces of random length, some with
+// filter_n() and some a sample at a time with filter().
+template <class I, class O, class T, class A>
+static std::vector<O> run_pieces(kernel::iir_filter<I, O, T, A>& f,
+                                 const std::vector<I>& x)
+{
+    std::vector<O> y(x.size());
+    size_t i = 0;
+    while (i < x.size()) {
+        size_t len = std::min(x.size() - i, (size_t)(rndm.ran1() * 2100));
+        if (rndm.ran1() < 0.3) {
+            for (size_t j = i; j < i + len; j++)
+                y[j] = f.filter(x[j]);
+        } else {
+            f.filter_n(&y[i], &x[i], len);
+        }
+        i += len;
+    }
+    return y;
+}
+
+template <class I, class O, class T, class A>
+static std::vector<O> run_single(kernel::iir_filter<I, O, T, A>& f,
+                                 const std::vector<I>& x)
+{
+    std::vector<O> y(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        y[j] = f.filter(x[j]);
+    return y;
+}
+
+// Both runs of the filter follow the reference, and the one through
+// filter_n() no worse than filter() sample by sample does.
+template <class A, class O>
+static void check_accuracy(const std::vector<O>& single,
+                           const std::vector<O>& pieces,
+                           const std::vector<gr_complexd>& ref,
+                           const std::string& what)
+{
+    const double scale = std::max(1.0, max_abs(ref));
+    const double err_single = max_error(single, ref);
+    const double err_pieces = max_error(pieces, ref);
+    BOOST_CHECK_MESSAGE(err_single <= tolerance<A>() * scale,
+                        what << ": filter() error " << err_single
+                             << " for outputs up to " << scale);
+    BOOST_CHECK_MESSAGE(err_pieces <= 2 * err_single + 1e-2 * tolerance<A>() * scale,
+                        what << ": filter_n() error " << err_pieces
+                             << " against filter()'s " << err_single
+                             << " for outputs up to " << scale);
+}
+
+//
+// filter_n() runs the feedback a block at a time; check it against
+// filter() sample by sample, with the two taking turns on one filter,
+// for orders and lengths either side of the block and chunk sizes.
+//
+template <class I, class O, class T, class A>
+static void test_filter_n()
+{
+    const unsigned orders[] = { 0, 1, 2, 3, 7, 8, 9, 12 };
+    const size_t lengths[] = { 0, 1, 7, 8, 9, 17, 1023, 1024, 1025, 5000 };
+
+    for (unsigned order : orders) {
+        // Single precision can't keep a high order direct form anywhere
+        // near the exact filter, filter() or not; that's what sections
+        // are for.
+        if (order > 3 && tolerance<A>() > 1e-6)
+            continue;
+
+        for (size_t n : lengths) {
+            std::vector<T> fftaps, fbtaps;
+            random_filter(order, 0.9, fftaps, fbtaps);
+            kernel::iir_filter<I, O, T, A> single(fftaps, fbtaps, false);
+            kernel::iir_filter<I, O, T, A> pieces(fftaps, fbtaps, false);
+
+            std::vector<I> x = random_input<I>(n);
+            check_accuracy<A>(run_single(single, x),
+                              run_pieces(pieces, x),
+                              reference(fftaps, fbtaps, x),
+                              "order " + std::to_string(order) + " n " +
+                                  std::to_string(n));
+        }
+    }
+}
+
+//
+// A long run of a resonator with its poles close to the unit circle,
+// where errors in the feedback take longest to die away.
+//
+template <class I, class O, class T, class A>
+static void test_resonator()
+{
+    const double r = 0.999, w = 0.05;
+    std::vector<T> fftaps = { T(1 - r) };
+    std::vector<T> fbtaps = { T(1), T(-2 * r * std::cos(w)), T(r * r) };
+    kernel::iir_filter<I, O, T, A> single(fftaps, fbtaps, false);
+    kernel::iir_filter<I, O, T, A> block(fftaps, fbtaps, false);
+
+    std::vector<I> x = random_input<I>(200000);
+    std::vector<O> y(x.size());
+    block.filter_n(y.data(), x.data(), x.size());
+    check_accuracy<A>(
+        run_single(single, x), y, reference(fftaps, fbtaps, x), "resonator");
+}
+
+//
+// A filter built from second-order sections against the same filter
+// multiplied out into one difference equation, and its filter_n()
+// against its filter().
+//
+template <class I, class O, class T, class A>
+static void test_sos()
+{
+    for (unsigned nsections : { 1, 2, 4 }) {
+        std::vector<std::vector<T>> sos;
+        std::vector<std::complex<double>> zeros, poles;
+        for (unsigned s = 0; s < nsections; s++) {
+            std::complex<double> z = std::polar(1.0, M_PI * rndm.ran1());
+            std::complex<double> p =
+                std::polar(0.5 + 0.45 * rndm.ran1(), M_PI * rndm.ran1());
+            const double gain = 0.5 + rndm.ran1();
+            const double a0 = 0.5 + rndm.ran1(); // should be normalized away
+            sos.push_back({ make<T>(a0 * gain),
+                            make<T>(-a0 * gain * 2 * z.real()),
+                            make<T>(a0 * gain * std::norm(z)),
+                            make<T>(a0),
+                            make<T>(-a0 * 2 * p.real()),
+                            make<T>(a0 * std::norm(p)) });
+            zeros.insert(zeros.end(), { z, std::conj(z) });
+            poles.insert(poles.end(), { p, std::conj(p) });
+        }
+
+        kernel::iir_filter<I, O, T, A> sections(sos);
+        kernel::iir_filter<I, O, T, A> pieces(sos);
+        BOOST_CHECK_EQUAL(sections.nsections(), nsections);
+        BOOST_CHECK_EQUAL(sections.ntaps_ff(), 0u);
+
+        // The reference runs the sections one after the other.
+        std::vector<I> x = random_input<I>(5000);
+        std::vector<gr_complexd> ref;
+        for (auto v : x)
+            ref.push_back(to_cd(v));
+        for (const auto& s : sos) {
+            std::vector<gr_complexd> b = { to_cd(s[0]), to_cd(s[1]), to_cd(s[2]) };
+            std::vector<gr_complexd> a = { to_cd(s[3]), to_cd(s[4]), to_cd(s[5]) };
+            for (auto& t : b)
+                t /= to_cd(s[3]);
+            for (auto& t : a)
+                t /= to_cd(s[3]);
+            ref = reference(b, a, ref);
+        }
+        check_accuracy<A>(
+            run_single(sections, x), run_pieces(pieces, x), ref, "sections");
+
+        // Multiplied out, the sections are the direct form filter; but
+        // only with taps precise enough to keep the poles where they
+        // were.
+        if (std::is_same<T, double>::value || std::is_same<T, gr_complexd>::value) {
+            std::vector<std::complex<double>> b = poly(zeros), a = poly(poles);
+            double gain = 1;
+            for (const auto& s : sos)
+                gain *= std::abs(to_cd(s[0]) / to_cd(s[3]));
+            std::vector<T> fftaps, fbtaps;
+            for (size_t k = 0; k < b.size(); k++) {
+                fftaps.push_back(make<T>(gain * b[k]));
+                fbtaps.push_back(make<T>(a[k]));
+            }
+            kernel::iir_filter<I, O, T, A> direct(fftaps, fbtaps, false);
+            kernel::iir_filter<I, O, T, A> direct_pieces(fftaps, fbtaps, false);
+            check_accuracy<A>(
+                run_single(direct, x), run_pieces(direct_pieces, x), ref, "direct");
+        }
+    }
+}
+
+template <class I, class O, class T, class A>
+static void test_all()
+{
+    test_filter_n<I, O, T, A>();
+    test_resonator<I, O, T, A>();
+    test_sos<I, O, T, A>();
+}
+
+BOOST_AUTO_TEST_CASE(t1_ffd) { test_all<float, float, double, double>(); }
+
+BOOST_AUTO_TEST_CASE(t2_ccf) { test_all<gr_complex, gr_complex, float, gr_complex>(); }
+
+BOOST_AUTO_TEST_CASE(t3_ccd) { test_all<gr_complex, gr_complex, double, gr_complexd>(); }
+
+BOOST_AUTO_TEST_CASE(t4_ccc)
+{
+    test_all<gr_complex, gr_complex, gr_complex, gr_complex>();
+}
+
+BOOST_AUTO_TEST_CASE(t5_ccz)
+{
+    test_all<gr_complex, gr_complex, gr_complexd, gr_complexd>();
+}
+
+BOOST_AUTO_TEST_CASE(t6_bad_sections)
+{
+    typedef kernel::iir_filter<float, float, double, double> iir;
+    BOOST_CHECK_THROW(iir(std::vector<std::vector<double>>()), std::invalid_argument);
+    BOOST_CHECK_THROW(iir({ { 1, 0, 0, 1, 0 } }), std::invalid_argument);
+    BOOST_CHECK_THROW(iir({ { 1, 0, 0, 0, 0, 0 } }), std::invalid_argument);
+}
+
+} /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,118 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/interleaved_filterbank.h>
+#include <gnuradio/random.h>
+#include <volk/volk_alloc.hh>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+namespace gr {
+namespace filter {
+
+static gr::random rndm;
+
+static float uniform() { return 2.0 * (rndm.ran1() - 0.5); }
+
+// Shared by every test, so that it is reused at other sizes and with
+// what the last one left in it.
+static volk::vector<gr_complex> scratch;
+
+//
+// Check each arm against a fir_filter_ccf with its taps, for arm counts
+// either side of the group size and block lengths either side of the
+// number of outputs per pass.
+//
+static void test_arms(unsigned int narms,
+                      unsigned int ntaps,
+                      unsigned long n,
+                      unsigned int step,
+                      unsigned int first,
+                      unsigned int last)
+{
+    std::vector<std::vector<float>> taps(narms);
+    std::vector<volk::vector<gr_complex>> inputs(narms);
+    std::vector<const gr_complex*> in(narms);
+    for (unsigned int a = 0; a < narms; a++) {
+        // Some arms are a tap short, as the last arms of a polyphase
+        // filterbank can be.
+        taps[a].resize(ntaps > 1 && a % 3 == 2 ? ntaps - 1 : ntaps);
+        for (auto& t : taps[a])
+            t = uniform();
+        inputs[a].resize(n * step + ntaps);
+        for (auto& x : inputs[a])
+            x = gr_complex(uniform(), uniform());
+        in[a] = inputs[a].data();
+    }
+
+    kernel::interleaved_filterbank_ccf bank(taps);
+    BOOST_REQUIRE_EQUAL(bank.narms(), narms);
+    BOOST_REQUIRE_EQUAL(bank.ntaps(), ntaps);
+
+    const gr_complex unset(1e6, 1e6);
+    const unsigned long stride = narms + 1;
+    std::vector<gr_complex> out(n * stride, unset);
+    bank.filterN(out.data(), stride, in.data(), n, scratch, step, first, last);
+
+    for (unsigned int a = 0; a < narms; a++) {
+        kernel::fir_filter_ccf f(taps[a]);
+        for (unsigned long i = 0; i < n; i++) {
+            gr_complex expected = unset;
+            if (a >= first && a < last)
+                expected = f.filter(&in[a][i * step]);
+            BOOST_CHECK_MESSAGE(std::abs(expected - out[i * stride + a]) <= 1e-5 * ntaps,
+                                "narms " << narms << " ntaps " << ntaps << " n " << n
+                                         << " step " << step << " arm " << a
+                                         << " output " << i);
+        }
+        // Nothing written between rows
+        for (unsigned long i = 0; i < n; i++)
+            BOOST_CHECK(out[i * stride + narms] == unset);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(t1_all_arms)
+{
+    const unsigned int g = kernel::interleaved_filterbank_ccf::group_size();
+    for (unsigned int narms : { 1u, 3u, g - 1, g, g + 1, 2 * g, 3 * g + 2 }) {
+        for (unsigned int ntaps : { 1, 2, 7, 24 }) {
+            for (unsigned long n : { 0, 1, 3, 4, 5, 17, 1000 })
+                test_arms(narms, ntaps, n, 1, 0, narms);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(t2_step)
+{
+    for (unsigned int step : { 2, 3, 7 }) {
+        for (unsigned int ntaps : { 1, 5, 24 })
+            test_arms(12, ntaps, 700, step, 0, 12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(t3_some_arms)
+{
+    const unsigned int g = kernel::interleaved_filterbank_ccf::group_size();
+    const unsigned int narms = 3 * g + 1;
+    for (unsigned int first : { 0u, 1u, g, g + 1 }) {
+        for (unsigned int last : { first + 1, 2 * g, 2 * g + 3, narms }) {
+            if (last > first)
+                test_arms(narms, 9, 37, 1, first, last);
+        }
+    }
+}
+
+} /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, filter, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_filter_kernel_interleaved_filterbank_ccf = R"doc()doc";
+
+
+static const char*
+    __doc_gr_filter_kernel_interleaved_filterbank_ccf_interleaved_filterbank_ccf =
+        R"doc()doc";
+
+
+static const char* __doc_gr_filter_kernel_interleaved_filterbank_ccf_set_taps =
+    R"doc()doc";
+
+
+static const char* __doc_gr_filter_kernel_interleaved_filterbank_ccf_narms = R"doc()doc";
+
+
+static const char* __doc_gr_filter_kernel_interleaved_filterbank_ccf_ntaps = R"doc()doc";
+
+
+static const char* __doc_gr_filter_kernel_interleaved_filterbank_ccf_group_size =
+    R"doc()doc";
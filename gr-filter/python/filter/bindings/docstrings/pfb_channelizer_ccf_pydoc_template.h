@@ -42,3 +42,9 @@ static const char* __doc_gr_filter_pfb_channelizer_ccf_set_channel_map = R"doc()
 
 
 static const char* __doc_gr_filter_pfb_channelizer_ccf_channel_map = R"doc()doc";
+
+
+static const char* __doc_gr_filter_pfb_channelizer_ccf_set_nthreads = R"doc()doc";
+
+
+static const char* __doc_gr_filter_pfb_channelizer_ccf_nthreads = R"doc()doc";
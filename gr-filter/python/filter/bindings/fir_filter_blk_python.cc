@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(fir_filter_blk.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(54817d497b71f9839e0f4e8ae10dafcc)                     */
+/* BINDTOOL_HEADER_FILE_HASH(4b3fb4ce3e78333b92b29fb98dee7062)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -41,11 +41,22 @@ void bind_fir_filter_blk_template(py::module& m, const char* classname)
              py::arg("taps"))
 
         .def("set_taps", &fir_filter_blk::set_taps, py::arg("taps"))
-        .def("taps", &fir_filter_blk::taps);
+        .def("taps", &fir_filter_blk::taps)
+        .def("set_engine", &fir_filter_blk::set_engine, py::arg("engine"))
+        .def("engine", &fir_filter_blk::engine)
+        .def("active_engine", &fir_filter_blk::active_engine);
 }
 
 void bind_fir_filter_blk(py::module& m)
 {
+    py::enum_<::gr::filter::fir_filter_engine_t>(m, "fir_filter_engine_t")
+        .value("FIR_ENGINE_DIRECT", ::gr::filter::FIR_ENGINE_DIRECT) // 0
+        .value("FIR_ENGINE_FFT", ::gr::filter::FIR_ENGINE_FFT)       // 1
+        .value("FIR_ENGINE_AUTO", ::gr::filter::FIR_ENGINE_AUTO)     // 2
+        .export_values();
+
+    py::implicitly_convertible<int, ::gr::filter::fir_filter_engine_t>();
+
     bind_fir_filter_blk_template<gr_complex, gr_complex, gr_complex>(m, "fir_filter_ccc");
     bind_fir_filter_blk_template<gr_complex, gr_complex, float>(m, "fir_filter_ccf");
     bind_fir_filter_blk_template<float, gr_complex, gr_complex>(m, "fir_filter_fcc");
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(fir_filter.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(7fb532b04bc5b511d2f03a23101369c9)                     */
+/* BINDTOOL_HEADER_FILE_HASH(d4ae3c7eaf8347b6e03adf6b8fa55347)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(iir_filter.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(13dec42f09e2dd232a8c7872db83c6a8)                     */
+/* BINDTOOL_HEADER_FILE_HASH(8f5baeefc46132edea713dffd3629b4a)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
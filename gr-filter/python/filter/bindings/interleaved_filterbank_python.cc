@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(interleaved_filterbank.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(0427d78c42b428081f381f30db3554b9)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/filter/interleaved_filterbank.h>
+// pydoc.h is automatically generated in the build directory
+#include <interleaved_filterbank_pydoc.h>
+
+void bind_interleaved_filterbank(py::module& m)
+{
+
+
+    py::module m_kernel = m.def_submodule("kernel");
+
+    using interleaved_filterbank_ccf = ::gr::filter::kernel::interleaved_filterbank_ccf;
+
+
+    py::class_<interleaved_filterbank_ccf, std::shared_ptr<interleaved_filterbank_ccf>>(
+        m_kernel, "interleaved_filterbank_ccf", D(kernel, interleaved_filterbank_ccf))
+
+        .def(py::init<std::vector<std::vector<float>> const&>(),
+             py::arg("taps"),
+             D(kernel, interleaved_filterbank_ccf, interleaved_filterbank_ccf))
+
+
+        .def("set_taps",
+             &interleaved_filterbank_ccf::set_taps,
+             py::arg("taps"),
+             D(kernel, interleaved_filterbank_ccf, set_taps))
+
+
+        .def("narms",
+             &interleaved_filterbank_ccf::narms,
+             D(kernel, interleaved_filterbank_ccf, narms))
+
+
+        .def("ntaps",
+             &interleaved_filterbank_ccf::ntaps,
+             D(kernel, interleaved_filterbank_ccf, ntaps))
+
+
+        .def_static("group_size",
+                    &interleaved_filterbank_ccf::group_size,
+                    D(kernel, interleaved_filterbank_ccf, group_size))
+
+        ;
+}
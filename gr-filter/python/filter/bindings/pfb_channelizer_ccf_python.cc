@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(pfb_channelizer_ccf.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(e5e101f91f9b1d578affd27a80a639b7)                     */
+/* BINDTOOL_HEADER_FILE_HASH(38749703a97a39bd1bb690dd124f4d2d)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -70,5 +70,14 @@ void bind_pfb_channelizer_ccf(py::module& m)
              &pfb_channelizer_ccf::channel_map,
              D(pfb_channelizer_ccf, channel_map))
 
+
+        .def("set_nthreads",
+             &pfb_channelizer_ccf::set_nthreads,
+             py::arg("n"),
+             D(pfb_channelizer_ccf, set_nthreads))
+
+
+        .def("nthreads", &pfb_channelizer_ccf::nthreads, D(pfb_channelizer_ccf, nthreads))
+
         ;
 }
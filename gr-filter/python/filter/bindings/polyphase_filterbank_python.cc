@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(polyphase_filterbank.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(29e70e9f09508967c171c029d5f7529c)                     */
+/* BINDTOOL_HEADER_FILE_HASH(52007458203347ea38f4c8032970daf8)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
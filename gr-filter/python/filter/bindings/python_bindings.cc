@@ -37,6 +37,7 @@ void bind_iir_filter_ccf(py::module&);
 void bind_iir_filter_ccz(py::module&);
 void bind_iir_filter_ffd(py::module&);
 // void bind_interp_differentiator_taps(py::module&);
+void bind_interleaved_filterbank(py::module&);
 void bind_interp_fir_filter(py::module&);
 // void bind_interpolator_taps(py::module&);
 void bind_ival_decimator(py::module&);
@@ -104,6 +105,7 @@ PYBIND11_MODULE(filter_python, m)
     bind_iir_filter_ccz(m);
     bind_iir_filter_ffd(m);
     // bind_interp_differentiator_taps(m);
+    bind_interleaved_filterbank(m);
     bind_interp_fir_filter(m);
     // bind_interpolator_taps(m);
     bind_ival_decimator(m);
@@ -55,6 +55,12 @@ class channelizer_ccf(gr.hier_block2):
     def taps(self):
         return self.pfb.taps()
 
+    def set_nthreads(self, n):
+        self.pfb.set_nthreads(n)
+
+    def nthreads(self):
+        return self.pfb.nthreads()
+
     def declare_sample_delay(self, delay):
         self.pfb.declare_sample_delay(delay)
     
@@ -8,6 +8,9 @@
 #
 #
 
+import os
+import shutil
+import tempfile
 
 from gnuradio import gr, gr_unittest, filter, blocks
 
@@ -25,6 +28,18 @@ def fir_filter(x, taps, decim=1):
 
 class test_filter(gr_unittest.TestCase):
 
+    @classmethod
+    def setUpClass(cls):
+        # Keep what FIR_ENGINE_AUTO learns out of the user's own wisdom.
+        cls.wisdom_dir = tempfile.mkdtemp()
+        os.environ['GR_CONF_FILTER_FIR_ENGINE_WISDOM'] = os.path.join(
+            cls.wisdom_dir, 'fir_engine_wisdom')
+
+    @classmethod
+    def tearDownClass(cls):
+        del os.environ['GR_CONF_FILTER_FIR_ENGINE_WISDOM']
+        shutil.rmtree(cls.wisdom_dir)
+
     def setUp(self):
         self.tb = gr.top_block()
 
@@ -187,6 +202,62 @@ class test_filter(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_data, result_data, 5)
 
+    def test_fir_filter_engines(self):
+        taps = [0.01 * ((7 * i) % 23 - 11) for i in range(100)]
+        src_data = [float((5 * i) % 17 - 8) for i in range(4000)]
+        for decim in (1, 3):
+            expected_data = fir_filter(src_data, taps, decim)
+            for engine in (filter.FIR_ENGINE_FFT, filter.FIR_ENGINE_AUTO):
+                tb = gr.top_block()
+                src = blocks.vector_source_f(src_data)
+                op = filter.fir_filter_fff(decim, taps)
+                op.set_engine(engine)
+                dst = blocks.vector_sink_f()
+                tb.connect(src, op, dst)
+                tb.run()
+                result_data = dst.data()
+                # The FFT engine drops the last partial block.
+                self.assertGreater(len(result_data), len(expected_data) // 2)
+                self.assertFloatTuplesAlmostEqual(
+                    expected_data[:len(result_data)], result_data, 3)
+                self.assertEqual(engine, op.engine())
+
+            # Only the fff, ccf and ccc filters can use the FFT engine.
+            op = filter.fir_filter_fsf(decim, taps)
+            op.set_engine(filter.FIR_ENGINE_FFT)
+            self.assertEqual(filter.FIR_ENGINE_DIRECT, op.active_engine())
+
+        self.assertTrue(os.path.exists(os.environ[
+            'GR_CONF_FILTER_FIR_ENGINE_WISDOM']))
+
+    def test_fir_filter_engine_long(self):
+        # An FFT block of this many taps is longer than the default
+        # buffers, so they have to be sized for it before the start.
+        ntaps = 5000
+        taps = [0.0] * ntaps
+        taps[0] = 0.5
+        taps[1234] = -0.25
+        taps[ntaps - 1] = 1.0
+        nonzero = [(j, t) for j, t in enumerate(taps) if t]
+        src_data = [float((5 * i) % 17 - 8) for i in range(40000)]
+        for decim in (1, 3):
+            expected_data = [
+                sum(t * src_data[i - j] for j, t in nonzero if i >= j)
+                for i in range(0, len(src_data), decim)]
+
+            src = blocks.vector_source_f(src_data)
+            op = filter.fir_filter_fff(decim, taps)
+            op.set_engine(filter.FIR_ENGINE_FFT)
+            dst = blocks.vector_sink_f()
+            self.tb = gr.top_block()
+            self.tb.connect(src, op, dst)
+            self.tb.run()
+            result_data = dst.data()
+            self.assertEqual(filter.FIR_ENGINE_FFT, op.active_engine())
+            self.assertGreater(len(result_data), 0)
+            self.assertFloatTuplesAlmostEqual(
+                expected_data[:len(result_data)], result_data, 3)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_filter)
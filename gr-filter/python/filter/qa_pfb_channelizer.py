@@ -12,6 +12,7 @@
 from gnuradio import gr, gr_unittest, fft, filter, blocks, analog
 import math
 import cmath
+import random
 
 
 def sig_source_c(samp_rate, freq, amp, N):
@@ -66,6 +67,44 @@ class test_pfb_channelizer(gr_unittest.TestCase):
                           filter.pfb.channelizer_ccf,
                           36, taps=self.taps, oversample_rate=10.1334)
 
+    def test_0004(self):
+        """Test spreading the filterbank over several threads."""
+        channelizer = filter.pfb.channelizer_ccf(
+            self.M, taps=self.taps, oversample_rate=1)
+        channelizer.set_nthreads(3)
+        self.assertEqual(3, channelizer.nthreads())
+        self.check_channelizer(channelizer)
+
+    def test_0005(self):
+        """Test that threads don't change the output."""
+        random.seed(0)
+        for nchans in (4, 8, 16):
+            taps = filter.firdes.low_pass_2(
+                1, nchans, 0.5, 0.1, attenuation_dB=80,
+                window=fft.window.WIN_BLACKMAN_hARRIS)
+            data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                    for _ in range(200 * nchans)]
+            for osr in (1, 2, 4. / 3):
+                expected = self.run_threads(nchans, taps, osr, 1, data)
+                for nthreads in range(2, 6):
+                    received = self.run_threads(
+                        nchans, taps, osr, nthreads, data)
+                    for exp, rec in zip(expected, received):
+                        self.assertEqual(len(exp), len(rec))
+                        self.assertComplexTuplesAlmostEqual(exp, rec, 5)
+
+    def run_threads(self, nchans, taps, osr, nthreads, data):
+        tb = gr.top_block()
+        src = blocks.vector_source_c(data)
+        channelizer = filter.pfb_channelizer_ccf(nchans, taps, osr)
+        channelizer.set_nthreads(nthreads)
+        tb.connect(src, channelizer)
+        snks = [blocks.vector_sink_c() for _ in range(nchans)]
+        for i in range(nchans):
+            tb.connect((channelizer, i), snks[i])
+        tb.run()
+        return [snk.data() for snk in snks]
+
     def get_input_data(self):
         """
         Get the raw data generated by addition of sinusoids.
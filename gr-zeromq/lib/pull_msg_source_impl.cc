@@ -98,10 +98,9 @@ void pull_msg_source_impl::readloop()
                 continue;
             }
 
-            std::string buf(static_cast<char*>(msg.data()), msg.size());
-            std::stringbuf sb(buf);
             try {
-                pmt::pmt_t m = pmt::deserialize(sb);
+                size_t used;
+                pmt::pmt_t m = pmt::deserialize_buffer(msg.data(), msg.size(), used);
                 message_port_pub(d_port, m);
             } catch (pmt::exception& e) {
                 GR_LOG_ERROR(d_logger, std::string("Invalid PMT message: ") + e.what());
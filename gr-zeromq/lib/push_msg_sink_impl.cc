@@ -56,12 +56,11 @@ push_msg_sink_impl::~push_msg_sink_impl() {}
 
 void push_msg_sink_impl::handler(pmt::pmt_t msg)
 {
-    std::stringbuf sb("");
-    pmt::serialize(msg, sb);
-    std::string s = sb.str();
+    std::string s;
+    pmt::serialize_append(msg, s);
     zmq::message_t zmsg(s.size());
 
-    memcpy(zmsg.data(), s.c_str(), s.size());
+    memcpy(zmsg.data(), s.data(), s.size());
 #if USE_NEW_CPPZMQ_SEND_RECV
     d_socket.send(zmsg, zmq::send_flags::none);
 #else